@@ -7,11 +7,13 @@
 #include"core/type.hpp"   //based on base.hpp
 #include"core/datastruct.hpp"  //based on base.hpp && type.hpp
 #include"core/math.hpp"   //based on base.hpp && type.hpp
-#include"core/path.hpp"   //based on base.hpp && type.hpp
 #include"core/str.hpp"   //based on base.hpp && type.hpp
+#include"core/path.hpp"   //based on base.hpp, type.hpp && str.hpp
 #include"core/thread.hpp"   //based on base.hpp && type.hpp
 #include"core/file.hpp"   //based on base.hpp && str.hpp 
 #include"core/io.hpp"   //based on base.hpp, type.hpp && str.hpp
+#include"core/config.hpp"   //based on base.hpp, file.hpp, io.hpp && str.hpp
+#include"core/bench.hpp"   //based on base.hpp && time.hpp
 
 #endif
 
@@ -5,6 +5,9 @@
 
 #include<atomic>
 #include<chrono>
+#include<memory>
+#include<mutex>
+#include<stdarg.h>
 #include<stdio.h>
 #include<stdint.h>
 #include<string>
@@ -13,15 +16,20 @@
 #include<time.h>
 #include<typeinfo>
 #include<type_traits>
+#include<utility>
 #include<unordered_map>
+#include<vector>
 #ifdef __GNUC__ 
 #include<cxxabi.h>
 #endif
+#if defined(_MSC_VER)
+#include<intrin.h>
+#endif
 
 #define MINEUTILS_MAJOR_VERSION "2"   //主版本号，对应不向下兼容的API或文件改动
-#define MINEUTILS_MINOR_VERSION "5"   //次版本号，对应不影响现有API使用的新功能增加
+#define MINEUTILS_MINOR_VERSION "6"   //次版本号，对应不影响现有API使用的新功能增加
 #define MINEUTILS_PATCH_VERSION "0"   //修订版本号，对应不改变API的BUG修复或效能优化
-#define MINEUTILS_DATE_VERSION "20250610-release"   //日期版本号，对应文档和注释级别的改动和测试阶段
+#define MINEUTILS_DATE_VERSION "20261019-release"   //日期版本号，对应文档和注释级别的改动和测试阶段
 
 #ifdef __GNUC__ 
 #define MINE_FUNCSIG __PRETTY_FUNCTION__
@@ -41,12 +49,82 @@
  //命名空间::类名::函数名格式的const char*字符串
 #define MINE_FUNCNAME mineutils::mbase::_splitFuncName(MINE_FUNCSIG, __func__)
 
+//C++14及以上且编译器支持在常量表达式中读取函数签名时，日志宏在编译期截取函数名，否则在运行时通过_splitFuncName截取
+#if ((defined(__cplusplus) && __cplusplus >= 201402L) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 8)))
+#define _MINE_CONSTEXPR_FUNCNAME
+#define _mdeclareFuncName(var) \
+    static constexpr auto var##_str = mineutils::mbase::_makeFuncName<mineutils::mbase::_funcNameRange(MINE_FUNCSIG, __func__).size()>(MINE_FUNCSIG, __func__); \
+    const char* var = var##_str.data
+//日志宏使用的函数名表达式，借助GCC/Clang的语句表达式使mprintf系列宏仍可用于表达式中
+#define _MINE_LOG_FUNCNAME __extension__ ({ _mdeclareFuncName(_mine_funcname); _mine_funcname; })
+#else
+#define _mdeclareFuncName(var) const char* var = MINE_FUNCNAME
+#define _MINE_LOG_FUNCNAME MINE_FUNCNAME
+#endif
+
+//编译期日志级别，低于该级别的mprintf系列宏展开为空语句：0输出全部，1输出警告和错误，2仅输出错误，3全部关闭
+#ifndef MINEUTILS_LOG_LEVEL
+#define MINEUTILS_LOG_LEVEL 0
+#endif
+
+/*  分离编译模式：所有编译单元都定义MINEUTILS_SEPARATE_COMPILATION时，头文件只保留非模板函数的声明，
+    其定义及常用类型的模板实例统一由mineutilshpp/mineutils.cpp编译一次，减少编译时间和重复代码  */
+#if defined(MINEUTILS_SEPARATE_COMPILATION) && !defined(_MINEUTILS_IMPLEMENTATION_UNIT)
+#define _MINE_DECLARATION_ONLY
+#endif
+#if defined(MINEUTILS_SEPARATE_COMPILATION)
+#define _MINE_INLINE
+#else
+#define _MINE_INLINE inline
+#endif
+
+#if MINEUTILS_LOG_LEVEL <= 0
 //按printf的格式调用，打印带函数名的普通提示信息
-#define mprintfI(fmt_chars, ...) mineutils::mbase::_printfI(fmt_chars, MINE_FUNCNAME, ##__VA_ARGS__)
+#define mprintfI(fmt_chars, ...) mineutils::mbase::_printfI(fmt_chars, _MINE_LOG_FUNCNAME, ##__VA_ARGS__)
+#else
+#define mprintfI(fmt_chars, ...) ((void)0)
+#endif
+#if MINEUTILS_LOG_LEVEL <= 1
 //按printf的格式调用，打印带函数名和位置的警告信息
-#define mprintfW(fmt_chars, ...) mineutils::mbase::_printfW(fmt_chars, MINE_FUNCNAME, __FILE__, __LINE__, ##__VA_ARGS__)
+#define mprintfW(fmt_chars, ...) mineutils::mbase::_printfW(fmt_chars, _MINE_LOG_FUNCNAME, __FILE__, __LINE__, ##__VA_ARGS__)
+#else
+#define mprintfW(fmt_chars, ...) ((void)0)
+#endif
+#if MINEUTILS_LOG_LEVEL <= 2
 //按printf的格式调用，打印带函数名和位置的错误信息
-#define mprintfE(fmt_chars, ...) mineutils::mbase::_printfE(fmt_chars, MINE_FUNCNAME, __FILE__, __LINE__, ##__VA_ARGS__)
+#define mprintfE(fmt_chars, ...) mineutils::mbase::_printfE(fmt_chars, _MINE_LOG_FUNCNAME, __FILE__, __LINE__, ##__VA_ARGS__)
+#else
+#define mprintfE(fmt_chars, ...) ((void)0)
+#endif
+
+#if MINEUTILS_LOG_LEVEL <= 1
+/*  按调用位置限流的mprintfW，同一调用位置按令牌桶限制输出频率，被抑制的条数在下一次输出时汇总打印
+    - 频率和突发条数由mbase::setLogRateLimit设置，默认每秒1条，突发5条
+    - 只能作为语句使用，不能用于表达式中   */
+#define mprintfWLimited(fmt_chars, ...) do { \
+    static mineutils::mbase::_LogRateLimiter _mine_log_limiter; \
+    unsigned long long _mine_suppressed_count = 0; \
+    if (_mine_log_limiter.allow(_mine_suppressed_count)) { \
+        _mdeclareFuncName(_mine_funcname); \
+        mineutils::mbase::_printfW(fmt_chars, _mine_funcname, __FILE__, __LINE__, ##__VA_ARGS__); \
+        if (_mine_suppressed_count > 0) mineutils::mbase::_printfW("Suppressed %llu similar messages at this call site before the message above.\n", _mine_funcname, __FILE__, __LINE__, _mine_suppressed_count); \
+    } } while (0)
+#else
+#define mprintfWLimited(fmt_chars, ...) ((void)0)
+#endif
+#if MINEUTILS_LOG_LEVEL <= 2
+//按调用位置限流的mprintfE，规则同mprintfWLimited
+#define mprintfELimited(fmt_chars, ...) do { \
+    static mineutils::mbase::_LogRateLimiter _mine_log_limiter; \
+    unsigned long long _mine_suppressed_count = 0; \
+    if (_mine_log_limiter.allow(_mine_suppressed_count)) { \
+        _mdeclareFuncName(_mine_funcname); \
+        mineutils::mbase::_printfE(fmt_chars, _mine_funcname, __FILE__, __LINE__, ##__VA_ARGS__); \
+        if (_mine_suppressed_count > 0) mineutils::mbase::_printfE("Suppressed %llu similar messages at this call site before the message above.\n", _mine_funcname, __FILE__, __LINE__, _mine_suppressed_count); \
+    } } while (0)
+#else
+#define mprintfELimited(fmt_chars, ...) ((void)0)
+#endif
 
 
 namespace mineutils
@@ -60,6 +138,43 @@ namespace mineutils
 
         //打印mineutils库的版本
         void printVersion(const char* project_name);
+
+        //mprintf系列宏的日志级别
+        enum LogLevel
+        {
+            info = 0,
+            warning = 1,
+            error = 2,
+            off = 3
+        };
+
+        //设置运行时日志级别，低于该级别的日志不输出，默认为info；编译期级别由宏MINEUTILS_LOG_LEVEL控制
+        void setLogLevel(LogLevel level);
+
+        //获取运行时日志级别
+        LogLevel getLogLevel();
+
+        /*  开启异步日志，开启后mprintf系列宏只将格式串指针和参数的二进制拷贝写入当前线程的无锁环形缓冲区，由后台线程格式化并批量输出
+            - 各线程的日志分别保证顺序，不同线程之间的日志不保证按时间排序
+            - 缓冲区已满时丢弃新日志并计数，后台线程会定期输出丢弃的条数
+            - 单条日志的参数超出记录容量时，在调用线程中格式化并截断后写入
+            - 参数只支持printf可接受的标量类型；对应不带精度的%s的char*参数按以'\0'结尾的字符串拷贝，
+              char*参数对应%p、%.*s等其他转换时不读取其内容，该条日志在调用线程中格式化后写入，超出记录容量时同样截断
+            - 在不支持thread_local的编译器(如QNX660的GCC4.7.3)上不可用，日志保持同步输出
+            @param ring_capacity: 每个线程的环形缓冲区可容纳的日志条数，会向上取整为2的幂，每条占用512字节
+            @return 0代表正常，其他代表失败   */
+        int startAsyncLog(size_t ring_capacity = 512);
+
+        //停止异步日志，输出缓冲区中剩余的全部日志后恢复同步输出；进程正常退出时会自动调用
+        void stopAsyncLog();
+
+        //获取开启异步日志以来，因缓冲区已满而丢弃的日志条数
+        unsigned long long getDroppedLogCount();
+
+        /*  设置mprintfWLimited和mprintfELimited的限流参数，对所有调用位置生效，每个调用位置独立计算
+            @param messages_per_second: 每个调用位置每秒允许输出的平均条数，不大于0时不限流
+            @param burst: 每个调用位置允许连续输出的最大条数，小于1的值会被置为1   */
+        void setLogRateLimit(double messages_per_second, int burst);
     }
 
 
@@ -89,7 +204,14 @@ namespace mineutils
 #else 
 #define _MINE_THREAD_LOCAL_IF_HAVE thread_local   
 #define _MINE_REF_WHEN_THREAD_LOCAL &
-#endif 
+#endif
+
+//C++14及以上时为constexpr，用于带循环和局部变量的函数，C++11下退化为普通inline函数
+#if (defined(__cplusplus) && __cplusplus >= 201402L) || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define _MINE_CONSTEXPR14 constexpr
+#else
+#define _MINE_CONSTEXPR14
+#endif
 
 #ifdef __GNUC__ 
 #define _mdeprecated(msg) __attribute__((deprecated(msg)))
@@ -185,7 +307,8 @@ namespace mineutils
         //}
 
 
-        inline const char* _splitFuncName(const char* func_sig, const char* func_name)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE const char* _splitFuncName(const char* func_sig, const char* func_name)
         {
             _MINE_THREAD_LOCAL_IF_HAVE std::unordered_map<const char*, std::string> func_name_map;
             const char* tmp = func_name;
@@ -213,56 +336,857 @@ namespace mineutils
             func_name_map[func_sig] = std::move(s_func_sig);
             return func_name_map[func_sig].c_str();
         }
+#else
+        const char* _splitFuncName(const char* func_sig, const char* func_name);
+#endif
+
+        //按秒缓存的当地时间，同一线程在同一秒内只调用一次localtime并格式化一次字符串
+        struct _LocalTimeCache
+        {
+            bool inited = false;
+            bool valid = false;
+            time_t sec = 0;
+            tm buf;
+            char str[32];    //"2025-01-07 17:18:35 STD"格式
+            size_t zone_pos = 0;    //" STD"部分的起始位置
+        };
 
-        inline const std::string& _getFmtI()
+#ifndef _MINE_DECLARATION_ONLY
+        //获取t对应的按秒缓存的当地时间，在不支持thread_local的编译器上不缓存，按值返回
+        _MINE_INLINE const _LocalTimeCache _MINE_REF_WHEN_THREAD_LOCAL _getLocalTimeCache(time_t t)
         {
-            static std::string info_message(R"([INFO][%s] )");
-            return info_message;
+            _MINE_THREAD_LOCAL_IF_HAVE _LocalTimeCache cache;
+            if (cache.inited && cache.sec == t)
+                return cache;
+
+            cache.inited = true;
+            cache.sec = t;
+#if defined(_MSC_VER)
+            cache.valid = localtime_s(&cache.buf, &t) == 0;
+#else
+            cache.valid = localtime_r(&t, &cache.buf) != nullptr;
+#endif
+            if (cache.valid)
+            {
+                //取模仅用于约束格式化长度，合法的tm各字段均不会被截断
+                snprintf(cache.str, sizeof(cache.str), "%04u-%02u-%02u %02u:%02u:%02u %s", unsigned(cache.buf.tm_year + 1900) % 10000u, unsigned(cache.buf.tm_mon + 1) % 100u,
+                    unsigned(cache.buf.tm_mday) % 100u, unsigned(cache.buf.tm_hour) % 100u, unsigned(cache.buf.tm_min) % 100u, unsigned(cache.buf.tm_sec) % 100u,
+                    cache.buf.tm_isdst ? "DST" : "STD");
+            }
+            else snprintf(cache.str, sizeof(cache.str), "0000-00-00 00:00:00 Invalid");
+            cache.zone_pos = 19;
+            return cache;
+        }
+#else
+        const _LocalTimeCache _MINE_REF_WHEN_THREAD_LOCAL _getLocalTimeCache(time_t t);
+#endif
+
+#ifndef _MINE_DECLARATION_ONLY
+        /*  将系统时间点格式化为当地时间字符串，写入长度不小于32的out，返回写入的长度
+            - 格式："2025-01-07 17:18:35.123 STD"，with_date为false时省略日期，with_ms为false时省略毫秒  */
+        _MINE_INLINE size_t _formatLocalTime(std::chrono::system_clock::time_point tp, bool with_date, bool with_ms, char* out)
+        {
+            auto since_epoch_ms = std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+            long long ms = since_epoch_ms % 1000;
+            if (ms < 0)
+                ms += 1000;
+            time_t t = std::chrono::system_clock::to_time_t(tp - std::chrono::milliseconds(ms));
+            const _LocalTimeCache _MINE_REF_WHEN_THREAD_LOCAL cache = mbase::_getLocalTimeCache(t);
+
+            const char* src = with_date ? cache.str : cache.str + 11;
+            size_t len = cache.str + cache.zone_pos - src;
+            memcpy(out, src, len);
+            if (with_ms)
+            {
+                out[len] = '.';
+                out[len + 1] = char('0' + ms / 100);
+                out[len + 2] = char('0' + ms / 10 % 10);
+                out[len + 3] = char('0' + ms % 10);
+                len += 4;
+            }
+            size_t zone_len = strlen(cache.str + cache.zone_pos);
+            memcpy(out + len, cache.str + cache.zone_pos, zone_len + 1);
+            return len + zone_len;
+        }
+#else
+        size_t _formatLocalTime(std::chrono::system_clock::time_point tp, bool with_date, bool with_ms, char* out);
+#endif
+
+#ifdef _MINE_CONSTEXPR_FUNCNAME
+        constexpr size_t _constexprStrlen(const char* s)
+        {
+            size_t len = 0;
+            while (s[len] != '\0')
+                len++;
+            return len;
+        }
+
+        //在s中查找name后紧跟next的位置，未找到时返回-1
+        constexpr size_t _constexprFindName(const char* s, const char* name, char next)
+        {
+            size_t s_len = mbase::_constexprStrlen(s);
+            size_t name_len = mbase::_constexprStrlen(name);
+            for (size_t pos = 0; pos + name_len < s_len; pos++)
+            {
+                size_t i = 0;
+                while (i < name_len && s[pos + i] == name[i])
+                    i++;
+                if (i == name_len && s[pos + name_len] == next)
+                    return pos;
+            }
+            return size_t(-1);
         }
-        inline const std::string& _getFmtW()
+
+        //函数名在签名中的位置，与_splitFuncName的规则一致
+        struct _FuncNameRange
+        {
+            size_t start;
+            size_t len;
+            bool use_name;    //签名与函数名相同，直接使用函数名
+            bool append_name;    //未在签名中找到函数名(如gcc上的lambda)，在完整签名后追加"::函数名"
+
+            constexpr size_t size() const
+            {
+                return this->len;
+            }
+        };
+
+        constexpr _FuncNameRange _funcNameRange(const char* func_sig, const char* func_name)
         {
-            static std::string warning_message(R"([%02d:%02d:%02d %s][WARNING][%s][%s: line %d] )");
-            return warning_message;
+            size_t sig_len = mbase::_constexprStrlen(func_sig);
+            size_t name_len = mbase::_constexprStrlen(func_name);
+            size_t i = 0;
+            while (i <= sig_len && func_sig[i] == func_name[i])
+                i++;
+            if (i > sig_len)
+                return _FuncNameRange{ 0, name_len, true, false };
+
+            size_t name_pos = mbase::_constexprFindName(func_sig, func_name, '(');
+            if (name_pos == size_t(-1))
+                name_pos = mbase::_constexprFindName(func_sig, func_name, '<');
+            if (name_pos == size_t(-1))
+                return _FuncNameRange{ 0, sig_len + 2 + name_len, false, true };
+            size_t start = name_pos;
+            while (start > 0 && func_sig[start - 1] != ' ')
+                start--;
+            return _FuncNameRange{ start, name_pos + name_len - start, false, false };
         }
-        inline const std::string& _getFmtE()
+
+        constexpr char _funcNameCharAt(const char* func_sig, const char* func_name, _FuncNameRange range, size_t i)
         {
-            static std::string error_message(R"([%02d:%02d:%02d %s][ERROR][%s][%s: line %d] )");
-            return error_message;
+            if (range.use_name)
+                return func_name[i];
+            if (!range.append_name)
+                return func_sig[range.start + i];
+            size_t sig_len = range.len - 2 - mbase::_constexprStrlen(func_name);
+            if (i < sig_len)
+                return func_sig[i];
+            if (i < sig_len + 2)
+                return ':';
+            return func_name[i - sig_len - 2];
         }
 
+        template<size_t N>
+        struct _FuncNameStr
+        {
+            char data[N + 1];
+        };
+
+        template<size_t N, size_t... I>
+        constexpr _FuncNameStr<N> _makeFuncNameImpl(const char* func_sig, const char* func_name, _FuncNameRange range, std::index_sequence<I...>)
+        {
+            return _FuncNameStr<N>{ { mbase::_funcNameCharAt(func_sig, func_name, range, I)..., '\0' } };
+        }
+
+        //编译期截取函数名，结果与_splitFuncName一致
+        template<size_t N>
+        constexpr _FuncNameStr<N> _makeFuncName(const char* func_sig, const char* func_name)
+        {
+            return mbase::_makeFuncNameImpl<N>(func_sig, func_name, mbase::_funcNameRange(func_sig, func_name), std::make_index_sequence<N>());
+        }
+#endif
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE std::atomic<int>& _getLogLevelRef()
+        {
+            static std::atomic<int> log_level(LogLevel::info);
+            return log_level;
+        }
+
+        _MINE_INLINE void setLogLevel(LogLevel level)
+        {
+            mbase::_getLogLevelRef().store(level, std::memory_order_relaxed);
+        }
+
+        _MINE_INLINE LogLevel getLogLevel()
+        {
+            return (LogLevel)mbase::_getLogLevelRef().load(std::memory_order_relaxed);
+        }
+
+        //不带printf格式属性的包装，避免参数为空时的-Wformat-security警告
+        _MINE_INLINE int _vsnprintfWrapper(char* buf, size_t size, const char* fmt, ...)
+        {
+            va_list ap;
+            va_start(ap, fmt);
+            int ret = vsnprintf(buf, size, fmt, ap);
+            va_end(ap);
+            return ret;
+        }
+
+        //按日志级别格式化前缀，返回snprintf的返回值
+        _MINE_INLINE int _formatLogPrefix(char* buf, size_t size, int level, std::chrono::system_clock::time_point tp, const char* funcname, const char* filename, int line)
+        {
+            if (level == LogLevel::info)
+                return snprintf(buf, size, "[INFO][%s] ", funcname);
+            char time_str[32];
+            mbase::_formatLocalTime(tp, false, false, time_str);
+            return snprintf(buf, size, "[%s][%s][%s][%s: line %d] ", time_str, level == LogLevel::warning ? "WARNING" : "ERROR", funcname, filename, line);
+        }
+
+        //INFO输出到stdout，WARNING和ERROR输出到stderr
+        _MINE_INLINE FILE* _getLogStream(int level)
+        {
+            return level == LogLevel::info ? stdout : stderr;
+        }
+#else
+        std::atomic<int>& _getLogLevelRef();
+        int _vsnprintfWrapper(char* buf, size_t size, const char* fmt, ...);
+        int _formatLogPrefix(char* buf, size_t size, int level, std::chrono::system_clock::time_point tp, const char* funcname, const char* filename, int line);
+        FILE* _getLogStream(int level);
+#endif
+
+
+        /*  异步日志的二进制参数编解码，字符串以1字节的非空标记加上以'\0'结尾的内容存储  */
+        template<class T>
+        struct _LogArg
+        {
+            static_assert(std::is_scalar<T>::value, "mprintf args must be scalar types which printf accepts!");
+            static size_t size(const T&) { return sizeof(T); }
+            static unsigned char* write(unsigned char* p, const T& value) { memcpy(p, &value, sizeof(T)); return p + sizeof(T); }
+            static const unsigned char* read(const unsigned char* p, T& value) { memcpy(&value, p, sizeof(T)); return p + sizeof(T); }
+        };
+
+        template<>
+        struct _LogArg<const char*>
+        {
+            static size_t size(const char* value) { return value ? strlen(value) + 2 : 1; }
+            static unsigned char* write(unsigned char* p, const char* value)
+            {
+                *p++ = value ? 1 : 0;
+                if (!value)
+                    return p;
+                size_t len = strlen(value) + 1;
+                memcpy(p, value, len);
+                return p + len;
+            }
+            static const unsigned char* read(const unsigned char* p, const char*& value)
+            {
+                if (*p++ == 0)
+                {
+                    value = nullptr;
+                    return p;
+                }
+                value = (const char*)p;
+                return p + strlen(value) + 1;
+            }
+        };
+
+        template<>
+        struct _LogArg<char*>
+        {
+            static size_t size(const char* value) { return _LogArg<const char*>::size(value); }
+            static unsigned char* write(unsigned char* p, const char* value) { return _LogArg<const char*>::write(p, value); }
+            static const unsigned char* read(const unsigned char* p, char*& value)
+            {
+                const char* tmp;
+                p = _LogArg<const char*>::read(p, tmp);
+                value = const_cast<char*>(tmp);
+                return p;
+            }
+        };
+
+        template<class T>
+        struct _IsLogString : std::integral_constant<bool, std::is_same<T, const char*>::value || std::is_same<T, char*>::value> {};
+
         template<class... Ts>
-        inline void _printfI(const char* fmt_chars, const char* funcname, Ts ...args)
+        struct _HasLogString : std::false_type {};
+
+        template<class T, class... Ts>
+        struct _HasLogString<T, Ts...> : std::integral_constant<bool, _IsLogString<T>::value || _HasLogString<Ts...>::value> {};
+
+        template<class... Ts>
+        struct _LogTypeList {};
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE size_t _logArgsSize()
+        {
+            return 0;
+        }
+#else
+        size_t _logArgsSize();
+#endif
+
+        template<class T, class... Ts>
+        inline size_t _logArgsSize(const T& arg, const Ts&... args)
         {
-            printf((mbase::_getFmtI() + fmt_chars).c_str(), funcname, args...);
+            return _LogArg<T>::size(arg) + mbase::_logArgsSize(args...);
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE unsigned char* _writeLogArgs(unsigned char* p)
+        {
+            return p;
+        }
+#else
+        unsigned char* _writeLogArgs(unsigned char* p);
+#endif
+
+        template<class T, class... Ts>
+        inline unsigned char* _writeLogArgs(unsigned char* p, const T& arg, const Ts&... args)
+        {
+            return mbase::_writeLogArgs(_LogArg<T>::write(p, arg), args...);
+        }
+
+        template<class... Done>
+        inline int _readLogArgs(char* buf, size_t size, const char* fmt, const unsigned char*, _LogTypeList<>, Done... done)
+        {
+            return mbase::_vsnprintfWrapper(buf, size, fmt, done...);
+        }
+
+        //逐个解码参数并追加到done中，全部解码后调用snprintf
+        template<class T, class... Ts, class... Done>
+        inline int _readLogArgs(char* buf, size_t size, const char* fmt, const unsigned char* p, _LogTypeList<T, Ts...>, Done... done)
+        {
+            T value;
+            p = _LogArg<T>::read(p, value);
+            return mbase::_readLogArgs(buf, size, fmt, p, _LogTypeList<Ts...>(), done..., value);
         }
 
         template<class... Ts>
-        inline void _printfW(const char* fmt_chars, const char* funcname, const char* filename, int line, Ts ...args)
+        inline int _decodeLogArgs(char* buf, size_t size, const char* fmt, const unsigned char* data)
         {
-            time_t now_time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-            tm buf;
-#if defined(_MSC_VER)
-            localtime_s(&buf, &now_time_t);
+            return mbase::_readLogArgs(buf, size, fmt, data, _LogTypeList<Ts...>());
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        //参数超出记录容量时，记录中保存的是已格式化的文本
+        _MINE_INLINE int _decodeLogText(char* buf, size_t size, const char*, const unsigned char* data)
+        {
+            return snprintf(buf, size, "%s", (const char*)data);
+        }
+#else
+        int _decodeLogText(char* buf, size_t size, const char*, const unsigned char* data);
+#endif
+
+        typedef int(*_LogDecodeFunc)(char* buf, size_t size, const char* fmt, const unsigned char* data);
+
+        //定长日志记录，data中依次存放函数名和参数
+        struct _LogRecord
+        {
+            enum { record_size = 512 };
+
+            _LogDecodeFunc decode;
+            const char* fmt;
+            const char* filename;    //__FILE__，具有静态存储期
+            std::chrono::system_clock::time_point tp;
+            int line;
+            int level;
+            unsigned char data[record_size - sizeof(_LogDecodeFunc) - 2 * sizeof(const char*) - sizeof(std::chrono::system_clock::time_point) - 2 * sizeof(int)];
+        };
+
+        //单生产者单消费者的无锁环形缓冲区，生产者为所属线程，消费者为后台线程
+        struct _LogRing
+        {
+            explicit _LogRing(size_t capacity) :records(capacity), mask(capacity - 1), head(0), tail(0), writing(false), orphaned(false), dropped(0) {}
+
+            std::vector<_LogRecord> records;
+            size_t mask;
+            std::atomic<size_t> head;    //消费者读取位置
+            std::atomic<size_t> tail;    //生产者写入位置
+            std::atomic<bool> writing;    //生产者是否正在写入，用于stopAsyncLog时等待写入结束
+            std::atomic<bool> orphaned;    //所属线程是否已退出
+            std::atomic<unsigned long long> dropped;
+        };
+
+        struct _AsyncLogState
+        {
+            std::atomic<bool> running{ false };
+            std::atomic<unsigned long long> generation{ 0 };    //每次开启异步日志时递增，使各线程重新注册缓冲区
+            size_t ring_capacity = 512;
+            std::mutex mtx;    //保护rings、ring_capacity和后台线程的启停
+            std::vector<std::shared_ptr<_LogRing>> rings;
+            std::thread worker;
+            std::atomic<bool> stop_flag{ false };
+            unsigned long long total_dropped = 0;
+            bool atexit_registered = false;
+        };
+
+#ifndef _MINE_DECLARATION_ONLY
+        //有意不释放，保证进程退出阶段仍在打印日志的线程可以安全访问
+        _MINE_INLINE _AsyncLogState& _getAsyncLogState()
+        {
+            static _AsyncLogState* state = new _AsyncLogState;
+            return *state;
+        }
+#else
+        _AsyncLogState& _getAsyncLogState();
+#endif
+
+        //线程退出时标记缓冲区，由后台线程输出剩余日志后回收
+        struct _LogRingHolder
+        {
+            std::shared_ptr<_LogRing> ring;
+            unsigned long long generation = 0;
+            ~_LogRingHolder()
+            {
+                if (this->ring)
+                    this->ring->orphaned.store(true, std::memory_order_release);
+            }
+        };
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE _LogRing* _getThreadLogRing()
+        {
+#if defined(__GNUC__) && !_mgccMinVersion(4, 8, 1)  //for qnx660，不支持thread_local，不使用异步日志
+            return nullptr;
+#else
+            thread_local _LogRingHolder holder;
+            _AsyncLogState& state = mbase::_getAsyncLogState();
+            unsigned long long generation = state.generation.load(std::memory_order_acquire);
+            if (!holder.ring || holder.generation != generation)
+            {
+                std::lock_guard<std::mutex> lk(state.mtx);
+                if (holder.ring)
+                    holder.ring->orphaned.store(true, std::memory_order_release);
+                holder.ring = std::make_shared<_LogRing>(state.ring_capacity);
+                holder.generation = generation;
+                state.rings.push_back(holder.ring);
+            }
+            return holder.ring.get();
+#endif
+        }
 #else
-            localtime_r(&now_time_t, &buf);
+        _LogRing* _getThreadLogRing();
 #endif
-            fprintf(stderr, (mbase::_getFmtW() + fmt_chars).c_str(), buf.tm_hour, buf.tm_min, buf.tm_sec, buf.tm_isdst ? "DST" : "STD", funcname, filename, line, args...);
+
+#ifndef _MINE_DECLARATION_ONLY
+        /*  按格式串中的转换说明检查各char*参数能否作为字符串拷贝：只有对应不带精度的%s时可以，
+            对应%p、%.*s等其他转换或格式串使用了位置参数时返回false，此时不能对该参数调用strlen   */
+        _MINE_INLINE bool _logStringArgsCopyable(const char* fmt, const bool* is_str, size_t arg_count)
+        {
+            size_t arg_id = 0;
+            for (const char* p = fmt; *p != '\0'; ++p)
+            {
+                if (*p != '%')
+                    continue;
+                ++p;
+                if (*p == '%')
+                    continue;
+                while (*p != '\0' && strchr("-+ #0'", *p) != nullptr)
+                    ++p;
+                if (*p == '*')
+                {
+                    if (arg_id < arg_count && is_str[arg_id])
+                        return false;
+                    ++arg_id;
+                    ++p;
+                }
+                while (*p >= '0' && *p <= '9')
+                    ++p;
+                if (*p == '$')
+                    return false;
+                bool has_precision = false;
+                if (*p == '.')
+                {
+                    has_precision = true;
+                    ++p;
+                    if (*p == '*')
+                    {
+                        if (arg_id < arg_count && is_str[arg_id])
+                            return false;
+                        ++arg_id;
+                        ++p;
+                    }
+                    while (*p >= '0' && *p <= '9')
+                        ++p;
+                }
+                while (*p != '\0' && strchr("hlLqjzt", *p) != nullptr)
+                    ++p;
+                if (*p == '\0')
+                    break;
+                if (arg_id < arg_count && is_str[arg_id] && (*p != 's' || has_precision))
+                    return false;
+                ++arg_id;
+            }
+            return true;
+        }
+#else
+        bool _logStringArgsCopyable(const char* fmt, const bool* is_str, size_t arg_count);
+#endif
+
+        //写入当前线程的环形缓冲区，异步日志未开启时返回false
+        template<class... Ts>
+        inline bool _pushAsyncLog(int level, const char* fmt_chars, const char* funcname, const char* filename, int line, const Ts&... args)
+        {
+            _AsyncLogState& state = mbase::_getAsyncLogState();
+            _LogRing* ring = mbase::_getThreadLogRing();
+            if (!ring)
+                return false;
+            //与stopAsyncLog配合：先标记写入再检查状态，stopAsyncLog先修改状态再等待写入结束
+            ring->writing.store(true, std::memory_order_seq_cst);
+            if (!state.running.load(std::memory_order_seq_cst))
+            {
+                ring->writing.store(false, std::memory_order_release);
+                return false;
+            }
+
+            size_t tail = ring->tail.load(std::memory_order_relaxed);
+            if (tail - ring->head.load(std::memory_order_acquire) > ring->mask)
+            {
+                ring->dropped.fetch_add(1, std::memory_order_relaxed);
+                ring->writing.store(false, std::memory_order_release);
+                return true;
+            }
+
+            _LogRecord& record = ring->records[tail & ring->mask];
+            record.fmt = fmt_chars;
+            record.filename = filename;
+            record.tp = std::chrono::system_clock::now();
+            record.line = line;
+            record.level = level;
+            size_t funcname_len = strlen(funcname) + 1;
+            if (funcname_len > sizeof(record.data) / 2)
+                funcname_len = sizeof(record.data) / 2;
+            memcpy(record.data, funcname, funcname_len);
+            record.data[funcname_len - 1] = '\0';
+            unsigned char* args_data = record.data + funcname_len;
+            size_t args_capacity = sizeof(record.data) - funcname_len;
+            static const bool is_str[] = { _IsLogString<Ts>::value..., false };
+            const bool copyable = !_HasLogString<Ts...>::value || mbase::_logStringArgsCopyable(fmt_chars, is_str, sizeof...(Ts));
+            if (copyable && mbase::_logArgsSize(args...) <= args_capacity)
+            {
+                mbase::_writeLogArgs(args_data, args...);
+                record.decode = &mbase::_decodeLogArgs<Ts...>;
+            }
+            else
+            {
+                int len = mbase::_vsnprintfWrapper((char*)args_data, args_capacity, fmt_chars, args...);
+                if (len >= (int)args_capacity && args_capacity > 5)
+                    memcpy(args_data + args_capacity - 5, "...\n", 5);
+                record.decode = &mbase::_decodeLogText;
+            }
+            ring->tail.store(tail + 1, std::memory_order_release);
+            ring->writing.store(false, std::memory_order_release);
+            return true;
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        //格式化一条记录并追加到对应输出流的批量缓冲区
+        _MINE_INLINE void _appendLogRecord(const _LogRecord& record, std::string& out_buf)
+        {
+            char buf[1024];
+            const char* funcname = (const char*)record.data;
+            const unsigned char* args_data = record.data + strlen(funcname) + 1;
+            int len = mbase::_formatLogPrefix(buf, sizeof(buf), record.level, record.tp, funcname, record.filename, record.line);
+            if (len < 0)
+                return;
+            if (len >= (int)sizeof(buf))
+                len = sizeof(buf) - 1;
+            out_buf.append(buf, len);
+
+            len = record.decode(buf, sizeof(buf), record.fmt, args_data);
+            if (len < 0)
+                return;
+            if (len < (int)sizeof(buf))
+                out_buf.append(buf, len);
+            else
+            {
+                std::string long_buf(len + 1, '\0');
+                record.decode(&long_buf[0], long_buf.size(), record.fmt, args_data);
+                out_buf.append(long_buf.c_str(), len);
+            }
+        }
+
+        //取出所有缓冲区中的日志并批量输出，返回输出的条数
+        _MINE_INLINE size_t _drainAsyncLog(_AsyncLogState& state, std::string& out_buf, std::string& err_buf)
+        {
+            size_t count = 0;
+            unsigned long long dropped = 0;
+            std::lock_guard<std::mutex> lk(state.mtx);
+            for (size_t i = 0; i < state.rings.size();)
+            {
+                _LogRing& ring = *state.rings[i];
+                bool orphaned = ring.orphaned.load(std::memory_order_acquire);
+                size_t head = ring.head.load(std::memory_order_relaxed);
+                size_t tail = ring.tail.load(std::memory_order_acquire);
+                for (; head != tail; head++, count++)
+                {
+                    const _LogRecord& record = ring.records[head & ring.mask];
+                    mbase::_appendLogRecord(record, record.level == LogLevel::info ? out_buf : err_buf);
+                }
+                ring.head.store(head, std::memory_order_release);
+                dropped += ring.dropped.exchange(0, std::memory_order_relaxed);
+                //所属线程退出后，先取出剩余日志再回收，下一轮判断时保证不会再有写入
+                if (orphaned)
+                {
+                    state.rings[i] = state.rings.back();
+                    state.rings.pop_back();
+                }
+                else i++;
+            }
+            if (dropped > 0)
+            {
+                state.total_dropped += dropped;
+                char buf[256];
+                int len = mbase::_formatLogPrefix(buf, sizeof(buf), LogLevel::warning, std::chrono::system_clock::now(), "mineutils::mbase::_drainAsyncLog", __FILE__, __LINE__);
+                if (len > 0 && len < (int)sizeof(buf))
+                    err_buf.append(buf, len);
+                snprintf(buf, sizeof(buf), "%llu log records were dropped because the ring buffer was full!\n", dropped);
+                err_buf.append(buf);
+            }
+
+            if (!out_buf.empty())
+            {
+                fwrite(out_buf.data(), 1, out_buf.size(), stdout);
+                fflush(stdout);
+                out_buf.clear();
+            }
+            if (!err_buf.empty())
+            {
+                fwrite(err_buf.data(), 1, err_buf.size(), stderr);
+                fflush(stderr);
+                err_buf.clear();
+            }
+            return count;
+        }
+
+        _MINE_INLINE void _asyncLogWorker()
+        {
+            _AsyncLogState& state = mbase::_getAsyncLogState();
+            std::string out_buf, err_buf;
+            out_buf.reserve(64 * 1024);
+            err_buf.reserve(64 * 1024);
+            while (!state.stop_flag.load(std::memory_order_acquire))
+            {
+                //没有日志时休眠，生产者无需唤醒后台线程，写入路径不包含系统调用
+                if (mbase::_drainAsyncLog(state, out_buf, err_buf) == 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            mbase::_drainAsyncLog(state, out_buf, err_buf);
+        }
+#else
+        void _appendLogRecord(const _LogRecord& record, std::string& out_buf);
+        size_t _drainAsyncLog(_AsyncLogState& state, std::string& out_buf, std::string& err_buf);
+        void _asyncLogWorker();
+#endif
+
+        //同步输出，前缀和内容格式化到同一缓冲区后一次写入，避免多线程输出交错
+        template<class... Ts>
+        inline void _printLogSync(int level, const char* fmt_chars, const char* funcname, const char* filename, int line, Ts ...args)
+        {
+            char buf[1024];
+            int prefix_len = mbase::_formatLogPrefix(buf, sizeof(buf), level, std::chrono::system_clock::now(), funcname, filename, line);
+            if (prefix_len < 0)
+                return;
+            if (prefix_len >= (int)sizeof(buf))
+                prefix_len = sizeof(buf) - 1;
+            int len = mbase::_vsnprintfWrapper(buf + prefix_len, sizeof(buf) - prefix_len, fmt_chars, args...);
+            if (len < 0)
+                return;
+            FILE* stream = mbase::_getLogStream(level);
+            if (prefix_len + len < (int)sizeof(buf))
+                fwrite(buf, 1, prefix_len + len, stream);
+            else
+            {
+                std::string long_buf(buf, prefix_len);
+                long_buf.resize(prefix_len + len + 1);
+                mbase::_vsnprintfWrapper(&long_buf[prefix_len], len + 1, fmt_chars, args...);
+                fwrite(long_buf.data(), 1, prefix_len + len, stream);
+            }
+        }
+
+        template<class... Ts>
+        inline void _printLog(int level, const char* fmt_chars, const char* funcname, const char* filename, int line, Ts ...args)
+        {
+            if (level < mbase::_getLogLevelRef().load(std::memory_order_relaxed))
+                return;
+            if (mbase::_getAsyncLogState().running.load(std::memory_order_relaxed) && mbase::_pushAsyncLog(level, fmt_chars, funcname, filename, line, args...))
+                return;
+            mbase::_printLogSync(level, fmt_chars, funcname, filename, line, args...);
+        }
+
+        template<class... Ts>
+        inline void _printfI(const char* fmt_chars, const char* funcname, Ts ...args)
+        {
+            mbase::_printLog(LogLevel::info, fmt_chars, funcname, nullptr, 0, args...);
+        }
+
+        template<class... Ts>
+        inline void _printfW(const char* fmt_chars, const char* funcname, const char* filename, int line, Ts ...args)
+        {
+            mbase::_printLog(LogLevel::warning, fmt_chars, funcname, filename, line, args...);
         }
 
         template<class... Ts>
         inline void _printfE(const char* fmt_chars, const char* funcname, const char* filename, int line, Ts ...args)
         {
-            time_t now_time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-            tm buf;
-#if defined(_MSC_VER)
-            localtime_s(&buf, &now_time_t);
+            mbase::_printLog(LogLevel::error, fmt_chars, funcname, filename, line, args...);
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE int startAsyncLog(size_t ring_capacity)
+        {
+#if defined(__GNUC__) && !_mgccMinVersion(4, 8, 1)  //for qnx660
+            mprintfW("Async log is unsupported on this compiler, logs will be printed synchronously!\n");
+            return -1;
+#else
+            _AsyncLogState& state = mbase::_getAsyncLogState();
+            size_t capacity = 2;
+            while (capacity < ring_capacity)
+                capacity <<= 1;
+
+            std::unique_lock<std::mutex> lk(state.mtx);
+            if (state.running.load(std::memory_order_relaxed))
+            {
+                lk.unlock();    //打印日志可能需要注册当前线程的缓冲区，不能持有锁
+                mprintfW("Async log has already been started!\n");
+                return 1;
+            }
+            state.ring_capacity = capacity;
+            state.rings.clear();
+            state.total_dropped = 0;
+            state.stop_flag.store(false, std::memory_order_relaxed);
+            state.generation.fetch_add(1, std::memory_order_release);
+            state.worker = std::thread(mbase::_asyncLogWorker);
+            state.running.store(true, std::memory_order_seq_cst);
+            if (!state.atexit_registered)
+            {
+                state.atexit_registered = true;
+                atexit([]() { mbase::stopAsyncLog(); });
+            }
+            return 0;
+#endif
+        }
+
+        _MINE_INLINE void stopAsyncLog()
+        {
+            _AsyncLogState& state = mbase::_getAsyncLogState();
+            std::thread worker;
+            std::vector<std::shared_ptr<_LogRing>> rings;
+            {
+                std::lock_guard<std::mutex> lk(state.mtx);
+                if (!state.running.load(std::memory_order_relaxed))
+                    return;
+                state.running.store(false, std::memory_order_seq_cst);
+                rings = state.rings;
+                worker = std::move(state.worker);
+            }
+            //等待正在写入的线程完成，此后的日志均走同步输出
+            for (auto& ring : rings)
+            {
+                while (ring->writing.load(std::memory_order_seq_cst))
+                    std::this_thread::yield();
+            }
+            state.stop_flag.store(true, std::memory_order_release);
+            if (worker.joinable())
+                worker.join();
+        }
+
+        _MINE_INLINE unsigned long long getDroppedLogCount()
+        {
+            _AsyncLogState& state = mbase::_getAsyncLogState();
+            std::lock_guard<std::mutex> lk(state.mtx);
+            unsigned long long dropped = state.total_dropped;
+            for (auto& ring : state.rings)
+                dropped += ring->dropped.load(std::memory_order_relaxed);
+            return dropped;
+        }
+#endif
+
+        //限流参数，interval为两条日志之间的平均间隔
+        struct _LogRateLimitConfig
+        {
+            std::atomic<long long> interval_ns{ 1000000000 };
+            std::atomic<int> burst{ 5 };
+        };
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE _LogRateLimitConfig& _getLogRateLimitConfig()
+        {
+            static _LogRateLimitConfig config;
+            return config;
+        }
+
+        _MINE_INLINE void setLogRateLimit(double messages_per_second, int burst)
+        {
+            _LogRateLimitConfig& config = mbase::_getLogRateLimitConfig();
+            if (burst < 1)
+            {
+                mprintfW("Invalid param value burst:%d, which will be set to 1.\n", burst);
+                burst = 1;
+            }
+            config.interval_ns.store(messages_per_second > 0 ? (long long)(1e9 / (messages_per_second > 1e-6 ? messages_per_second : 1e-6)) : 0, std::memory_order_relaxed);
+            config.burst.store(burst, std::memory_order_relaxed);
+        }
 #else
-            localtime_r(&now_time_t, &buf);
+        _LogRateLimitConfig& _getLogRateLimitConfig();
+#endif
+
+        /*  单个调用位置的令牌桶，以GCRA算法实现，只需一个原子变量
+            - tat为理论到达时间，每输出一条推后一个interval，推后的tat超出当前时间不多于burst * interval时允许输出
+            - 可常量初始化，作为宏内的局部静态变量时没有初始化开销  */
+        class _LogRateLimiter
+        {
+        public:
+            constexpr _LogRateLimiter() :tat_ns_(0), suppressed_(0) {}
+
+            //允许输出时返回true，并通过suppressed_count返回上次输出以来被抑制的条数
+            bool allow(unsigned long long& suppressed_count)
+            {
+                _LogRateLimitConfig& config = mbase::_getLogRateLimitConfig();
+                long long interval_ns = config.interval_ns.load(std::memory_order_relaxed);
+                if (interval_ns <= 0)
+                {
+                    suppressed_count = this->suppressed_.exchange(0, std::memory_order_relaxed);
+                    return true;
+                }
+                long long burst_ns = interval_ns * config.burst.load(std::memory_order_relaxed);
+                long long now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+                long long tat_ns = this->tat_ns_.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    long long new_tat_ns = (tat_ns > now_ns ? tat_ns : now_ns) + interval_ns;
+                    if (new_tat_ns - now_ns > burst_ns)
+                    {
+                        this->suppressed_.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    if (this->tat_ns_.compare_exchange_weak(tat_ns, new_tat_ns, std::memory_order_relaxed))
+                        break;
+                }
+                suppressed_count = this->suppressed_.exchange(0, std::memory_order_relaxed);
+                return true;
+            }
+
+        private:
+            std::atomic<long long> tat_ns_;
+            std::atomic<unsigned long long> suppressed_;
+        };
+
+#ifndef _MINE_DECLARATION_ONLY
+        //用于自旋等待的循环体内，提示CPU当前处于忙等待，降低功耗并减少对超线程的干扰
+        _MINE_INLINE void _cpuRelax()
+        {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            _mm_pause();
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_ia32_pause();
+#elif defined(__GNUC__) && (defined(__aarch64__) || (defined(__arm__) && defined(__ARM_ARCH) && __ARM_ARCH >= 7))
+            __asm__ __volatile__("yield" ::: "memory");
 #endif
-            fprintf(stderr, (mbase::_getFmtE() + fmt_chars).c_str(), buf.tm_hour, buf.tm_min, buf.tm_sec, buf.tm_isdst ? "DST" : "STD", funcname, filename, line, args...);
         }
 
-        inline std::pair<unsigned int, unsigned int> _normRange(std::pair<unsigned int, unsigned int> range, unsigned int len)
+        _MINE_INLINE std::pair<unsigned int, unsigned int> _normRange(std::pair<unsigned int, unsigned int> range, unsigned int len)
         {
             if (range.first >= len)
                 range.first = len;
@@ -270,10 +1194,148 @@ namespace mineutils
                 range.second = len;
             return range;
         }
+#else
+        void _cpuRelax();
+        std::pair<unsigned int, unsigned int> _normRange(std::pair<unsigned int, unsigned int> range, unsigned int len);
+#endif
 
 
     }
 
+
+#ifdef MINEUTILS_TEST_MODULES
+    namespace _mbasecheck
+    {
+        inline void LogArgsCodecTest()
+        {
+            unsigned char data[256];
+            std::string temp_str = "temp";
+            const char* null_str = nullptr;
+            mbase::_writeLogArgs(data, 42, 'c', 3.5f, -7LL, temp_str.c_str(), (size_t)9, null_str);
+            temp_str = "changed";
+            char buf[128];
+            int len = mbase::_decodeLogArgs<int, char, float, long long, const char*, size_t, const char*>(buf, sizeof(buf), "%d %c %.1f %lld %s %zu %p", data);
+            char expected[128];
+            int expected_len = snprintf(expected, sizeof(expected), "%d %c %.1f %lld %s %zu %p", 42, 'c', 3.5, -7LL, "temp", (size_t)9, (void*)nullptr);
+            bool ret0 = len == expected_len && strcmp(buf, expected) == 0;
+            if (!ret0) mprintfE(R"(Failed when check: _writeLogArgs and _decodeLogArgs)""\n");
+
+            const bool str_at_1[] = { false, true, false };
+            const bool str_at_0[] = { true, false };
+            bool ret1 = mbase::_logStringArgsCopyable("%-5d %s %p", str_at_1, 3) && mbase::_logStringArgsCopyable("%%s %10s %d", str_at_0, 2);
+            ret1 = ret1 && !mbase::_logStringArgsCopyable("%d %p %d", str_at_1, 3) && !mbase::_logStringArgsCopyable("%d %.3s %d", str_at_1, 3);
+            ret1 = ret1 && !mbase::_logStringArgsCopyable("%.*s %d", str_at_1, 3) && !mbase::_logStringArgsCopyable("%1$s %2$d", str_at_0, 2);
+            if (!ret1) mprintfE(R"(Failed when check: _logStringArgsCopyable)""\n");
+        }
+
+        inline void AsyncLogTest()
+        {
+            if (mbase::startAsyncLog(16) != 0)
+                return;
+            std::vector<std::thread> thds;
+            for (int t = 0; t < 4; t++)
+            {
+                thds.emplace_back([t]()
+                    {
+                        std::string msg = "message";
+                        mprintfI("Async thread %d %s\n", t, msg.c_str());
+                    });
+            }
+            for (auto& thd : thds)
+                thd.join();
+            const char unterminated[3] = { 'a', 'b', 'c' };    //没有结尾的'\0'，只能按精度读取
+            mprintfI("Async precision %.*s\n", 3, unterminated);
+            mbase::setLogLevel(mbase::LogLevel::off);
+            for (int i = 0; i < 100; i++)
+                mprintfE("Should be filtered!\n");
+            mbase::setLogLevel(mbase::LogLevel::info);
+            bool ret0 = mbase::getDroppedLogCount() == 0;
+            if (!ret0) mprintfE(R"(Failed when check: mbase::getDroppedLogCount())""\n");
+            mbase::stopAsyncLog();
+            printf("User check! Expected 4 lines of \"Async thread x message\" above in any order, \"Async precision abc\", and no \"Should be filtered!\".\n");
+        }
+
+        inline void LogRateLimitTest()
+        {
+            mbase::setLogRateLimit(1, 3);
+            mbase::_LogRateLimiter limiter;
+            unsigned long long suppressed_count = 0;
+            int allowed_count = 0;
+            for (int i = 0; i < 10; i++)
+            {
+                if (limiter.allow(suppressed_count))
+                    allowed_count++;
+            }
+            mbase::setLogRateLimit(0, 1);
+            bool ret0 = allowed_count == 3 && limiter.allow(suppressed_count) && suppressed_count == 7;
+            if (!ret0) mprintfE(R"(Failed when check: _LogRateLimiter::allow)""\n");
+
+            mbase::setLogRateLimit(1, 2);
+            printf("User check! Expected 2 warnings of \"Limited warning\" below:\n");
+            for (int i = 0; i < 10; i++)
+                mprintfWLimited("Limited warning %d\n", i);
+            mbase::setLogRateLimit(1, 5);
+        }
+
+        //_mdeclareFuncName的结果应与MINE_FUNCNAME一致
+        inline bool _checkFuncNameHere(const char* declared_name, const char* runtime_name)
+        {
+            bool ret = strcmp(declared_name, runtime_name) == 0;
+            if (!ret) mprintfE(R"(Failed when check: _mdeclareFuncName, got "%s", expected "%s")""\n", declared_name, runtime_name);
+            return ret;
+        }
+
+        struct _FuncNameChecker
+        {
+            bool member()
+            {
+                _mdeclareFuncName(name);
+                return _checkFuncNameHere(name, MINE_FUNCNAME);
+            }
+
+            template<class T>
+            bool templateMember(T)
+            {
+                _mdeclareFuncName(name);
+                return _checkFuncNameHere(name, MINE_FUNCNAME);
+            }
+
+            bool operator()()
+            {
+                _mdeclareFuncName(name);
+                return _checkFuncNameHere(name, MINE_FUNCNAME);
+            }
+        };
+
+        inline void FuncNameTest()
+        {
+            _mdeclareFuncName(name);
+            bool ret0 = _checkFuncNameHere(name, MINE_FUNCNAME);
+            _FuncNameChecker checker;
+            bool ret1 = checker.member() && checker.templateMember(1) && checker.templateMember(std::string()) && checker();
+            auto lambda = []()
+                {
+                    _mdeclareFuncName(name);
+                    return _checkFuncNameHere(name, MINE_FUNCNAME);
+                };
+            bool ret2 = lambda();
+            //mprintf系列宏需保持可用于表达式中
+            bool ret3 = (mprintfI("User check! Log macro used in a comma expression\n"), strcmp(_MINE_LOG_FUNCNAME, MINE_FUNCNAME) == 0);
+            printf("User check! Got function name(mineutils::_mbasecheck::FuncNameTest):%s\n", name);
+            if (!(ret0 && ret1 && ret2 && ret3)) mprintfE(R"(Failed when check: FuncNameTest)""\n");
+        }
+
+        inline void check()
+        {
+            printf("\n--------------------check mbase start--------------------\n");
+            FuncNameTest();
+            LogArgsCodecTest();
+            AsyncLogTest();
+            LogRateLimitTest();
+            printf("---------------------check mbase end---------------------\n\n");
+        }
+    }
+#endif
 }
 
 #endif // !BASE_HPP_MINEUTILS
\ No newline at end of file
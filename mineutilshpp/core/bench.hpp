@@ -0,0 +1,670 @@
+/*  基于mtime计时的微基准测试工具  */
+#pragma once
+#ifndef BENCH_HPP_MINEUTILS
+#define BENCH_HPP_MINEUTILS
+
+#include<algorithm>
+#include<fstream>
+#include<math.h>
+#include<stdio.h>
+#include<string>
+#include<utility>
+#include<vector>
+
+#include"base.hpp"
+#include"time.hpp"
+
+#ifdef MINEUTILS_TEST_MODULES
+#include"datastruct.hpp"
+#include"file.hpp"
+#include"io.hpp"
+#include"math.hpp"
+#include"path.hpp"
+#include"str.hpp"
+#include"thread.hpp"
+#endif
+
+
+namespace mineutils
+{
+    /*--------------------------------------------用户接口--------------------------------------------*/
+
+    namespace mbench
+    {
+        //阻止编译器将value的计算视为无用代码而优化掉
+        template<class T>
+        void doNotOptimize(const T& value);
+
+        //阻止编译器将value的计算视为无用代码而优化掉，并使编译器认为value可能被修改
+        template<class T>
+        void doNotOptimize(T& value);
+
+        //阻止编译器跨越该点重排或消除内存读写
+        void clobberMemory();
+
+        //单项基准测试的统计结果，时间均为单次迭代的耗时(ns)
+        struct Result
+        {
+            std::string name;
+            long long iterations = 0;    //每轮的迭代次数
+            int repeats = 0;    //统计的轮数
+            double min_ns = 0;
+            double median_ns = 0;
+            double mean_ns = 0;
+            double stddev_ns = 0;
+            double max_ns = 0;
+        };
+
+        /*  微基准测试工具，非线程安全
+            - 每项测试先预热，再自动确定每轮的迭代次数使单轮时长不低于min_round_ms，最后统计多轮的单次迭代耗时
+            - 被测函数的返回值等结果应通过doNotOptimize传出，以免被编译器优化掉
+            - 用例：mbench::Benchmark bench("mstr");  bench.run("toStr", []() { mbench::doNotOptimize(mstr::toStr(123)); });  bench.printReport();   */
+        class Benchmark
+        {
+        public:
+            /*  构造Benchmark类
+                @param title: 报告的标题，为空时表示无标题
+                @param min_round_ms: 单轮的最短时长(毫秒)，用于自动确定每轮的迭代次数
+                @param repeats: 统计的轮数，小于1的值会被置为1
+                @param warmup_ms: 每项测试的预热时长(毫秒)  */
+            Benchmark(std::string title = "", long long min_round_ms = 20, int repeats = 10, long long warmup_ms = 10);
+
+            /*  运行一项基准测试并记录结果
+                @param name: 测试项名称
+                @param func: 被测函数，无参数，每次迭代调用一次
+                @return 本项测试的结果   */
+            template<class Func>
+            const Result& run(const std::string& name, Func&& func);
+
+            //获取已记录的全部结果
+            const std::vector<Result>& results() const;
+
+            /*  打印全部结果
+                - 格式：名称  min 最小耗时ns, median 中位耗时ns, mean 平均耗时ns, stddev 标准差ns (迭代次数 x 轮数)  */
+            void printReport() const;
+
+            //将全部结果转换为CSV格式的字符串，首行为表头
+            std::string toCsv() const;
+
+            //将全部结果转换为JSON格式的字符串
+            std::string toJson() const;
+
+            //将全部结果保存为CSV文件；返回0代表正常，其他代表失败
+            int saveCsv(const std::string& path) const;
+
+            //将全部结果保存为JSON文件；返回0代表正常，其他代表失败
+            int saveJson(const std::string& path) const;
+
+            //清空已记录的结果
+            void clear();
+
+        private:
+            template<class Func>
+            double measureRound(Func& func, long long iterations);    //返回本轮总耗时(ns)
+
+            std::string title_;
+            long long min_round_ns_;
+            int repeats_;
+            long long warmup_ns_;
+            std::vector<Result> results_;
+        };
+    }
+
+
+
+
+
+
+
+
+
+
+
+
+    /*--------------------------------------------内部实现--------------------------------------------*/
+
+    namespace mbench
+    {
+        template<class T>
+        inline void doNotOptimize(const T& value)
+        {
+#if defined(__GNUC__)
+            __asm__ __volatile__("" : : "r,m"(value) : "memory");
+#else
+            static const void* volatile sink;
+            sink = &value;
+            mbench::clobberMemory();
+#endif
+        }
+
+        template<class T>
+        inline void doNotOptimize(T& value)
+        {
+#if defined(__clang__)
+            __asm__ __volatile__("" : "+r,m"(value) : : "memory");
+#elif defined(__GNUC__)
+            __asm__ __volatile__("" : "+m,r"(value) : : "memory");
+#else
+            static const void* volatile sink;
+            sink = &value;
+            mbench::clobberMemory();
+#endif
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE void clobberMemory()
+        {
+#if defined(__GNUC__)
+            __asm__ __volatile__("" : : : "memory");
+#elif defined(_MSC_VER)
+            _ReadWriteBarrier();
+#else
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+        }
+
+
+        _MINE_INLINE Benchmark::Benchmark(std::string title, long long min_round_ms, int repeats, long long warmup_ms)
+        {
+            if (repeats < 1)
+            {
+                mprintfWLimited("Invalid param value repeats:%d, which will be set to 1.\n", repeats);
+                repeats = 1;
+            }
+            this->title_ = std::move(title);
+            this->min_round_ns_ = min_round_ms * 1000000;
+            this->repeats_ = repeats;
+            this->warmup_ns_ = warmup_ms * 1000000;
+        }
+#endif
+
+        template<class Func>
+        inline double Benchmark::measureRound(Func& func, long long iterations)
+        {
+            auto start_t = mtime::now();
+            for (long long i = 0; i < iterations; i++)
+            {
+                func();
+                mbench::clobberMemory();
+            }
+            return (double)mtime::now().since<mtime::ns>(start_t);
+        }
+
+        template<class Func>
+        inline const Result& Benchmark::run(const std::string& name, Func&& func)
+        {
+            //预热，使缓存、分支预测和CPU频率趋于稳定
+            long long iterations = 1;
+            double cost_ns = 0;
+            auto warmup_start_t = mtime::now();
+            do
+            {
+                cost_ns = this->measureRound(func, iterations);
+                if (cost_ns < this->warmup_ns_ / 10)
+                    iterations *= 2;
+            } while (mtime::now().since<mtime::ns>(warmup_start_t) < this->warmup_ns_);
+
+            //按比例估算单轮的迭代次数，直到单轮时长达到min_round_ns_
+            while (cost_ns < this->min_round_ns_)
+            {
+                long long next_iterations;
+                if (cost_ns < this->min_round_ns_ / 100)
+                    next_iterations = iterations * 10;
+                else next_iterations = (long long)(iterations * 1.2 * this->min_round_ns_ / cost_ns) + 1;
+                iterations = next_iterations;
+                cost_ns = this->measureRound(func, iterations);
+            }
+
+            std::vector<double> round_ns(this->repeats_);
+            for (int i = 0; i < this->repeats_; i++)
+                round_ns[i] = this->measureRound(func, iterations) / iterations;
+
+            Result result;
+            result.name = name;
+            result.iterations = iterations;
+            result.repeats = this->repeats_;
+            double sum = 0, square_sum = 0;
+            for (double t : round_ns)
+            {
+                sum += t;
+                square_sum += t * t;
+            }
+            result.mean_ns = sum / this->repeats_;
+            double variance = square_sum / this->repeats_ - result.mean_ns * result.mean_ns;
+            result.stddev_ns = variance > 0 ? sqrt(variance) : 0;
+            std::sort(round_ns.begin(), round_ns.end());
+            result.min_ns = round_ns.front();
+            result.max_ns = round_ns.back();
+            if (this->repeats_ % 2)
+                result.median_ns = round_ns[this->repeats_ / 2];
+            else result.median_ns = (round_ns[this->repeats_ / 2 - 1] + round_ns[this->repeats_ / 2]) / 2;
+
+            this->results_.push_back(std::move(result));
+            return this->results_.back();
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE const std::vector<Result>& Benchmark::results() const
+        {
+            return this->results_;
+        }
+
+        _MINE_INLINE void Benchmark::printReport() const
+        {
+            size_t name_width = 4;
+            for (const Result& result : this->results_)
+                name_width = std::max(name_width, result.name.size());
+
+            if (!this->title_.empty())
+                printf("%s benchmark report:\n", this->title_.c_str());
+            for (const Result& result : this->results_)
+            {
+                printf("    %-*s  min %.1fns, median %.1fns, mean %.1fns, stddev %.1fns (%lld x %d)\n", (int)name_width, result.name.c_str(),
+                    result.min_ns, result.median_ns, result.mean_ns, result.stddev_ns, result.iterations, result.repeats);
+            }
+        }
+
+        _MINE_INLINE std::string _escapeCsv(const std::string& s)
+        {
+            if (s.find_first_of(",\"\r\n") == std::string::npos)
+                return s;
+            std::string escaped = "\"";
+            for (char c : s)
+            {
+                if (c == '"')
+                    escaped.push_back('"');
+                escaped.push_back(c);
+            }
+            escaped.push_back('"');
+            return escaped;
+        }
+
+        _MINE_INLINE std::string _escapeJson(const std::string& s)
+        {
+            std::string escaped;
+            escaped.reserve(s.size());
+            for (char c : s)
+            {
+                switch (c)
+                {
+                case '"': escaped.append("\\\""); break;
+                case '\\': escaped.append("\\\\"); break;
+                case '\n': escaped.append("\\n"); break;
+                case '\r': escaped.append("\\r"); break;
+                case '\t': escaped.append("\\t"); break;
+                default:
+                    if ((unsigned char)c < 0x20)
+                    {
+                        char buf[8];
+                        snprintf(buf, sizeof(buf), "\\u%04x", (unsigned)c);
+                        escaped.append(buf);
+                    }
+                    else escaped.push_back(c);
+                    break;
+                }
+            }
+            return escaped;
+        }
+
+        _MINE_INLINE std::string Benchmark::toCsv() const
+        {
+            std::string csv = "name,iterations,repeats,min_ns,median_ns,mean_ns,stddev_ns,max_ns\n";
+            char buf[256];
+            for (const Result& result : this->results_)
+            {
+                snprintf(buf, sizeof(buf), ",%lld,%d,%.3f,%.3f,%.3f,%.3f,%.3f\n", result.iterations, result.repeats,
+                    result.min_ns, result.median_ns, result.mean_ns, result.stddev_ns, result.max_ns);
+                csv.append(mbench::_escapeCsv(result.name)).append(buf);
+            }
+            return csv;
+        }
+
+        _MINE_INLINE std::string Benchmark::toJson() const
+        {
+            std::string json = "{\n  \"title\": \"" + mbench::_escapeJson(this->title_) + "\",\n  \"results\": [";
+            char buf[256];
+            for (size_t i = 0; i < this->results_.size(); i++)
+            {
+                const Result& result = this->results_[i];
+                snprintf(buf, sizeof(buf), "\", \"iterations\": %lld, \"repeats\": %d, \"min_ns\": %.3f, \"median_ns\": %.3f, \"mean_ns\": %.3f, \"stddev_ns\": %.3f, \"max_ns\": %.3f}",
+                    result.iterations, result.repeats, result.min_ns, result.median_ns, result.mean_ns, result.stddev_ns, result.max_ns);
+                json.append(i == 0 ? "\n    {\"name\": \"" : ",\n    {\"name\": \"").append(mbench::_escapeJson(result.name)).append(buf);
+            }
+            json.append(this->results_.empty() ? "]\n}\n" : "\n  ]\n}\n");
+            return json;
+        }
+
+        _MINE_INLINE int _saveText(const std::string& path, const std::string& text)
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc | std::ios::out);
+            if (!file.is_open())
+            {
+                mprintfE("Open %s failed!\n", path.c_str());
+                return -1;
+            }
+            file << text;
+            return file.good() ? 0 : -1;
+        }
+
+        _MINE_INLINE int Benchmark::saveCsv(const std::string& path) const
+        {
+            return mbench::_saveText(path, this->toCsv());
+        }
+
+        _MINE_INLINE int Benchmark::saveJson(const std::string& path) const
+        {
+            return mbench::_saveText(path, this->toJson());
+        }
+
+        _MINE_INLINE void Benchmark::clear()
+        {
+            this->results_.clear();
+        }
+#else
+        std::string _escapeCsv(const std::string& s);
+        std::string _escapeJson(const std::string& s);
+        int _saveText(const std::string& path, const std::string& text);
+#endif
+    }
+
+
+
+#ifdef MINEUTILS_TEST_MODULES
+    namespace _mbenchcheck
+    {
+        inline void BenchmarkTest()
+        {
+            mbench::Benchmark bench("BenchmarkTest", 5, 5, 1);
+            const mbench::Result& result = bench.run("empty", []() {});
+            bool ret0 = result.repeats == 5 && result.iterations > 0 && result.min_ns <= result.median_ns && result.median_ns <= result.max_ns;
+            std::string csv = bench.toCsv();
+            std::string json = bench.toJson();
+            bool ret1 = csv.find("name,iterations,repeats") == 0 && csv.find("\nempty,") != std::string::npos;
+            bool ret2 = json.find("\"title\": \"BenchmarkTest\"") != std::string::npos && json.find("{\"name\": \"empty\"") != std::string::npos;
+            if (!ret0) mprintfE(R"(Failed when check: bench.run("empty", []() {}))""\n");
+            if (!ret1) mprintfE(R"(Failed when check: bench.toCsv())""\n");
+            if (!ret2) mprintfE(R"(Failed when check: bench.toJson())""\n");
+        }
+
+        //各模块热点函数的基准测试
+        inline void CoreBenchmarks()
+        {
+            mbench::Benchmark bench("mineutils core");
+
+            int int_value = 123456;
+            double double_value = 3.1415926;
+            bench.run("mstr::toStr(int)", [&]() { mbench::doNotOptimize(mstr::toStr(int_value)); });
+            bench.run("mstr::toStr(double)", [&]() { mbench::doNotOptimize(mstr::toStr(double_value)); });
+            bench.run("mstr::toStr<3>(double)", [&]() { mbench::doNotOptimize(mstr::toStr<3>(double_value)); });
+            bench.run("mstr::format", [&]() { mbench::doNotOptimize(mstr::format("frame {}: cost {}ms, {}", int_value, double_value, "ok")); });
+            bench.run("mstr::fastFormat", [&]() { mbench::doNotOptimize(mstr::fastFormat("frame {}: cost {}ms, {}", int_value, double_value, "ok")); });
+            char format_buf[64];
+            bench.run("mstr::formatTo", [&]() { mbench::doNotOptimize(mstr::formatTo(format_buf, sizeof(format_buf), "frame {}: cost {:.3f}ms, {}", int_value, double_value, "ok")); });
+
+            float scores[8] = { 0.91f, 0.85f, 0.77f, 0.64f, 0.52f, 0.43f, 0.31f, 0.2f };
+            bench.run("std::string+=mstr::toStr x8", [&]()
+                {
+                    std::string s;
+                    for (float score : scores)
+                        s += mstr::toStr<2>(score) + ",";
+                    mbench::doNotOptimize(s);
+                });
+            mstr::StringBuilder builder;
+            bench.run("mstr::StringBuilder::append x8", [&]()
+                {
+                    builder.clear();
+                    for (float score : scores)
+                        mstr::toStr<2>(builder, score).append(",", 1);
+                    mbench::doNotOptimize(builder.data());
+                });
+
+            std::string int_str = "-123456", double_str = "3.1415926";
+            int parsed_int = 0;
+            double parsed_double = 0;
+            bench.run("std::stoi", [&]() { mbench::doNotOptimize(std::stoi(int_str)); });
+            bench.run("mstr::parse<int>", [&]() { mstr::parse(int_str, parsed_int); mbench::doNotOptimize(parsed_int); });
+            bench.run("std::stod", [&]() { mbench::doNotOptimize(std::stod(double_str)); });
+            bench.run("mstr::parse<double>", [&]() { mstr::parse(double_str, parsed_double); mbench::doNotOptimize(parsed_double); });
+            std::string row = "0.125,1920.5,-3.75,42,0.001,7,100.25,-8";
+            double row_values[8];
+            bench.run("mstr::parseRow x8", [&]() { mstr::parseRow(row, ',', row_values, 8); mbench::doNotOptimize(row_values[7]); });
+
+            std::string line = "1920,1080,30,h264,main,yuv420p,8,progressive";
+            bench.run("mstr::split", [&]() { mbench::doNotOptimize(mstr::split(line, ",")); });
+            bench.run("mstr::splitView", [&]() { mbench::doNotOptimize(mstr::splitView(line, ",")); });
+            bench.run("mstr::splitIter", [&]()
+                {
+                    size_t total_len = 0;
+                    for (mstr::StrView token : mstr::splitIter(line, ","))
+                        total_len += token.size();
+                    mbench::doNotOptimize(total_len);
+                });
+
+            std::string html = "<p class='title'>Tom & Jerry</p>";
+            mstr::MultiReplacer html_escaper({ { "&", "&amp;" }, { "<", "&lt;" }, { ">", "&gt;" }, { "'", "&#39;" } });
+            bench.run("mstr::replace", [&]() { mbench::doNotOptimize(mstr::replace(html, "&", "&amp;")); });
+            bench.run("mstr::MultiReplacer::replace x4 patterns", [&]() { mbench::doNotOptimize(html_escaper.replace(html)); });
+
+            std::string path = "/home//user/./project/../data/images/./0001.jpg";
+            bench.run("mpath::normPath", [&]() { mbench::doNotOptimize(mpath::normPath(path)); });
+
+            //输出重定向到丢弃内容的缓冲区，只测量格式化和加锁写出的开销
+            struct NullStreamBuf : std::streambuf
+            {
+                int overflow(int c) override { return c; }
+                std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+            } null_buf;
+            std::streambuf* cout_buf = std::cout.rdbuf(&null_buf);
+            bench.run("mio::print x3 args", [&]() { mio::print("frame", int_value, double_value); });
+            mio::setPrintFlushPolicy(mio::flush_by_size, 1 << 16);
+            bench.run("mio::print x3 args (flush_by_size)", [&]() { mio::print("frame", int_value, double_value); });
+            mio::setPrintFlushPolicy(mio::flush_by_line);
+            std::cout.rdbuf(cout_buf);
+            mio::PrintRingBuffer print_ring(1 << 16);
+            bench.run("mio::printTo(PrintRingBuffer) x3 args", [&]() { mio::printTo(print_ring, "frame", int_value, double_value); });
+
+            std::vector<const char*> argv_vec = { "demo", "-v", "--num", "8", "--rate", "0.5", "--name", "task" };
+            mio::ArgumentParser arg_parser;
+            arg_parser.parse((int)argv_vec.size(), (char**)argv_vec.data(), { {"-v", "--verbose", ""} }, { {"-n", "--num", "", "4"}, {"-r", "--rate", "", "1"}, {"", "--name", "", ""} });
+            bench.run("mio::ArgumentParser::getValueOpt+stoi", [&]() { mbench::doNotOptimize(std::stoi(arg_parser.getValueOpt("--num"))); });
+            mio::OptionRegistry option_registry;
+            option_registry.addFlag("-v", "--verbose", "");
+            mio::OptionHandle<int> num_option = option_registry.addOption<int>("-n", "--num", "", 4);
+            option_registry.addOption("-r", "--rate", "", 1.0);
+            option_registry.addOption("", "--name", "", "", true);
+            bench.run("mio::OptionRegistry::parse", [&]() { mbench::doNotOptimize(option_registry.parse((int)argv_vec.size(), (char**)argv_vec.data())); });
+            bench.run("mio::OptionHandle<int>::get", [&]() { mbench::doNotOptimize(num_option.get()); });
+
+            mmath::RectLTRB<float> rect1(10.f, 20.f, 110.f, 220.f), rect2(60.f, 70.f, 160.f, 270.f);
+            bench.run("mmath::RectLTRB::clipTo", [&]() { mbench::doNotOptimize(rect1.clipTo(rect2).area()); });
+
+            mds::CircularQueue<int> queue(1024);
+            int dequeue_value = 0;
+            bench.run("mds::CircularQueue::enqueue+tryDequeue", [&]()
+                {
+                    queue.enqueue(int_value);
+                    queue.tryDequeue(dequeue_value);
+                    mbench::doNotOptimize(dequeue_value);
+                });
+
+            mthrd::SpinLock spin_lock;
+            bench.run("mthrd::SpinLock::lock+unlock", [&]()
+                {
+                    spin_lock.lock();
+                    spin_lock.unlock();
+                });
+
+            mthrd::ThreadPool thread_pool(2);
+            bench.run("mthrd::ThreadPool::addTask+get", [&]() { mbench::doNotOptimize(*thread_pool.addTask([](int x) { return x; }, int_value).getPtr()); });
+
+            mtime::MeanTimeCounter time_counter(1 << 30);
+            std::string tag = "tag";
+            bench.run("mtime::MeanTimeCounter::markStart+markEnd", [&]()
+                {
+                    time_counter.markStart(tag);
+                    time_counter.markEnd(tag);
+                });
+
+            printf("User check! Benchmark report of core functions:\n");
+            bench.printReport();
+        }
+
+        //MB级日志和CSV文本的分割基准测试，对比逐字节查找的std::string接口；以及大文件的CSV和ini读写
+        inline void LargeInputBenchmarks()
+        {
+            mbench::Benchmark bench("mineutils large input", 20, 5);
+
+            std::string log_text, csv_text;
+            for (int i = 0; log_text.size() < (4 << 20); i++)
+                log_text += mstr::fastFormat("[2026-10-19 12:00:{:02}.{:03}][INFO][module{}]\tframe {} done, cost {:.3f}ms\n", i % 60, i % 1000, i % 8, i, i * 0.001);
+            for (int i = 0; csv_text.size() < (4 << 20); i++)
+                csv_text += mstr::fastFormat("{},{},{:.2f},h264,main,yuv420p,{},progressive\n", i, i % 1920, i * 0.5, i % 10);
+
+            bench.run("std::string::find_first_of whitespace 4MB", [&]()
+                {
+                    size_t count = 0, lpos = 0, rpos = 0;
+                    while ((lpos = log_text.find_first_not_of(" \t\n\r\f\v", rpos)) != std::string::npos)
+                    {
+                        rpos = log_text.find_first_of(" \t\n\r\f\v", lpos);
+                        count++;
+                    }
+                    mbench::doNotOptimize(count);
+                });
+            bench.run("mstr::split whitespace 4MB", [&]() { mbench::doNotOptimize(mstr::split(log_text)); });
+            bench.run("mstr::splitIter whitespace 4MB", [&]()
+                {
+                    size_t count = 0;
+                    for (mstr::StrView token : mstr::splitIter(log_text))
+                        count += token.size();
+                    mbench::doNotOptimize(count);
+                });
+
+            bench.run("std::string::find '\\n' 4MB", [&]()
+                {
+                    size_t count = 0, pos = 0;
+                    while ((pos = log_text.find('\n', pos)) != std::string::npos)
+                    {
+                        pos++;
+                        count++;
+                    }
+                    mbench::doNotOptimize(count);
+                });
+            bench.run("mstr::splitIter '\\n' 4MB", [&]()
+                {
+                    size_t count = 0;
+                    for (mstr::StrView token : mstr::splitIter(log_text, "\n"))
+                        count += token.size();
+                    mbench::doNotOptimize(count);
+                });
+
+            bench.run("std::string::find ',' 4MB", [&]()
+                {
+                    size_t count = 0, pos = 0;
+                    while ((pos = csv_text.find(',', pos)) != std::string::npos)
+                    {
+                        pos++;
+                        count++;
+                    }
+                    mbench::doNotOptimize(count);
+                });
+            bench.run("mstr::split ',' 4MB", [&]() { mbench::doNotOptimize(mstr::split(csv_text, ",")); });
+            bench.run("mstr::splitIter ',' 4MB", [&]()
+                {
+                    size_t count = 0;
+                    for (mstr::StrView token : mstr::splitIter(csv_text, ","))
+                        count += token.size();
+                    mbench::doNotOptimize(count);
+                });
+
+            //约4MB、10万行的检测结果CSV，对比逐行格式化写入std::ofstream、std::getline后mstr::split的做法
+            const std::string csv_path = "mineutils_bench.csv";
+            const int csv_rows = 100000;
+            bench.run("std::ofstream+mstr::format CSV 100k rows", [&]()
+                {
+                    std::ofstream file(csv_path, std::ios::binary);
+                    for (int i = 0; i < csv_rows; i++)
+                        file << mstr::format("{},{},{},{},{},{}\n", i, "person", 0.875, i % 1920, i % 1080, 64.5);
+                });
+            bench.run("mfile::CsvWriter CSV 100k rows", [&]()
+                {
+                    mfile::CsvWriter writer;
+                    writer.open(csv_path);
+                    for (int i = 0; i < csv_rows; i++)
+                        writer.writeRow(i, "person", 0.875, i % 1920, i % 1080, 64.5);
+                });
+            bench.run("std::getline+mstr::split CSV 100k rows", [&]()
+                {
+                    std::ifstream file(csv_path, std::ios::binary);
+                    std::string csv_line;
+                    size_t count = 0;
+                    while (std::getline(file, csv_line))
+                        count += mstr::split(csv_line, ",").size();
+                    mbench::doNotOptimize(count);
+                });
+            bench.run("mfile::CsvReader CSV 100k rows", [&]()
+                {
+                    mfile::CsvReader reader;
+                    reader.open(csv_path);
+                    std::vector<mstr::StrView> fields;
+                    size_t count = 0;
+                    while (reader.readRow(fields) > 0)
+                        count += fields.size();
+                    mbench::doNotOptimize(count);
+                });
+            ::remove(csv_path.c_str());
+
+            //1000个section、5万行的ini，对比打开、查找和修改后保存的耗时
+            const std::string ini_path = "mineutils_bench.ini";
+            std::string ini_text;
+            for (int i = 0; i < 1000; i++)
+            {
+                ini_text += mstr::fastFormat("[section{}]\n", i);
+                for (int j = 0; j < 49; j++)
+                    ini_text += mstr::fastFormat("key{} = {}  ; comment\n", j, i * 100 + j);
+            }
+            std::ofstream ini_out(ini_path, std::ios::binary);
+            ini_out << ini_text;
+            ini_out.close();
+            bench.run("mfile::IniFile::open+close ini 50k lines", [&]()
+                {
+                    mfile::IniFile ini;
+                    ini.open(ini_path);
+                });
+            bench.run("mfile::IniFile::openMapped+close ini 50k lines", [&]()
+                {
+                    mfile::IniFile ini;
+                    ini.openMapped(ini_path);
+                });
+            mfile::IniFile ini_file;
+            ini_file.open(ini_path);
+            std::string ini_section = "section517", ini_key = "key33";
+            bench.run("mfile::IniFile::getValue ini 50k lines", [&]() { mbench::doNotOptimize(ini_file.getValue(ini_section, ini_key)); });
+            bench.run("mfile::IniFile::getValueView ini 50k lines", [&]() { mbench::doNotOptimize(ini_file.getValueView(ini_section, ini_key)); });
+            bench.run("mfile::IniFile::getValue+std::stoi ini 50k lines", [&]() { mbench::doNotOptimize(std::stoi(ini_file.getValue(ini_section, ini_key))); });
+            bench.run("mfile::IniFile::getAs<int> ini 50k lines", [&]() { mbench::doNotOptimize(ini_file.getAs(ini_section, ini_key, 0)); });
+            ini_file.close();
+            bench.run("mfile::IniFile::open+setValue+close ini 50k lines", [&]()
+                {
+                    mfile::IniFile ini;
+                    ini.open(ini_path);
+                    ini.setValue("section999", "key48", ini.getValue("section999", "key48") == "99948" ? 1 : 99948);
+                });
+            ::remove(ini_path.c_str());
+
+            printf("User check! Benchmark report of large input splitting, CSV and ini:\n");
+            bench.printReport();
+        }
+
+        inline void check()
+        {
+            printf("\n--------------------check mbench start--------------------\n");
+            BenchmarkTest();
+            CoreBenchmarks();
+            LargeInputBenchmarks();
+            printf("---------------------check mbench end---------------------\n\n");
+        }
+    }
+#endif
+}
+
+#endif // !BENCH_HPP_MINEUTILS
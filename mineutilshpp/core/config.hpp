@@ -0,0 +1,740 @@
+//mineutils库的配置相关功能，合并ini文件、环境变量和命令行参数
+#pragma once
+#ifndef CONFIG_HPP_MINEUTILS
+#define CONFIG_HPP_MINEUTILS
+
+#include<atomic>
+#include<memory>
+#include<mutex>
+#include<stdint.h>
+#include<stdio.h>
+#include<stdlib.h>
+#include<string>
+#include<type_traits>
+#include<unordered_map>
+#include<vector>
+
+#include"base.hpp"
+#include"file.hpp"
+#include"io.hpp"
+#include"str.hpp"
+
+
+namespace mineutils
+{
+    /*--------------------------------------------用户接口--------------------------------------------*/
+
+    namespace mcfg
+    {
+        //配置项的值的来源，优先级由低到高
+        enum ConfigSource
+        {
+            from_default = 0,
+            from_ini = 1,
+            from_env = 2,
+            from_args = 3
+        };
+
+        class Config;
+        class ConfigSnapshot;
+        struct _ConfigValueBase;
+
+        //配置项的键，由Config::addItem返回，记录配置项在快照中的下标
+        template<class T>
+        class ConfigKey
+        {
+        public:
+            ConfigKey();
+
+            //键是否有效，添加配置项失败时返回的键无效
+            bool valid() const;
+
+        private:
+            friend class Config;
+            friend class ConfigSnapshot;
+            explicit ConfigKey(size_t item_id);
+
+            size_t item_id_;
+        };
+
+        /*  不可变的配置快照，由Config::load发布
+            - 读取配置项只是一次数组下标访问，可以在热路径中使用
+            - 快照发布后不会被修改，多线程可以同时读取   */
+        class ConfigSnapshot
+        {
+        public:
+            //获取配置项的值，key必须来自发布本快照的Config
+            template<class T>
+            const T& get(const ConfigKey<T>& key) const;
+
+            //获取配置项的值的来源
+            template<class T>
+            ConfigSource source(const ConfigKey<T>& key) const;
+
+            //快照的版本号，每次成功加载后递增，从1开始
+            unsigned long long version() const;
+
+        private:
+            friend class Config;
+            ConfigSnapshot() = default;
+            ConfigSnapshot(const ConfigSnapshot& other);    //深拷贝各配置项的值
+
+            std::vector<std::unique_ptr<_ConfigValueBase>> values_;    //每个配置项按自身类型单独存放
+            std::vector<ConfigSource> sources_;
+            unsigned long long version_ = 0;
+        };
+
+        /*  合并ini文件、环境变量和命令行参数的配置层，优先级为命令行参数 > 环境变量 > ini文件 > 默认值
+            - 先用addItem声明配置项，再设置来源并调用load，之后通过snapshot获取不可变的快照读取配置
+            - 配置项名为"section.key"形式时对应ini中section下的key，没有'.'时对应无section的key
+            - 环境变量名为前缀加上配置项名的大写形式，'.'和'-'替换为'_'，如前缀"APP_"时server.port对应APP_SERVER_PORT
+            - 命令行参数为--配置项名，由mio::OptionRegistry解析，如--server.port=8080或--server.port 8080，bool配置项可以只写--name；
+              未定义的参数会被忽略并给出警告
+            - 配置项的类型可以为bool、不超过8字节的整数和浮点数、std::string，数值使用mstr::parse解析，int8_t和uint8_t按整数处理
+            - reload和reloadIfChanged重新读取ini文件和环境变量，解析成功后原子地发布新快照，失败时保留原快照
+            - reloadIfChanged比较ini文件内容的哈希，不依赖文件的修改时间
+            - 用例：mcfg::Config config;
+                    auto port = config.addItem("server.port", 8080);
+                    config.setIniPath("app.ini"); config.setEnvPrefix("APP_"); config.setArgs(argc, argv);
+                    if (config.load() != 0) return -1;
+                    auto snapshot = config.snapshot();
+                    int p = snapshot->get(port);   */
+        class Config
+        {
+        public:
+            Config();
+
+            /*  声明配置项，需要在load之前调用，load之后添加会失败
+                @param name: 配置项名，只能包含字母、数字、'_'、'-'和'.'，不能以'.'或'-'开头，不能以'.'结尾
+                @param default_value: 所有来源都没有给出时的值
+                @param description: 描述，用于printItems
+                @return 配置项的键，失败时返回无效的键   */
+            template<class T>
+            ConfigKey<T> addItem(const std::string& name, const T& default_value, const std::string& description = "");
+
+            //同上，以C字符串给出默认值时按std::string处理
+            ConfigKey<std::string> addItem(const std::string& name, const char* default_value, const std::string& description = "");
+
+            //设置ini文件路径，为空时不读取ini文件
+            void setIniPath(std::string path);
+
+            //设置环境变量名的前缀，默认为空
+            void setEnvPrefix(std::string prefix);
+
+            //设置命令行参数，会复制一份，reload时不再变化
+            void setArgs(int argc, char* argv[]);
+
+            /*  从各来源加载配置并发布新快照，可以多次调用
+                @return 0代表正常，-1代表配置项定义有误、ini文件无法打开或值无法解析，此时保留原快照   */
+            int load();
+
+            //同load，用于热更新
+            int reload();
+
+            /*  ini文件的内容变化时重新加载
+                @return 1代表已重新加载，0代表未变化，-1代表加载失败   */
+            int reloadIfChanged();
+
+            /*  获取当前快照，持有期间快照不会变化
+                - 获取快照需要加锁并增加引用计数，热路径中应持有快照并通过version判断是否需要更新   */
+            std::shared_ptr<const ConfigSnapshot> snapshot() const;
+
+            //当前快照的版本号，未加载时为0，只是一次原子读取
+            unsigned long long version() const;
+
+            //打印各配置项在当前快照中的值和来源
+            void printItems() const;
+
+            //禁止拷贝和移动
+            Config(const Config& tmp) = delete;
+            Config& operator=(const Config& tmp) = delete;
+
+        private:
+            struct Item;
+
+            bool addItemInfo(const std::string& name, const std::string& description, size_t* item_id);
+            int applyValue(ConfigSnapshot& snapshot, size_t item_id, mstr::StrView text, ConfigSource source);
+
+            std::vector<Item> items_;
+            std::unordered_map<std::string, size_t> item_ids_;    //配置项名到下标，用于检查重复
+            ConfigSnapshot defaults_;    //只包含默认值的快照，每次加载以它为起点
+            mio::OptionRegistry arg_options_;    //每个配置项对应一个--name选项
+            bool invalid_;
+            bool loaded_;
+
+            std::string ini_path_;
+            std::string env_prefix_;
+            std::vector<std::string> args_;
+            bool args_parsed_;    //args_已由arg_options_解析，重新加载时不再重复解析
+            uint64_t ini_hash_;
+            bool ini_hashed_;    //上次加载时是否读到了ini文件
+
+            std::mutex load_mtx_;    //串行化加载
+            mutable std::mutex snapshot_mtx_;    //保护current_的读写
+            std::shared_ptr<const ConfigSnapshot> current_;
+            std::atomic<unsigned long long> version_;
+        };
+    }
+
+
+
+
+
+
+
+
+
+
+    /*--------------------------------------------内部实现--------------------------------------------*/
+
+    namespace mcfg
+    {
+        //快照中一个配置项的值，按配置项自身的类型存放
+        struct _ConfigValueBase
+        {
+            virtual ~_ConfigValueBase() {}
+
+            virtual _ConfigValueBase* clone() const = 0;
+
+            //将文本解析后写入，返回0代表成功，失败时值不变
+            virtual int parse(mstr::StrView text) = 0;
+
+            virtual std::string str() const = 0;
+        };
+
+        template<class T>
+        struct _ConfigValue : _ConfigValueBase
+        {
+            explicit _ConfigValue(const T& init_value) : value(init_value) {}
+
+            _ConfigValueBase* clone() const override;
+            int parse(mstr::StrView text) override;
+            std::string str() const override;
+
+            T value;
+        };
+
+        //配置项在mio::OptionRegistry中对应的选项
+        struct _ConfigArgBase
+        {
+            virtual ~_ConfigArgBase() {}
+
+            //选项是否在命令行中给出
+            virtual bool isSet() const = 0;
+
+            //将选项的值写入快照中对应的配置项
+            virtual void copyTo(_ConfigValueBase& value) const = 0;
+        };
+
+        template<class T>
+        struct _ConfigArg : _ConfigArgBase
+        {
+            explicit _ConfigArg(const mio::OptionHandle<T>& option_handle) : handle(option_handle) {}
+
+            bool isSet() const override;
+            void copyTo(_ConfigValueBase& value) const override;
+
+            mio::OptionHandle<T> handle;
+        };
+
+        struct Config::Item
+        {
+            std::string name;
+            std::string description;
+            std::string section;
+            std::string key;
+            std::string env_name;
+            std::unique_ptr<_ConfigArgBase> arg;
+        };
+
+        template<class T>
+        inline ConfigKey<T>::ConfigKey() : item_id_(size_t(-1))
+        {
+        }
+
+        template<class T>
+        inline ConfigKey<T>::ConfigKey(size_t item_id) : item_id_(item_id)
+        {
+        }
+
+        template<class T>
+        inline bool ConfigKey<T>::valid() const
+        {
+            return this->item_id_ != size_t(-1);
+        }
+
+        template<class T>
+        inline const T& ConfigSnapshot::get(const ConfigKey<T>& key) const
+        {
+            return static_cast<const _ConfigValue<T>&>(*this->values_[key.item_id_]).value;
+        }
+
+        template<class T>
+        inline ConfigSource ConfigSnapshot::source(const ConfigKey<T>& key) const
+        {
+            return this->sources_[key.item_id_];
+        }
+
+        template<class T>
+        inline int _parseConfigValue(mstr::StrView text, T& value, std::true_type)
+        {
+            return mstr::_parseTypedNumber(mstr::trimView(text), value) == 0 ? 0 : -1;
+        }
+
+        template<class T>
+        inline int _parseConfigValue(mstr::StrView text, T& value, std::false_type)
+        {
+            value = text.str();
+            return 0;
+        }
+
+        template<class T>
+        inline std::string _configValueToStr(const T& value, std::true_type)
+        {
+            return value ? "true" : "false";
+        }
+
+        template<class T>
+        inline std::string _configValueToStr(const T& value, std::false_type)
+        {
+            return mstr::_typedNumberToStr(value);
+        }
+
+        template<class T>
+        inline _ConfigValueBase* _ConfigValue<T>::clone() const
+        {
+            return new _ConfigValue<T>(this->value);
+        }
+
+        template<class T>
+        inline int _ConfigValue<T>::parse(mstr::StrView text)
+        {
+            T parsed = T();
+            if (mcfg::_parseConfigValue(text, parsed, std::is_arithmetic<T>()) != 0)
+                return -1;
+            this->value = parsed;
+            return 0;
+        }
+
+        template<class T>
+        inline std::string _ConfigValue<T>::str() const
+        {
+            return mcfg::_configValueToStr(this->value, std::is_same<T, bool>());
+        }
+
+        template<class T>
+        inline bool _ConfigArg<T>::isSet() const
+        {
+            return this->handle.isSet();
+        }
+
+        template<class T>
+        inline void _ConfigArg<T>::copyTo(_ConfigValueBase& value) const
+        {
+            static_cast<_ConfigValue<T>&>(value).value = this->handle.get();
+        }
+
+        //bool配置项注册为标志，可以只写--name
+        template<class T>
+        inline mio::OptionHandle<T> _addConfigOption(mio::OptionRegistry& options, const std::string& flag, const std::string& description, const T&, std::true_type)
+        {
+            return options.addFlag("", flag, description);
+        }
+
+        template<class T>
+        inline mio::OptionHandle<T> _addConfigOption(mio::OptionRegistry& options, const std::string& flag, const std::string& description, const T& default_value, std::false_type)
+        {
+            return options.addOption<T>("", flag, description, default_value);
+        }
+
+        template<class T>
+        inline ConfigKey<T> Config::addItem(const std::string& name, const T& default_value, const std::string& description)
+        {
+            static_assert((std::is_arithmetic<T>::value && sizeof(T) <= sizeof(uint64_t)) || std::is_same<T, std::string>::value,
+                "Config::addItem only supports bool, integers and floating point numbers no larger than 8 bytes, and std::string!");
+            std::lock_guard<std::mutex> lk(this->load_mtx_);
+            size_t item_id = 0;
+            if (!this->addItemInfo(name, description, &item_id))
+                return ConfigKey<T>();
+            mio::OptionHandle<T> handle = mcfg::_addConfigOption(this->arg_options_, "--" + name, description, default_value, std::is_same<T, bool>());
+            if (!handle.valid())
+            {
+                this->items_.pop_back();
+                this->item_ids_.erase(name);
+                this->invalid_ = true;
+                return ConfigKey<T>();
+            }
+            this->items_[item_id].arg.reset(new _ConfigArg<T>(handle));
+            this->defaults_.values_.emplace_back(new _ConfigValue<T>(default_value));
+            this->defaults_.sources_.push_back(from_default);
+            return ConfigKey<T>(item_id);
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        //计算文件内容的64位FNV-1a哈希，用于判断ini文件是否变化
+        _MINE_INLINE int _hashConfigFile(const std::string& path, uint64_t* hash)
+        {
+            FILE* file = fopen(path.c_str(), "rb");
+            if (file == nullptr)
+                return -1;
+            uint64_t value = 14695981039346656037ULL;
+            unsigned char buf[4096];
+            size_t n = 0;
+            while ((n = fread(buf, 1, sizeof(buf), file)) > 0)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    value ^= buf[i];
+                    value *= 1099511628211ULL;
+                }
+            }
+            bool failed = ferror(file) != 0;
+            fclose(file);
+            if (failed)
+                return -1;
+            *hash = value;
+            return 0;
+        }
+
+        _MINE_INLINE ConfigSnapshot::ConfigSnapshot(const ConfigSnapshot& other) : sources_(other.sources_), version_(other.version_)
+        {
+            this->values_.reserve(other.values_.size());
+            for (const auto& value : other.values_)
+                this->values_.emplace_back(value->clone());
+        }
+
+        _MINE_INLINE unsigned long long ConfigSnapshot::version() const
+        {
+            return this->version_;
+        }
+
+        _MINE_INLINE Config::Config() : invalid_(false), loaded_(false), args_parsed_(false), ini_hash_(0), ini_hashed_(false), version_(0)
+        {
+        }
+
+        _MINE_INLINE ConfigKey<std::string> Config::addItem(const std::string& name, const char* default_value, const std::string& description)
+        {
+            return this->addItem<std::string>(name, default_value ? default_value : "", description);
+        }
+
+        _MINE_INLINE void Config::setIniPath(std::string path)
+        {
+            std::lock_guard<std::mutex> lk(this->load_mtx_);
+            this->ini_path_ = std::move(path);
+            this->ini_hashed_ = false;
+        }
+
+        _MINE_INLINE void Config::setEnvPrefix(std::string prefix)
+        {
+            std::lock_guard<std::mutex> lk(this->load_mtx_);
+            this->env_prefix_ = std::move(prefix);
+        }
+
+        _MINE_INLINE void Config::setArgs(int argc, char* argv[])
+        {
+            std::lock_guard<std::mutex> lk(this->load_mtx_);
+            this->args_.clear();
+            this->args_parsed_ = false;
+            for (int i = 1; i < argc; ++i)
+            {
+                if (argv[i] != nullptr)
+                    this->args_.emplace_back(argv[i]);
+            }
+        }
+
+        _MINE_INLINE int Config::load()
+        {
+            std::lock_guard<std::mutex> lk(this->load_mtx_);
+            if (this->invalid_)
+            {
+                mprintfE("Config has invalid items, load failed!\n");
+                return -1;
+            }
+            this->loaded_ = true;
+
+            std::shared_ptr<ConfigSnapshot> snapshot(new ConfigSnapshot(this->defaults_));
+            uint64_t ini_hash = 0;
+            bool ini_hashed = false;
+            if (!this->ini_path_.empty())
+            {
+                //先计算哈希再读取，期间文件被修改时下次reloadIfChanged会再加载一次
+                ini_hashed = mcfg::_hashConfigFile(this->ini_path_, &ini_hash) == 0;
+                mfile::IniFile ini_file;
+                if (ini_file.open(this->ini_path_) != 0)
+                {
+                    mprintfE("Failed to open ini file:%s!\n", this->ini_path_.c_str());
+                    return -1;
+                }
+                for (size_t i = 0; i < this->items_.size(); ++i)
+                {
+                    const Item& item = this->items_[i];
+                    if (!ini_file.hasKey(item.section, item.key))
+                        continue;
+                    if (this->applyValue(*snapshot, i, ini_file.getValue(item.section, item.key), from_ini) != 0)
+                        return -1;
+                }
+            }
+
+            for (size_t i = 0; i < this->items_.size(); ++i)
+            {
+                std::string env_name = this->env_prefix_ + this->items_[i].env_name;
+                const char* env_value = getenv(env_name.c_str());
+                if (env_value == nullptr)
+                    continue;
+                if (this->applyValue(*snapshot, i, env_value, from_env) != 0)
+                    return -1;
+            }
+
+            //命令行参数在setArgs之后不会变化，只在第一次加载时解析；OptionRegistry需要argv[0]
+            if (!this->args_parsed_)
+            {
+                std::string program_name = "config";
+                std::vector<char*> argv(1, &program_name[0]);
+                for (std::string& arg : this->args_)
+                    argv.push_back(&arg[0]);
+                if (this->arg_options_.parse(static_cast<int>(argv.size()), argv.data()) != 0)
+                    return -1;
+                this->args_parsed_ = true;
+            }
+            for (size_t i = 0; i < this->items_.size(); ++i)
+            {
+                const Item& item = this->items_[i];
+                if (!item.arg->isSet())
+                    continue;
+                item.arg->copyTo(*snapshot->values_[i]);
+                snapshot->sources_[i] = from_args;
+            }
+
+            snapshot->version_ = this->version_.load() + 1;
+            {
+                std::lock_guard<std::mutex> snapshot_lk(this->snapshot_mtx_);
+                this->current_ = std::move(snapshot);
+                this->version_.store(this->current_->version_);
+            }
+            this->ini_hash_ = ini_hash;
+            this->ini_hashed_ = ini_hashed;
+            return 0;
+        }
+
+        _MINE_INLINE int Config::reload()
+        {
+            return this->load();
+        }
+
+        _MINE_INLINE int Config::reloadIfChanged()
+        {
+            {
+                std::lock_guard<std::mutex> lk(this->load_mtx_);
+                if (this->ini_path_.empty())
+                    return 0;
+                uint64_t ini_hash = 0;
+                if (this->ini_hashed_ && mcfg::_hashConfigFile(this->ini_path_, &ini_hash) == 0 && ini_hash == this->ini_hash_)
+                    return 0;
+            }
+            return this->load() == 0 ? 1 : -1;
+        }
+
+        _MINE_INLINE std::shared_ptr<const ConfigSnapshot> Config::snapshot() const
+        {
+            std::lock_guard<std::mutex> lk(this->snapshot_mtx_);
+            return this->current_;
+        }
+
+        _MINE_INLINE unsigned long long Config::version() const
+        {
+            return this->version_.load(std::memory_order_acquire);
+        }
+
+        _MINE_INLINE void Config::printItems() const
+        {
+            static const char* source_names[] = { "default", "ini", "env", "args" };
+            std::shared_ptr<const ConfigSnapshot> snapshot = this->snapshot();
+            const ConfigSnapshot& shown = snapshot ? *snapshot : this->defaults_;
+            printf("Config items (version %llu):\n", shown.version_);
+            for (const Item& item : this->items_)
+            {
+                size_t item_id = &item - this->items_.data();
+                printf("    %s = %s  (from %s)  %s\n", item.name.c_str(), shown.values_[item_id]->str().c_str(),
+                    source_names[shown.sources_[item_id]], item.description.c_str());
+            }
+            printf("\n");
+        }
+
+        _MINE_INLINE bool Config::addItemInfo(const std::string& name, const std::string& description, size_t* item_id)
+        {
+            if (this->loaded_)
+            {
+                mprintfE("Config item \"%s\" must be added before load!\n", name.c_str());
+                return false;
+            }
+            bool name_ok = !name.empty() && name.front() != '.' && name.front() != '-' && name.back() != '.';
+            for (char c : name)
+            {
+                if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-' || c == '.'))
+                    name_ok = false;
+            }
+            if (!name_ok)
+            {
+                mprintfE("Invalid config item name:\"%s\"!\n", name.c_str());
+                this->invalid_ = true;
+                return false;
+            }
+            if (!this->item_ids_.emplace(name, this->items_.size()).second)
+            {
+                mprintfE("Config item \"%s\" is already added!\n", name.c_str());
+                this->invalid_ = true;
+                return false;
+            }
+
+            Item item;
+            item.name = name;
+            item.description = description;
+            size_t dot_pos = name.rfind('.');
+            if (dot_pos != std::string::npos)
+            {
+                item.section = name.substr(0, dot_pos);
+                item.key = name.substr(dot_pos + 1);
+            }
+            else item.key = name;
+            item.env_name = name;
+            for (char& c : item.env_name)
+            {
+                if (c >= 'a' && c <= 'z')
+                    c = static_cast<char>(c - 'a' + 'A');
+                else if (c == '.' || c == '-')
+                    c = '_';
+            }
+            *item_id = this->items_.size();
+            this->items_.push_back(std::move(item));
+            return true;
+        }
+
+        _MINE_INLINE int Config::applyValue(ConfigSnapshot& snapshot, size_t item_id, mstr::StrView text, ConfigSource source)
+        {
+            const Item& item = this->items_[item_id];
+            if (snapshot.values_[item_id]->parse(text) != 0)
+            {
+                static const char* source_names[] = { "default", "ini", "env", "args" };
+                mprintfE("Failed to parse value \"%s\" of config item \"%s\" from %s!\n", text.str().c_str(), item.name.c_str(), source_names[source]);
+                return -1;
+            }
+            snapshot.sources_[item_id] = source;
+            return 0;
+        }
+#else
+        int _hashConfigFile(const std::string& path, uint64_t* hash);
+#endif
+    }
+
+
+#ifdef MINEUTILS_TEST_MODULES
+    namespace _mcfgcheck
+    {
+        inline void _writeConfigTestFile(const char* path, const char* content)
+        {
+            FILE* file = fopen(path, "wb");
+            if (file != nullptr)
+            {
+                fputs(content, file);
+                fclose(file);
+            }
+        }
+
+        inline void _setConfigTestEnv(const char* name, const char* value)
+        {
+#if defined(_MSC_VER)
+            _putenv_s(name, value);
+#else
+            setenv(name, value, 1);
+#endif
+        }
+
+        inline void _unsetConfigTestEnv(const char* name)
+        {
+#if defined(_MSC_VER)
+            _putenv_s(name, "");
+#else
+            unsetenv(name);
+#endif
+        }
+
+        inline void ConfigTest()
+        {
+            const char* path = "mineutils_config_test.ini";
+            _writeConfigTestFile(path, "level = 2\nsmall = 12\n[server]\nport = 8000\nhost = ini.host\nratio = 0.5\n");
+            _mcfgcheck::_setConfigTestEnv("MINECFGTEST_SERVER_HOST", "env.host");
+            _mcfgcheck::_setConfigTestEnv("MINECFGTEST_SERVER_RATIO", "0.75");
+
+            mcfg::Config config;
+            auto port = config.addItem("server.port", 80);
+            auto host = config.addItem("server.host", "localhost");
+            auto ratio = config.addItem("server.ratio", 1.0);
+            auto level = config.addItem("level", 0);
+            auto verbose = config.addItem("verbose", false);
+            auto threads = config.addItem<unsigned short>("threads", 4);
+            auto small = config.addItem<uint8_t>("small", 7);
+            char arg0[] = "app", arg1[] = "--server.port=9000", arg2[] = "--verbose", arg3[] = "--unknown", arg4[] = "--server.ratio", arg5[] = "0.25";
+            char* argv[] = { arg0, arg1, arg2, arg3, arg4, arg5 };
+            config.setIniPath(path);
+            config.setEnvPrefix("MINECFGTEST_");
+            config.setArgs(6, argv);
+            printf("User check! Expect a warning about the unknown option --unknown:\n");
+            bool ret0 = (config.version() == 0 && !config.snapshot() && config.load() == 0 && config.version() == 1);
+            auto snapshot = config.snapshot();
+            ret0 = ret0 && (snapshot && snapshot->version() == 1);
+            ret0 = ret0 && (snapshot->get(port) == 9000 && snapshot->source(port) == mcfg::from_args);
+            ret0 = ret0 && (snapshot->get(host) == "env.host" && snapshot->source(host) == mcfg::from_env);
+            ret0 = ret0 && (snapshot->get(ratio) == 0.25 && snapshot->source(ratio) == mcfg::from_args);
+            ret0 = ret0 && (snapshot->get(level) == 2 && snapshot->source(level) == mcfg::from_ini);
+            ret0 = ret0 && (snapshot->get(verbose) && snapshot->get(threads) == 4 && snapshot->source(threads) == mcfg::from_default);
+            ret0 = ret0 && (snapshot->get(small) == 12 && snapshot->source(small) == mcfg::from_ini);
+            if (!ret0) mprintfE(R"(Failed when check: Config merges args > env > ini > default)""\n");
+
+            //ini变化后重新加载，旧快照保持不变；解析失败时保留原快照
+            bool ret1 = (config.reloadIfChanged() == 0);
+            _writeConfigTestFile(path, "level = 30\n[server]\nport = 8000\n");
+            ret1 = ret1 && (config.reloadIfChanged() == 1 && config.version() == 2);
+            auto snapshot2 = config.snapshot();
+            ret1 = ret1 && (snapshot2->get(level) == 30 && snapshot2->version() == 2 && snapshot->get(level) == 2 && snapshot->version() == 1);
+            if (!ret1) mprintfE(R"(Failed when check: Config::reloadIfChanged publishes a new snapshot and keeps the old one intact)""\n");
+
+            //大小不变且在同一秒内的修改也能被发现
+            _writeConfigTestFile(path, "level = 31\n[server]\nport = 8000\n");
+            bool ret2 = (config.reloadIfChanged() == 1 && config.version() == 3 && config.reloadIfChanged() == 0);
+            auto snapshot3 = config.snapshot();
+            ret2 = ret2 && (snapshot3->get(level) == 31 && snapshot2->get(level) == 30);
+            if (!ret2) mprintfE(R"(Failed when check: Config::reloadIfChanged detects edits that keep the file size and mtime second)""\n");
+
+            printf("User check! Expect an error about adding an item after load:\n");
+            auto late_key = config.addItem("late", 1);
+            bool ret3 = (!late_key.valid() && config.reload() == 0 && config.version() == 4);
+            if (!ret3) mprintfE(R"(Failed when check: Config rejects items added after load)""\n");
+
+            printf("User check! Expect an error about parsing \"many\":\n");
+            _writeConfigTestFile(path, "level = many\n");
+            auto snapshot4 = config.snapshot();
+            bool ret4 = (config.reload() == -1 && config.version() == 4 && config.snapshot() == snapshot4);
+            mcfg::Config bad_config;
+            printf("User check! Expect errors about an invalid and a duplicated item:\n");
+            auto bad_key = bad_config.addItem("bad name", 1);
+            bad_config.addItem("level", 1);
+            auto dup_key = bad_config.addItem("level", 2);
+            ret4 = ret4 && (!bad_key.valid() && !dup_key.valid() && bad_config.load() == -1);
+            if (!ret4) mprintfE(R"(Failed when check: Config keeps the old snapshot when loading fails)""\n");
+            ::remove(path);
+            _mcfgcheck::_unsetConfigTestEnv("MINECFGTEST_SERVER_HOST");
+            _mcfgcheck::_unsetConfigTestEnv("MINECFGTEST_SERVER_RATIO");
+        }
+
+        inline void check()
+        {
+            printf("\n--------------------check mcfg start--------------------\n");
+            ConfigTest();
+            printf("---------------------check mcfg end---------------------\n\n");
+        }
+    }
+#endif
+}
+
+
+#endif // !CONFIG_HPP_MINEUTILS
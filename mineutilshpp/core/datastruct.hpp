@@ -116,7 +116,7 @@ namespace mineutils
 		{
 			if (this->buffer_.empty())
 			{
-				mprintfW("Capacity is 0!\n");
+				mprintfWLimited("Capacity is 0!\n");
 				return;
 			}
 
@@ -134,7 +134,7 @@ namespace mineutils
 		{
 			if (this->buffer_.empty())
 			{
-				mprintfW("Capacity is 0!\n");
+				mprintfWLimited("Capacity is 0!\n");
 				return;
 			}
 			if (this->count_ == this->cache_num_)
@@ -150,7 +150,7 @@ namespace mineutils
 		{
 			if (this->buffer_.empty())
 			{
-				mprintfW("Capacity is 0!\n");
+				mprintfWLimited("Capacity is 0!\n");
 				return false;
 			}
 			return this->tryDequeueDispatch(dst);
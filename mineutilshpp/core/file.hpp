@@ -3,12 +3,21 @@
 #ifndef FILE_HPP_MINEUTILS
 #define FILE_HPP_MINEUTILS
 
+#include<algorithm>
 #include<fstream>
 #include<iostream>
-#include<list>
-#include<map>
+#include<memory>
+#include<stdint.h>
+#include<stdio.h>
+#include<string.h>
 #include<string>
 #include<vector>
+#if !defined(_WIN32)
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
 
 #include"base.hpp"
 #include"str.hpp"
@@ -20,7 +29,10 @@ namespace mineutils
 
     namespace mfile
     {
-        //读写ini文件
+        /*  读写ini文件
+            - 打开时一次读入整个文件，各行连续存放在同一个缓冲区中，section和key通过开放寻址哈希表索引，查找时不构造临时字符串
+            - 修改过的行追加到缓冲区末尾，只有内容确实变化时close才会写回文件
+            - 只读的大文件可以用openMapped打开，直接在内存映射上建立索引，配合getValueView读取时不复制任何内容   */
         class IniFile
         {
         public:
@@ -33,22 +45,61 @@ namespace mineutils
                 @return 0代表正常，其他代表失败   */
             int open(std::string path, const char key_value_sep = '=', std::vector<std::string> note_signs = { "#", ";" });
 
-            //关闭并保存文件，文件已关闭也能close；返回0代表正常，其他代表失败
+            /*  以只读方式打开ini文件，文件内容通过mmap映射，只记录各行、section和key在映射中的位置
+                - 打开只需一次遍历且没有逐行的内存分配，多个进程打开同一文件时共享页缓存
+                - 打开期间不能修改，setValue会失败；文件在打开期间不能被截断，否则访问映射时进程会收到SIGBUS
+                - Windows下不使用内存映射，退化为一次读入整个文件，仍为只读
+                @return 0代表正常，其他代表失败   */
+            int openMapped(std::string path, const char key_value_sep = '=', std::vector<std::string> note_signs = { "#", ";" });
+
+            //关闭文件，内容被修改过时先保存，文件已关闭也能close；返回0代表正常，其他代表失败
             int close();
 
             //通过section和key获取value的值，section为空代表无section
-            std::string getValue(const std::string& section, const std::string& key);
+            std::string getValue(mstr::StrView section, mstr::StrView key);
 
             //通过key获取value的值，只能获取无section的key-value条目
-            std::string getValue(const std::string& key);
+            std::string getValue(mstr::StrView key);
+
+            //同getValue，返回指向内部缓冲区或文件映射的视图，不复制字符串；只在下一次setValue或close之前有效
+            mstr::StrView getValueView(mstr::StrView section, mstr::StrView key);
+
+            //同getValue(key)，返回视图，只能获取无section的key-value条目
+            mstr::StrView getValueView(mstr::StrView key);
+
+            //判断section下是否存在key，section为空代表无section；不存在时不打印警告
+            bool hasKey(mstr::StrView section, mstr::StrView key);
+
+            /*  获取value并转换为T类型，T可以为bool、整数、浮点数和std::string，数值使用mstr::parse解析，int8_t和uint8_t按整数处理
+                - 每个key缓存最近一次转换的结果，再次以相同类型获取时不再解析，setValue修改该key后缓存失效
+                @param default_value: key不存在或无法转换时返回的值，不存在时不打印警告
+                @return 转换后的值   */
+            template<class T>
+            T getAs(mstr::StrView section, mstr::StrView key, const T& default_value);
+
+            //同上，以C字符串给出默认值时返回std::string
+            std::string getAs(mstr::StrView section, mstr::StrView key, const char* default_value);
 
-            //设置和添加key-value条目，，section为空代表无section，value可以是任意正确支持std::cout<<的类型
+            /*  将key绑定到变量value，绑定时若文件已打开立即写入，之后每次open或openMapped成功后自动写入
+                - key不存在或无法转换时value保持不变；setValue不会修改绑定的变量
+                - 绑定保存value的地址，value失效前需调用unbindAll
+                @return 0代表已写入，1代表文件未打开或key不存在，-1代表无法转换   */
+            template<class T>
+            int bind(mstr::StrView section, mstr::StrView key, T& value);
+
+            //解除所有绑定
+            void unbindAll();
+
+            //设置和添加key-value条目，section为空代表无section，value可以是任意正确支持std::cout<<的类型；值未变化时不会标记为已修改
             template<class T, typename std::enable_if<mtype::StdCoutEachChecker<T>::value, int>::type = 0>
-            void setValue(const std::string& section, const std::string& key, const T& value);
+            void setValue(mstr::StrView section, mstr::StrView key, const T& value);
 
             //设置和添加无section的key-value条目，value可以是任意正确支持std::cout<<的类型
             template<class T, typename std::enable_if<mtype::StdCoutEachChecker<T>::value, int>::type = 0>
-            void setValue(const std::string& key, const T& value);
+            void setValue(mstr::StrView key, const T& value);
+
+            //内容是否被修改且尚未保存
+            bool isModified() const;
 
             //打印读取的文件内容
             void printContents();
@@ -59,21 +110,174 @@ namespace mineutils
             ~IniFile();
 
         private:
+            struct LineInfo;
             struct SectionInfo;
             struct KeyInfo;
+            struct BindInfo;
+
+            template<class T>
+            T getAsValue(mstr::StrView section, mstr::StrView key, const T& default_value, std::true_type);
+            template<class T>
+            T getAsValue(mstr::StrView section, mstr::StrView key, const T& default_value, std::false_type);
+            size_t locateKey(mstr::StrView section, mstr::StrView key) const;
+            mstr::StrView valueView(size_t key_id) const;
+            int applyBind(const BindInfo& bind_info);
+            void applyBinds();
 
-            bool searchSection(const std::string& line, SectionInfo& section_info, size_t offset);
-            bool searchKey(const std::string& line, KeyInfo& key_info, size_t offset);
+            const char* textData() const;
+            void indexContents(size_t size);
+            mstr::StrView lineView(size_t line_id) const;
+            mstr::StrView sectionName(size_t section_id) const;
+            mstr::StrView keyName(size_t key_id) const;
+            size_t findSection(mstr::StrView section) const;
+            size_t findKey(size_t section_id, mstr::StrView key) const;
+            size_t addSection(size_t name_pos, size_t name_len, size_t line_id);
+            bool addKey(const KeyInfo& key_info);
+            size_t insertLine(mstr::StrView text, size_t prev_line_id);
+            void setValueText(mstr::StrView section, mstr::StrView key, mstr::StrView value);
+            mstr::StrView stripNote(mstr::StrView line) const;
+            bool searchSection(mstr::StrView content, size_t& name_pos, size_t& name_len) const;
+            bool searchKey(mstr::StrView content, KeyInfo& key_info) const;
             int saveContents();
 
             std::string file_path_;
-            std::fstream file_;
-            char rwstatus_ = 'r';
+            bool opened_ = false;
+            bool modified_ = false;
+            bool bom_ = false;
+            bool read_only_ = false;
             char sep_ = '=';
             std::vector<std::string> note_signs_ = { "#", ";" };
-            std::list<std::string> content_list_;
-            std::map<std::string, SectionInfo> section_map_;
-            std::map<std::string, std::map<std::string, KeyInfo>> key_map_;
+            std::string arena_;   //所有行的内容，修改后的行追加到末尾
+            const char* map_data_ = nullptr;   //openMapped的文件映射，此时不使用arena_
+            size_t map_size_ = 0;
+            std::vector<LineInfo> lines_;   //按下标保存各行，文件中的顺序由LineInfo::next串联
+            size_t first_line_ = -1;
+            size_t last_line_ = -1;
+            std::vector<SectionInfo> sections_;
+            std::vector<KeyInfo> keys_;
+            std::vector<size_t> section_table_;   //开放寻址哈希表，保存sections_的下标，空位为-1
+            std::vector<size_t> key_table_;   //开放寻址哈希表，保存keys_的下标，以section下标和key共同计算哈希
+            std::vector<BindInfo> binds_;
+        };
+
+        /*  流式读取CSV/TSV文件，按块读入内部缓冲区，逐行返回指向缓冲区的字段视图
+            - 支持RFC 4180的引号规则：以'"'开头的字段可以包含分隔符、换行和转义的""，返回的字段已去掉引号并还原转义
+            - 行尾的"\r\n"和"\n"均可识别，文件开头的UTF-8 BOM会被跳过
+            - 用例：mfile::CsvReader reader; std::vector<mstr::StrView> fields; while (reader.readRow(fields) > 0) {...}   */
+        class CsvReader
+        {
+        public:
+            CsvReader() = default;
+
+            /*  打开CSV文件
+                @param path: 文件路径
+                @param sep: 字段分隔符，TSV文件使用'\t'
+                @param buffer_size: 每次读入的字节数，单行超出时缓冲区会自动扩大
+                @return 0代表正常，其他代表失败   */
+            int open(const std::string& path, char sep = ',', size_t buffer_size = 1 << 20);
+
+            //关闭文件，文件已关闭也能close
+            void close();
+
+            //文件是否已打开
+            bool isOpened() const;
+
+            /*  读取下一行
+                @param fields: 接收该行的各个字段，内容只在下一次readRow或close之前有效；空行得到空的fields
+                @return 1代表读到一行，0代表已到文件末尾，-1代表失败   */
+            int readRow(std::vector<mstr::StrView>& fields);
+
+            //上一次readRow读到的行在文件中的起始行号，从1开始
+            size_t lineNumber() const;
+
+            //禁止拷贝和移动
+            CsvReader(const CsvReader& reader) = delete;
+            CsvReader& operator=(const CsvReader& reader) = delete;
+            ~CsvReader();
+
+        private:
+            int fillBuffer();
+            bool findRowEnd(size_t& row_end, size_t& newline_count) const;
+            void splitRow(size_t row_end, std::vector<mstr::StrView>& fields);
+
+            FILE* file_ = nullptr;
+            std::vector<char> buf_;
+            size_t begin_ = 0;   //未处理数据的起点
+            size_t end_ = 0;   //已读入数据的终点
+            bool eof_ = false;
+            char sep_ = ',';
+            size_t next_line_number_ = 1;
+            size_t line_number_ = 0;
+        };
+
+        /*  带缓冲的CSV/TSV写入，字段直接转换到内部缓冲区，写满后一次写入文件
+            - bool、字符、整数和浮点数不经过流直接转换，结果与mstr::toStr一致，也可以用setFloatPrecision设置浮点数的小数位数
+            - 字符串字段包含分隔符、引号或换行时自动加引号并转义，其他类型先用mstr::toStr转换
+            - 用例：writer.writeRow(frame_id, "person", score, x, y);   */
+        class CsvWriter
+        {
+        public:
+            CsvWriter() = default;
+
+            /*  打开CSV文件用于写入
+                @param path: 文件路径
+                @param sep: 字段分隔符，TSV文件使用'\t'
+                @param append: 为true时追加到文件末尾，否则清空原文件
+                @param buffer_size: 缓冲区字节数
+                @return 0代表正常，其他代表失败   */
+            int open(const std::string& path, char sep = ',', bool append = false, size_t buffer_size = 1 << 16);
+
+            //写入缓冲区中剩余的内容并关闭文件，文件已关闭也能close；返回0代表正常，其他代表失败
+            int close();
+
+            //文件是否已打开
+            bool isOpened() const;
+
+            //设置浮点数保留的小数位数，为-1时与mstr::toStr的默认输出一致
+            void setFloatPrecision(int precision);
+
+            //在当前行追加一个字段；返回0代表正常，其他代表失败
+            template<class T>
+            int writeField(const T& field);
+
+            //结束当前行；返回0代表正常，其他代表失败
+            int endRow();
+
+            //写入一整行，相当于依次writeField后endRow；返回0代表正常，其他代表失败
+            template<class... Args>
+            int writeRow(const Args&... fields);
+
+            //把缓冲区的内容写入文件；返回0代表正常，其他代表失败
+            int flush();
+
+            //禁止拷贝和移动
+            CsvWriter(const CsvWriter& writer) = delete;
+            CsvWriter& operator=(const CsvWriter& writer) = delete;
+            ~CsvWriter();
+
+        private:
+            char* reserve(size_t n);
+            int writeSep();
+            int writeText(const char* s, size_t len);
+            template<class T>
+            int writeFieldImpl(const T& field, std::integral_constant<int, 0>);
+            template<class T>
+            int writeFieldImpl(const T& field, std::integral_constant<int, 1>);
+            template<class T>
+            int writeFieldImpl(const T& field, std::integral_constant<int, 2>);
+            template<class T>
+            int writeFieldImpl(const T& field, std::integral_constant<int, 3>);
+            int writeRowImpl();
+            template<class T, class... Args>
+            int writeRowImpl(const T& field, const Args&... fields);
+
+            FILE* file_ = nullptr;
+            std::unique_ptr<char[]> buf_;
+            size_t capacity_ = 0;
+            size_t len_ = 0;
+            char sep_ = ',';
+            int float_precision_ = -1;
+            bool row_started_ = false;
         };
 
     }
@@ -90,335 +294,1184 @@ namespace mineutils
 
     namespace mfile
     {
+        struct IniFile::LineInfo
+        {
+            size_t pos;   //行内容在arena_或文件映射中的起点
+            size_t len;
+            size_t next;   //文件中下一行的下标，最后一行为-1
+        };
+
         struct IniFile::SectionInfo
         {
-            std::list<std::string>::iterator line;
-            std::list<std::string>::iterator last;
-            size_t pos = std::string::npos;
-            size_t len = 0;
+            size_t name_pos;   //section名在arena_或文件映射中的起点
+            size_t name_len;
+            size_t hash;
+            size_t line;   //section所在行，无section时为-1
+            size_t last;   //section中最后一个key-value条目所在行，没有条目时同line
         };
 
         struct IniFile::KeyInfo
         {
-            std::list<std::string>::iterator line;
-            size_t key_pos = std::string::npos;;
-            size_t key_len = 0;
-            size_t value_pos = std::string::npos;;
-            size_t value_len = 0;
+            size_t section;
+            size_t hash;   //以section下标为种子计算的key的哈希
+            size_t line;
+            size_t key_pos;   //以下位置均相对于行首
+            size_t key_len;
+            size_t value_pos;
+            size_t value_len;
+            uint64_t cache;   //getAs缓存的数值，类型由cache_type标识
+            const void* cache_type;   //缓存的类型标记，为nullptr时没有缓存
+        };
+
+        struct IniFile::BindInfo
+        {
+            std::string section;
+            std::string key;
+            void* target;
+            int (*assign)(mstr::StrView text, void* target);   //将文本转换后写入target，返回0代表成功
         };
 
+        //每个类型对应唯一的地址，用作getAs缓存的类型标记
+        template<class T>
+        inline const void* _iniTypeTag()
+        {
+            static const char tag = 0;
+            return &tag;
+        }
+
+        template<class T>
+        inline int _assignIniValue(mstr::StrView text, T& value, std::true_type)
+        {
+            return mstr::_parseTypedNumber(text, value) == 0 ? 0 : -1;   //失败时不修改value，int8_t和uint8_t按整数解析
+        }
+
+        template<class T>
+        inline int _assignIniValue(mstr::StrView text, T& value, std::false_type)
+        {
+            value.assign(text.data(), text.size());
+            return 0;
+        }
+
+        template<class T>
+        inline int _assignIniTarget(mstr::StrView text, void* target)
+        {
+            return mfile::_assignIniValue(text, *static_cast<T*>(target), std::is_arithmetic<T>());
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        //带种子的FNV-1a哈希，用于IniFile的section和key索引
+        _MINE_INLINE size_t _hashIniName(mstr::StrView name, size_t seed)
+        {
+            uint64_t hash = 14695981039346656037ULL ^ (seed * 0x9E3779B97F4A7C15ULL);
+            for (char c : name)
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ULL;
+            }
+            return static_cast<size_t>(hash ^ (hash >> 29));
+        }
+
+        //以线性探测将id放入哈希表，调用方保证表中有空位
+        _MINE_INLINE void _insertIniIndex(std::vector<size_t>& table, size_t hash, size_t id)
+        {
+            const size_t mask = table.size() - 1;
+            size_t i = hash & mask;
+            while (table[i] != size_t(-1))
+                i = (i + 1) & mask;
+            table[i] = id;
+        }
+
         //打开ini文件
-        inline int IniFile::open(std::string path, const char key_value_sep, std::vector<std::string> note_signs)
-        {
-            /*  ios::app：　　　 //以追加的方式打开文件
-                ios::ate：　　　 //文件打开后定位到文件尾，ios:app就包含有此属性
-                ios::binary：　 //以二进制方式打开文件，缺省的方式是文本方式。两种方式的区别见前文
-                ios::in：　　　  //文件以输入方式打开（文件数据输入到内存）
-                ios::out：　　　 //文件以输出方式打开（内存数据输出到文件）
-                ios::nocreate： //不建立文件，所以文件不存在时打开失败
-                ios::noreplace：//不覆盖文件，所以打开文件时如果文件存在失败
-                ios::trunc：　  //如果文件存在，把文件长度设为0   */
-            if (this->file_.is_open())
-            {
-                mprintfW("Duplicated open!\n");
+        _MINE_INLINE int IniFile::open(std::string path, const char key_value_sep, std::vector<std::string> note_signs)
+        {
+            if (this->opened_)
+            {
+                mprintfWLimited("Duplicated open!\n");
                 return 1;
             }
 
-            this->file_.open(path, std::ios::binary | std::ios::in);
-            if (!this->file_.is_open())
+            FILE* file = fopen(path.c_str(), "rb");
+            if (file == nullptr)
             {
-                //printf("!Warning! %s: Failed to open %s! Please check if the file exists.\n", __FUNCTION__, path.c_str());
                 mprintfE("Failed to open %s! Please check if the file exists.\n", path.c_str());
                 return -1;
             }
-            else
+            //一次读入整个文件，各行只记录在arena_中的位置
+            if (fseek(file, 0, SEEK_END) == 0)
+            {
+                long file_size = ftell(file);
+                if (file_size > 0)
+                    this->arena_.reserve(static_cast<size_t>(file_size));
+                fseek(file, 0, SEEK_SET);
+            }
+            char buf[1 << 16];
+            size_t read_len;
+            while ((read_len = fread(buf, 1, sizeof(buf), file)) > 0)
+                this->arena_.append(buf, read_len);
+            bool read_error = ferror(file) != 0;
+            fclose(file);
+            if (read_error)
             {
-                this->file_path_ = std::move(path);
-                this->sep_ = key_value_sep;
-                this->note_signs_ = std::move(note_signs);
+                mprintfE("Failed to read %s!\n", path.c_str());
+                this->arena_.clear();
+                return -1;
+            }
 
-                std::string line;
-                std::vector<std::string> line_split;
-                //content_list_.clear();
-                int line_id = -1;
-                std::string now_section = "";
-                while (this->file_.good())   //按行读取内容，并去掉\r和\n符号
-                {
-                    size_t offset = 0;
-                    line_id++;
-                    line.clear();
-                    std::getline(this->file_, line);
-                    if (line_id == 0)
-                    {
-                        if (line.size() > 3 && line.substr(0, 3) == "\xEF\xBB\xBF")
-                        {
-                            mprintfI("Process the file:%s with UTF-8 BOM encoding\n", this->file_path_.c_str());
-                            offset = 3;
-                        }
-                        else mprintfI("Process the file:%s with UTF-8 encoding\n", this->file_path_.c_str());
-                    }
-                    if (!line.empty())
-                    {
-                        line = mstr::rtrim(std::move(line));
-                    }
-                    this->content_list_.emplace_back(line);
-                    if (line.empty())
-                        continue;
-                    SectionInfo section_info;
-                    if (this->searchSection(line, section_info, offset))
-                    {
-                        now_section = line.substr(section_info.pos, section_info.len);
-                        if (this->section_map_.find(now_section) != this->section_map_.end())
-                        {
-                            mprintfW("Duplicate section:%s at line:%d!\n", now_section.c_str(), line_id + 1);
-                            continue;
-                        }
-                        section_info.line = --this->content_list_.end();
-                        section_info.last = --this->content_list_.end();
+            this->file_path_ = std::move(path);
+            this->sep_ = key_value_sep;
+            this->note_signs_ = std::move(note_signs);
+            this->opened_ = true;
+            this->indexContents(this->arena_.size());
+            this->applyBinds();
+            return 0;
+        }
 
-                        this->section_map_[now_section] = section_info;
-                        this->key_map_[now_section] = {};
-                        continue;
-                    }
+        _MINE_INLINE int IniFile::openMapped(std::string path, const char key_value_sep, std::vector<std::string> note_signs)
+        {
+#if defined(_WIN32)
+            int ret = this->open(std::move(path), key_value_sep, std::move(note_signs));
+            if (ret == 0)
+                this->read_only_ = true;
+            return ret;
+#else
+            if (this->opened_)
+            {
+                mprintfWLimited("Duplicated open!\n");
+                return 1;
+            }
 
-                    KeyInfo key_info;
-                    if (this->searchKey(line, key_info, offset))
-                    {
-                        this->section_map_[now_section].last = --this->content_list_.end();
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                mprintfE("Failed to open %s! Please check if the file exists.\n", path.c_str());
+                return -1;
+            }
+            struct stat file_stat;
+            if (fstat(fd, &file_stat) != 0)
+            {
+                mprintfE("Failed to get the size of %s!\n", path.c_str());
+                ::close(fd);
+                return -1;
+            }
+            size_t file_size = static_cast<size_t>(file_stat.st_size);
+            if (file_size > 0)   //空文件无法映射，直接当作没有内容
+            {
+                void* data = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data == MAP_FAILED)
+                {
+                    mprintfE("Failed to map %s!\n", path.c_str());
+                    ::close(fd);
+                    return -1;
+                }
+                this->map_data_ = static_cast<const char*>(data);
+                this->map_size_ = file_size;
+            }
+            ::close(fd);
 
-                        std::string key = line.substr(key_info.key_pos, key_info.key_len);
+            this->file_path_ = std::move(path);
+            this->sep_ = key_value_sep;
+            this->note_signs_ = std::move(note_signs);
+            this->opened_ = true;
+            this->read_only_ = true;
+            this->indexContents(file_size);
+            this->applyBinds();
+            return 0;
+#endif
+        }
 
-                        if (this->key_map_.find(now_section) != this->key_map_.end() && this->key_map_[now_section].find(key) != this->key_map_[now_section].end())
-                        {
-                            mprintfW("Duplicate key:%s in section:%s at line:%d!\n", key.c_str(), now_section.c_str(), line_id + 1);
-                            continue;
-                        }
-                        key_info.line = --this->content_list_.end();
-                        this->key_map_[now_section][key] = key_info;
+        //在textData()的前size字节上切分各行，并建立section和key的索引
+        _MINE_INLINE void IniFile::indexContents(size_t size)
+        {
+            const char* data = this->textData();
+            size_t pos = 0;
+            if (size >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+            {
+                mprintfI("Process the file:%s with UTF-8 BOM encoding\n", this->file_path_.c_str());
+                this->bom_ = true;
+                pos = 3;
+            }
+            while (true)   //按行切分，并去掉行尾的\r和空白字符
+            {
+                const char* line_end = static_cast<const char*>(memchr(data + pos, '\n', size - pos));
+                size_t end = line_end != nullptr ? line_end - data : size;
+                mstr::StrView line = mstr::rtrimView(mstr::StrView(data + pos, end - pos));
+                this->lines_.push_back({ pos, line.size(), this->lines_.size() + 1 });
+                if (end == size)
+                    break;
+                pos = end + 1;
+            }
+            while (!this->lines_.empty() && this->lines_.back().len == 0)
+                this->lines_.pop_back();
+            if (!this->lines_.empty())
+            {
+                this->lines_.back().next = -1;
+                this->first_line_ = 0;
+                this->last_line_ = this->lines_.size() - 1;
+            }
+            //按行数预留哈希表，读取过程中不再重建
+            size_t table_size = 64;
+            while (table_size < this->lines_.size() * 2)
+                table_size *= 2;
+            this->key_table_.assign(table_size, -1);
+            this->keys_.reserve(this->lines_.size());
+
+            size_t now_section = -1;
+            for (size_t line_id = 0; line_id < this->lines_.size(); ++line_id)
+            {
+                mstr::StrView line = this->stripNote(this->lineView(line_id));
+                if (line.empty())
+                    continue;
+                size_t name_pos, name_len;
+                if (this->searchSection(line, name_pos, name_len))
+                {
+                    mstr::StrView name = line.substr(name_pos, name_len);
+                    now_section = this->findSection(name);
+                    if (now_section != size_t(-1))
+                    {
+                        mprintfWLimited("Duplicate section:%s at line:%d!\n", name.str().c_str(), (int)line_id + 1);
                         continue;
                     }
+                    now_section = this->addSection(this->lines_[line_id].pos + name_pos, name_len, line_id);
+                    continue;
                 }
-                while (true)
+
+                KeyInfo key_info;
+                if (this->searchKey(line, key_info))
                 {
-                    if (this->content_list_.back().empty())
-                        this->content_list_.pop_back();
-                    else break;
+                    if (now_section == size_t(-1))
+                    {
+                        now_section = this->findSection("");
+                        if (now_section == size_t(-1))
+                            now_section = this->addSection(0, 0, -1);
+                    }
+                    this->sections_[now_section].last = line_id;
+                    key_info.section = now_section;
+                    key_info.hash = mfile::_hashIniName(line.substr(key_info.key_pos, key_info.key_len), now_section + 1);
+                    key_info.line = line_id;
+                    key_info.cache = 0;
+                    key_info.cache_type = nullptr;
+                    if (!this->addKey(key_info))
+                    {
+                        mprintfWLimited("Duplicate key:%s in section:%s at line:%d!\n", line.substr(key_info.key_pos, key_info.key_len).str().c_str(),
+                            this->sectionName(now_section).str().c_str(), (int)line_id + 1);
+                    }
                 }
-                return 0;
             }
         }
 
         //关闭并保存
-        inline int IniFile::close()
+        _MINE_INLINE int IniFile::close()
         {
-            if (this->rwstatus_ == 'w' && this->file_.is_open())
+            if (this->opened_ && this->modified_)
             {
                 if (this->saveContents() != 0)
                     return -1;
             }
-            this->content_list_.clear();
-            this->section_map_.clear();
-            this->key_map_.clear();
-            this->file_.close();
-            this->rwstatus_ = 'r';
-            this->file_.clear();
+#if !defined(_WIN32)
+            if (this->map_data_ != nullptr)
+                munmap(const_cast<char*>(this->map_data_), this->map_size_);
+#endif
+            this->map_data_ = nullptr;
+            this->map_size_ = 0;
+            this->opened_ = false;
+            this->modified_ = false;
+            this->bom_ = false;
+            this->read_only_ = false;
+            this->arena_.clear();
+            this->lines_.clear();
+            this->first_line_ = -1;
+            this->last_line_ = -1;
+            this->sections_.clear();
+            this->keys_.clear();
+            this->section_table_.clear();
+            this->key_table_.clear();
             return 0;
         }
 
-        inline std::string IniFile::getValue(const std::string& section, const std::string& key)
+        _MINE_INLINE std::string IniFile::getValue(mstr::StrView section, mstr::StrView key)
+        {
+            return this->getValueView(section, key).str();
+        }
+
+        _MINE_INLINE std::string IniFile::getValue(mstr::StrView key)
         {
-            if (!this->file_.is_open())
+            return this->getValueView("", key).str();
+        }
+
+        _MINE_INLINE mstr::StrView IniFile::getValueView(mstr::StrView section, mstr::StrView key)
+        {
+            if (!this->opened_)
             {
                 mprintfE("File not opened!\n");
-                return "";
+                return mstr::StrView();
             }
-            if (this->key_map_.find(section) == this->key_map_.end())
+            size_t section_id = this->findSection(section);
+            if (section_id == size_t(-1))
             {
-                mprintfW("The section:%s is not exist! Please check it.\n", section.c_str());
-                return "";
+                mprintfWLimited("The section:%s is not exist! Please check it.\n", section.str().c_str());
+                return mstr::StrView();
             }
-            if (this->key_map_[section].find(key) == this->key_map_[section].end())
+            size_t key_id = this->findKey(section_id, key);
+            if (key_id == size_t(-1))
             {
-                mprintfW("The key:%s is not exist! Please check it.\n", key.c_str());
-                return "";
+                mprintfWLimited("The key:%s is not exist! Please check it.\n", key.str().c_str());
+                return mstr::StrView();
             }
-            KeyInfo& key_info = this->key_map_[section][key];
-            //std::string& line = *key_info.line;
-            return (*key_info.line).substr(key_info.value_pos, key_info.value_len);
+            const KeyInfo& key_info = this->keys_[key_id];
+            return this->lineView(key_info.line).substr(key_info.value_pos, key_info.value_len);
         }
 
-        inline std::string IniFile::getValue(const std::string& key)
+        _MINE_INLINE mstr::StrView IniFile::getValueView(mstr::StrView key)
         {
-            return this->getValue("", key);
+            return this->getValueView("", key);
+        }
+
+        _MINE_INLINE bool IniFile::hasKey(mstr::StrView section, mstr::StrView key)
+        {
+            size_t section_id = this->findSection(section);
+            return section_id != size_t(-1) && this->findKey(section_id, key) != size_t(-1);
+        }
+
+        _MINE_INLINE bool IniFile::isModified() const
+        {
+            return this->modified_;
+        }
+
+        _MINE_INLINE std::string IniFile::getAs(mstr::StrView section, mstr::StrView key, const char* default_value)
+        {
+            return this->getAs<std::string>(section, key, default_value ? default_value : "");
+        }
+
+        _MINE_INLINE void IniFile::unbindAll()
+        {
+            this->binds_.clear();
+        }
+#endif
+
+        template<class T>
+        inline T IniFile::getAs(mstr::StrView section, mstr::StrView key, const T& default_value)
+        {
+            static_assert((std::is_arithmetic<T>::value && sizeof(T) <= sizeof(uint64_t)) || std::is_same<T, std::string>::value,
+                "IniFile::getAs only supports bool, integers and floating point numbers no larger than 8 bytes, and std::string!");
+            return this->getAsValue(section, key, default_value, std::is_arithmetic<T>());
+        }
+
+        template<class T>
+        inline T IniFile::getAsValue(mstr::StrView section, mstr::StrView key, const T& default_value, std::true_type)
+        {
+            size_t key_id = this->locateKey(section, key);
+            if (key_id == size_t(-1))
+                return default_value;
+            KeyInfo& key_info = this->keys_[key_id];
+            T value;
+            if (key_info.cache_type == mfile::_iniTypeTag<T>())
+            {
+                memcpy(&value, &key_info.cache, sizeof(T));
+                return value;
+            }
+            if (mstr::_parseTypedNumber(this->valueView(key_id), value) != 0)
+            {
+                mprintfWLimited("Failed to convert the value of key:%s!\n", key.str().c_str());
+                return default_value;
+            }
+            memcpy(&key_info.cache, &value, sizeof(T));
+            key_info.cache_type = mfile::_iniTypeTag<T>();
+            return value;
+        }
+
+        template<class T>
+        inline T IniFile::getAsValue(mstr::StrView section, mstr::StrView key, const T& default_value, std::false_type)
+        {
+            size_t key_id = this->locateKey(section, key);
+            if (key_id == size_t(-1))
+                return default_value;
+            return this->valueView(key_id).str();
+        }
+
+        template<class T>
+        inline int IniFile::bind(mstr::StrView section, mstr::StrView key, T& value)
+        {
+            static_assert(std::is_arithmetic<T>::value || std::is_same<T, std::string>::value,
+                "IniFile::bind only supports bool, integers, floating point numbers and std::string!");
+            BindInfo bind_info;
+            bind_info.section = section.str();
+            bind_info.key = key.str();
+            bind_info.target = &value;
+            bind_info.assign = mfile::_assignIniTarget<T>;
+            this->binds_.push_back(std::move(bind_info));
+            return this->opened_ ? this->applyBind(this->binds_.back()) : 1;
         }
 
         template<class T, typename std::enable_if<mtype::StdCoutEachChecker<T>::value, int>::type>
-        inline void IniFile::setValue(const std::string& section, const std::string& key, const T& value)
+        inline void IniFile::setValue(mstr::StrView section, mstr::StrView key, const T& value)
+        {
+            this->setValueText(section, key, mstr::toStr(value));
+        }
+
+        template<class T, typename std::enable_if<mtype::StdCoutEachChecker<T>::value, int>::type>
+        inline void IniFile::setValue(mstr::StrView key, const T& value)
+        {
+            this->setValueText("", key, mstr::toStr(value));
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE void IniFile::printContents()
+        {
+            printf("IniFile %s:\n", this->file_path_.c_str());
+            for (size_t line_id = this->first_line_; line_id != size_t(-1); line_id = this->lines_[line_id].next)
+            {
+                mstr::StrView line = this->lineView(line_id);
+                printf("    %.*s\n", (int)line.size(), line.data());
+            }
+            printf("\n");
+        }
+
+        _MINE_INLINE IniFile::~IniFile()
+        {
+            this->close();
+        }
+
+        _MINE_INLINE const char* IniFile::textData() const
+        {
+            return this->map_data_ != nullptr ? this->map_data_ : this->arena_.data();
+        }
+
+        _MINE_INLINE mstr::StrView IniFile::lineView(size_t line_id) const
+        {
+            return mstr::StrView(this->textData() + this->lines_[line_id].pos, this->lines_[line_id].len);
+        }
+
+        _MINE_INLINE mstr::StrView IniFile::sectionName(size_t section_id) const
+        {
+            return mstr::StrView(this->textData() + this->sections_[section_id].name_pos, this->sections_[section_id].name_len);
+        }
+
+        _MINE_INLINE mstr::StrView IniFile::keyName(size_t key_id) const
+        {
+            const KeyInfo& key_info = this->keys_[key_id];
+            return mstr::StrView(this->textData() + this->lines_[key_info.line].pos + key_info.key_pos, key_info.key_len);
+        }
+
+        _MINE_INLINE mstr::StrView IniFile::valueView(size_t key_id) const
+        {
+            const KeyInfo& key_info = this->keys_[key_id];
+            return mstr::StrView(this->textData() + this->lines_[key_info.line].pos + key_info.value_pos, key_info.value_len);
+        }
+
+        //查找section下的key，不存在时返回-1且不打印警告
+        _MINE_INLINE size_t IniFile::locateKey(mstr::StrView section, mstr::StrView key) const
+        {
+            size_t section_id = this->findSection(section);
+            return section_id == size_t(-1) ? size_t(-1) : this->findKey(section_id, key);
+        }
+
+        _MINE_INLINE int IniFile::applyBind(const BindInfo& bind_info)
+        {
+            size_t key_id = this->locateKey(bind_info.section, bind_info.key);
+            if (key_id == size_t(-1))
+                return 1;
+            if (bind_info.assign(this->valueView(key_id), bind_info.target) != 0)
+            {
+                mprintfWLimited("Failed to convert the value of key:%s in section:%s!\n", bind_info.key.c_str(), bind_info.section.c_str());
+                return -1;
+            }
+            return 0;
+        }
+
+        _MINE_INLINE void IniFile::applyBinds()
+        {
+            for (const BindInfo& bind_info : this->binds_)
+                this->applyBind(bind_info);
+        }
+
+        _MINE_INLINE size_t IniFile::findSection(mstr::StrView section) const
+        {
+            if (this->section_table_.empty())
+                return -1;
+            const size_t mask = this->section_table_.size() - 1;
+            const size_t hash = mfile::_hashIniName(section, 0);
+            for (size_t i = hash & mask;; i = (i + 1) & mask)
+            {
+                size_t section_id = this->section_table_[i];
+                if (section_id == size_t(-1) || (this->sections_[section_id].hash == hash && this->sectionName(section_id) == section))
+                    return section_id;
+            }
+        }
+
+        _MINE_INLINE size_t IniFile::findKey(size_t section_id, mstr::StrView key) const
+        {
+            if (this->key_table_.empty())
+                return -1;
+            const size_t mask = this->key_table_.size() - 1;
+            const size_t hash = mfile::_hashIniName(key, section_id + 1);
+            for (size_t i = hash & mask;; i = (i + 1) & mask)
+            {
+                size_t key_id = this->key_table_[i];
+                if (key_id == size_t(-1) || (this->keys_[key_id].hash == hash && this->keys_[key_id].section == section_id && this->keyName(key_id) == key))
+                    return key_id;
+            }
+        }
+
+        //负载超过一半时表扩大一倍并重建
+        _MINE_INLINE size_t IniFile::addSection(size_t name_pos, size_t name_len, size_t line_id)
+        {
+            size_t section_id = this->sections_.size();
+            size_t hash = mfile::_hashIniName(mstr::StrView(this->textData() + name_pos, name_len), 0);
+            this->sections_.push_back({ name_pos, name_len, hash, line_id, line_id });
+            if (this->sections_.size() * 2 > this->section_table_.size())
+            {
+                this->section_table_.assign(std::max<size_t>(16, this->section_table_.size() * 2), -1);
+                for (size_t i = 0; i < this->sections_.size(); ++i)
+                    mfile::_insertIniIndex(this->section_table_, this->sections_[i].hash, i);
+            }
+            else mfile::_insertIniIndex(this->section_table_, hash, section_id);
+            return section_id;
+        }
+
+        //查找和插入在同一次探测中完成，section中已有同名key时不添加并返回false
+        _MINE_INLINE bool IniFile::addKey(const KeyInfo& key_info)
+        {
+            if ((this->keys_.size() + 1) * 2 > this->key_table_.size())
+            {
+                this->key_table_.assign(std::max<size_t>(64, this->key_table_.size() * 2), -1);
+                for (size_t i = 0; i < this->keys_.size(); ++i)
+                    mfile::_insertIniIndex(this->key_table_, this->keys_[i].hash, i);
+            }
+            mstr::StrView key(this->textData() + this->lines_[key_info.line].pos + key_info.key_pos, key_info.key_len);
+            const size_t mask = this->key_table_.size() - 1;
+            size_t i = key_info.hash & mask;
+            for (; this->key_table_[i] != size_t(-1); i = (i + 1) & mask)
+            {
+                size_t key_id = this->key_table_[i];
+                if (this->keys_[key_id].hash == key_info.hash && this->keys_[key_id].section == key_info.section && this->keyName(key_id) == key)
+                    return false;
+            }
+            this->key_table_[i] = this->keys_.size();
+            this->keys_.push_back(key_info);
+            return true;
+        }
+
+        //将text追加到arena_并作为新行插入到prev_line_id之后，prev_line_id为-1时插入到文件开头
+        _MINE_INLINE size_t IniFile::insertLine(mstr::StrView text, size_t prev_line_id)
+        {
+            size_t line_id = this->lines_.size();
+            size_t next = prev_line_id == size_t(-1) ? this->first_line_ : this->lines_[prev_line_id].next;
+            this->lines_.push_back({ this->arena_.size(), text.size(), next });
+            this->arena_.append(text.data(), text.size());
+            if (prev_line_id == size_t(-1))
+                this->first_line_ = line_id;
+            else this->lines_[prev_line_id].next = line_id;
+            if (next == size_t(-1))
+                this->last_line_ = line_id;
+            return line_id;
+        }
+
+        _MINE_INLINE void IniFile::setValueText(mstr::StrView section, mstr::StrView key, mstr::StrView value)
         {
-            if (!this->file_.is_open())
+            if (!this->opened_)
             {
                 mprintfE("File not opened!\n");
                 return;
             }
-            this->rwstatus_ = 'w';
-            if (this->key_map_.find(section) == this->key_map_.end())
+            if (this->read_only_)
+            {
+                mprintfE("File %s is opened read-only!\n", this->file_path_.c_str());
+                return;
+            }
+            size_t section_id = this->findSection(section);
+            if (section_id == size_t(-1))
             {
                 if (section.empty())
-                {
-                    std::string value_str = mstr::toStr(value);
-                    this->content_list_.emplace_back(key + this->sep_ + value_str);
-                    this->section_map_[section].last = --this->content_list_.end();
-
-                    this->key_map_[section][key].line = --this->content_list_.end();
-                    this->key_map_[section][key].key_pos = 0;
-                    this->key_map_[section][key].key_len = key.size();
-                    this->key_map_[section][key].value_pos = key.size() + 1;
-                    this->key_map_[section][key].value_len = value_str.size();
-                }
+                    section_id = this->addSection(0, 0, -1);
                 else
                 {
-                    this->content_list_.emplace_back("[" + section + "]");
-                    this->section_map_[section].line = --this->content_list_.end();
-                    this->section_map_[section].last = --this->content_list_.end();
-                    this->section_map_[section].pos = 1;
-                    this->section_map_[section].len = section.size();
-                    this->key_map_[section] = { };
-                    this->setValue(section, key, value);
+                    size_t line_id = this->insertLine("[" + section.str() + "]", this->last_line_);
+                    section_id = this->addSection(this->lines_[line_id].pos + 1, section.size(), line_id);
                 }
             }
+
+            size_t key_id = this->findKey(section_id, key);
+            if (key_id != size_t(-1))
+            {
+                //只替换value部分，保留行内的空白和注释
+                KeyInfo& key_info = this->keys_[key_id];
+                LineInfo& line_info = this->lines_[key_info.line];
+                if (this->lineView(key_info.line).substr(key_info.value_pos, key_info.value_len) == value)
+                    return;
+                size_t suffix_pos = key_info.value_pos + key_info.value_len;
+                size_t new_pos = this->arena_.size();
+                this->arena_.reserve(new_pos + line_info.len - key_info.value_len + value.size());
+                const char* line_data = this->arena_.data() + line_info.pos;
+                this->arena_.append(line_data, key_info.value_pos);
+                this->arena_.append(value.data(), value.size());
+                this->arena_.append(line_data + suffix_pos, line_info.len - suffix_pos);
+                line_info.pos = new_pos;
+                line_info.len = this->arena_.size() - new_pos;
+                key_info.value_len = value.size();
+                key_info.cache_type = nullptr;
+            }
             else
             {
-                if (this->key_map_[section].find(key) == this->key_map_[section].end())
-                {
-                    std::string value_str = mstr::toStr(value);
-                    auto bak = this->section_map_[section].last;
-                    this->key_map_[section][key].line = this->content_list_.emplace(++this->section_map_[section].last, key + this->sep_ + value_str);
-                    this->section_map_[section].last = ++bak;
-                    this->key_map_[section][key].key_pos = 0;
-                    this->key_map_[section][key].key_len = key.size();
-                    this->key_map_[section][key].value_pos = key.size() + 1;
-                    this->key_map_[section][key].value_len = value_str.size();
-                }
-                else
-                {
-                    std::string value_str = mstr::toStr(value);
-                    *this->key_map_[section][key].line = key + this->sep_ + value_str;
-                    this->key_map_[section][key].value_len = value_str.size();
-                }
+                std::string line = key.str();
+                line.push_back(this->sep_);
+                line.append(value.data(), value.size());
+                SectionInfo& section_info = this->sections_[section_id];
+                section_info.last = this->insertLine(line, section_info.last);
+                this->addKey({ section_id, mfile::_hashIniName(key, section_id + 1), section_info.last, 0, key.size(), key.size() + 1, value.size(), 0, nullptr });
             }
+            this->modified_ = true;
         }
 
-        inline void IniFile::printContents()
+        //去掉行中第一个注释标记及之后的内容
+        _MINE_INLINE mstr::StrView IniFile::stripNote(mstr::StrView line) const
         {
-            printf("IniFile %s:\n", this->file_path_.c_str());
-            for (auto& line : this->content_list_)
+            size_t note_pos = line.size();
+            for (const std::string& note_sign : this->note_signs_)
             {
-                printf("    %s\n", line.c_str());
+                size_t tmp_pos = note_sign.size() == 1 ? line.find(note_sign[0]) : line.find(note_sign);
+                if (tmp_pos < note_pos)
+                    note_pos = tmp_pos;
             }
-            printf("\n");
+            return line.substr(0, note_pos);
         }
 
-        template<class T, typename std::enable_if<mtype::StdCoutEachChecker<T>::value, int>::type>
-        inline void IniFile::setValue(const std::string& key, const T& value)
+        //content为去掉注释后的行，返回的位置相对于行首
+        _MINE_INLINE bool IniFile::searchSection(mstr::StrView content, size_t& name_pos, size_t& name_len) const
+        {
+            mstr::StrView section = mstr::trimView(content);
+            if (section.size() < 3 || section[0] != '[' || section[section.size() - 1] != ']')
+                return false;
+            mstr::StrView name = mstr::trimView(section.substr(1, section.size() - 2));
+            if (name.empty())
+                return false;
+            name_pos = name.data() - content.data();
+            name_len = name.size();
+            return true;
+        }
+
+        _MINE_INLINE bool IniFile::searchKey(mstr::StrView content, KeyInfo& key_info) const
+        {
+            size_t sep_pos = content.find(this->sep_);
+            if (sep_pos == std::string::npos)
+                return false;
+
+            //key取分隔符前的最后一段非空白字符
+            mstr::StrView key = mstr::rtrimView(content.substr(0, sep_pos));
+            size_t key_begin = key.size();
+            while (key_begin > 0 && strchr(" \t\n\r\f\v", key[key_begin - 1]) == nullptr)
+                key_begin--;
+            mstr::StrView value = mstr::trimView(content.substr(sep_pos + 1));
+            if (key_begin == key.size() || value.empty())
+                return false;
+            key_info.key_pos = key_begin;
+            key_info.key_len = key.size() - key_begin;
+            key_info.value_pos = value.data() - content.data();
+            key_info.value_len = value.size();
+            return true;
+        }
+
+        //按文件中的顺序拼接各行，一次写入
+        _MINE_INLINE int IniFile::saveContents()
+        {
+            std::string content;
+            content.reserve(this->arena_.size() + this->lines_.size());
+            if (this->bom_)
+                content.append("\xEF\xBB\xBF");
+            for (size_t line_id = this->first_line_; line_id != size_t(-1); line_id = this->lines_[line_id].next)
+            {
+                content.append(this->arena_, this->lines_[line_id].pos, this->lines_[line_id].len);
+                if (this->lines_[line_id].next != size_t(-1))
+                    content.push_back('\n');
+            }
+            FILE* file = fopen(this->file_path_.c_str(), "wb");
+            if (file == nullptr)
+            {
+                mprintfE("Open %s failed!\n", this->file_path_.c_str());
+                return -1;
+            }
+            bool ok = fwrite(content.data(), 1, content.size(), file) == content.size();
+            ok = (fclose(file) == 0) && ok;
+            if (!ok)
+            {
+                mprintfE("Write %s failed!\n", this->file_path_.c_str());
+                return -1;
+            }
+            this->modified_ = false;
+            return 0;
+        }
+#else
+        size_t _hashIniName(mstr::StrView name, size_t seed);
+        void _insertIniIndex(std::vector<size_t>& table, size_t hash, size_t id);
+#endif
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE int CsvReader::open(const std::string& path, char sep, size_t buffer_size)
+        {
+            if (this->file_ != nullptr)
+            {
+                mprintfWLimited("Duplicated open!\n");
+                return 1;
+            }
+            this->file_ = fopen(path.c_str(), "rb");
+            if (this->file_ == nullptr)
+            {
+                mprintfE("Failed to open %s! Please check if the file exists.\n", path.c_str());
+                return -1;
+            }
+            this->buf_.resize(std::max(buffer_size, (size_t)64));
+            this->begin_ = this->end_ = 0;
+            this->eof_ = false;
+            this->sep_ = sep;
+            this->next_line_number_ = 1;
+            this->line_number_ = 0;
+            if (this->fillBuffer() != 0)
+            {
+                this->close();
+                return -1;
+            }
+            if (this->end_ >= 3 && memcmp(this->buf_.data(), "\xEF\xBB\xBF", 3) == 0)
+                this->begin_ = 3;
+            return 0;
+        }
+
+        _MINE_INLINE void CsvReader::close()
+        {
+            if (this->file_ != nullptr)
+                fclose(this->file_);
+            this->file_ = nullptr;
+            std::vector<char>().swap(this->buf_);
+            this->begin_ = this->end_ = 0;
+            this->eof_ = false;
+        }
+
+        _MINE_INLINE bool CsvReader::isOpened() const
         {
-            this->setValue("", key, value);
+            return this->file_ != nullptr;
+        }
+
+        _MINE_INLINE int CsvReader::readRow(std::vector<mstr::StrView>& fields)
+        {
+            fields.clear();
+            if (this->file_ == nullptr)
+            {
+                mprintfE("File not opened!\n");
+                return -1;
+            }
+            size_t row_end, newline_count;
+            while (!this->findRowEnd(row_end, newline_count))
+            {
+                if (this->eof_)
+                {
+                    if (this->begin_ == this->end_)
+                        return 0;
+                    row_end = this->end_;   //最后一行没有换行符，或引号未闭合
+                    break;
+                }
+                if (this->fillBuffer() != 0)
+                    return -1;
+            }
+            this->splitRow(row_end, fields);
+            this->line_number_ = this->next_line_number_;
+            this->next_line_number_ += newline_count + 1;
+            this->begin_ = row_end < this->end_ ? row_end + 1 : this->end_;
+            return 1;
         }
 
-        inline IniFile::~IniFile()
+        _MINE_INLINE size_t CsvReader::lineNumber() const
+        {
+            return this->line_number_;
+        }
+
+        _MINE_INLINE CsvReader::~CsvReader()
         {
             this->close();
         }
 
-        inline bool IniFile::searchSection(const std::string& line, SectionInfo& section_info, size_t offset)
+        //把未处理的数据移到缓冲区开头再读入新数据，缓冲区已满时扩大为2倍
+        _MINE_INLINE int CsvReader::fillBuffer()
         {
-            //找到注释的位置
-            size_t note_pos = line.size();
-            for (std::string& note_sign : this->note_signs_)
+            if (this->begin_ > 0)
             {
-                size_t tmp_pos = line.find(note_sign);
-                if (tmp_pos < note_pos)
-                    note_pos = tmp_pos;
+                memmove(this->buf_.data(), this->buf_.data() + this->begin_, this->end_ - this->begin_);
+                this->end_ -= this->begin_;
+                this->begin_ = 0;
             }
-            //std::isblank
-            size_t pos0 = line.find_first_not_of(" \t\n\r\f\v", offset);
-            if (pos0 >= note_pos || line[pos0] != '[')
-                return false;
-            size_t pos1 = line.find_last_not_of(" \t\n\r\f\v", note_pos - 1);
-            if (pos1 >= note_pos || line[pos1] != ']')
-                return false;
-            if (pos1 <= pos0 + 1)
-                return false;
+            if (this->end_ == this->buf_.size())
+                this->buf_.resize(this->buf_.size() * 2);
+            const size_t read_len = fread(this->buf_.data() + this->end_, 1, this->buf_.size() - this->end_, this->file_);
+            this->end_ += read_len;
+            if (read_len == 0)
+            {
+                if (ferror(this->file_))
+                {
+                    mprintfE("Failed to read the file!\n");
+                    return -1;
+                }
+                this->eof_ = true;
+            }
+            return 0;
+        }
 
-            size_t sec_pos0 = line.find_first_not_of(" \t\n\r\f\v", pos0 + 1);
-            size_t sec_pos1 = line.find_last_not_of(" \t\n\r\f\v", pos1 - 1);
+        /*  查找从begin_开始的一行的结尾，即不在引号内的第一个'\n'
+            - 不含引号的行直接按'\n'查找，含引号时逐字段处理
+            - 缓冲区中的数据不足一行时返回false，newline_count为引号内换行的个数   */
+        _MINE_INLINE bool CsvReader::findRowEnd(size_t& row_end, size_t& newline_count) const
+        {
+            const char* data = this->buf_.data();
+            size_t pos = this->begin_;
+            newline_count = 0;
+            const size_t newline_pos = pos + mstr::_scanBytes<0>(data + pos, this->end_ - pos, '\n');
+            if (mstr::_scanBytes<0>(data + pos, newline_pos - pos, '"') == newline_pos - pos)
+            {
+                row_end = newline_pos;
+                return newline_pos != this->end_;
+            }
 
-            if (sec_pos1 >= sec_pos0)
+            bool at_field_start = true;
+            while (pos < this->end_)
             {
-                std::string value = line.substr(sec_pos0, sec_pos1 - sec_pos0 + 1);
-                section_info.pos = sec_pos0;
-                section_info.len = sec_pos1 - sec_pos0 + 1;
-                return true;
+                if (at_field_start && data[pos] == '"')
+                {
+                    pos++;
+                    while (true)
+                    {
+                        const size_t quote_pos = pos + mstr::_scanBytes<0>(data + pos, this->end_ - pos, '"');
+                        newline_count += std::count(data + pos, data + quote_pos, '\n');
+                        if (quote_pos == this->end_ || (quote_pos + 1 == this->end_ && !this->eof_))
+                            return false;   //无法确定引号是否闭合，需要更多数据
+                        pos = quote_pos + 1;
+                        if (pos < this->end_ && data[pos] == '"')
+                            pos++;   //转义的""
+                        else break;
+                    }
+                    at_field_start = false;
+                    continue;
+                }
+                if (data[pos] == '\n')
+                {
+                    row_end = pos;
+                    return true;
+                }
+                at_field_start = data[pos] == this->sep_;
+                pos++;
             }
-            else return false;
+            return false;
         }
 
-        inline bool IniFile::searchKey(const std::string& line, KeyInfo& key_info, size_t offset)
+        //将[begin_, row_end)分割为字段，带引号的字段原地去掉引号并还原转义
+        _MINE_INLINE void CsvReader::splitRow(size_t row_end, std::vector<mstr::StrView>& fields)
         {
-            //找到注释的位置
-            size_t note_pos = line.size();
-            for (std::string& note_sign : this->note_signs_)
+            char* data = this->buf_.data();
+            size_t stop = row_end;
+            if (stop > this->begin_ && data[stop - 1] == '\r')
+                stop--;
+            if (stop == this->begin_)
+                return;
+
+            size_t pos = this->begin_;
+            while (true)
             {
-                size_t tmp_pos = line.find(note_sign);
-                if (tmp_pos < note_pos)
-                    note_pos = tmp_pos;
+                if (pos < stop && data[pos] == '"')
+                {
+                    const size_t field_begin = pos;
+                    size_t out = pos;
+                    pos++;
+                    while (pos < stop)
+                    {
+                        const size_t quote_pos = pos + mstr::_scanBytes<0>(data + pos, stop - pos, '"');
+                        memmove(data + out, data + pos, quote_pos - pos);
+                        out += quote_pos - pos;
+                        pos = quote_pos;
+                        if (pos == stop)
+                            break;
+                        if (pos + 1 < stop && data[pos + 1] == '"')
+                        {
+                            data[out++] = '"';
+                            pos += 2;
+                            continue;
+                        }
+                        pos++;
+                        while (pos < stop && data[pos] != this->sep_)   //闭合引号之后到分隔符之前的内容原样保留
+                            data[out++] = data[pos++];
+                        break;
+                    }
+                    fields.emplace_back(data + field_begin, out - field_begin);
+                }
+                else
+                {
+                    const size_t sep_pos = pos + mstr::_scanBytes<0>(data + pos, stop - pos, this->sep_);
+                    fields.emplace_back(data + pos, sep_pos - pos);
+                    pos = sep_pos;
+                }
+                if (pos >= stop)
+                    break;
+                pos++;
+                if (pos == stop)
+                {
+                    fields.emplace_back(data + pos, 0);   //以分隔符结尾时最后一个字段为空
+                    break;
+                }
             }
+        }
 
-            size_t sep_pos = line.find(this->sep_);
-            if (sep_pos >= note_pos)
-                return false;
+        _MINE_INLINE int CsvWriter::open(const std::string& path, char sep, bool append, size_t buffer_size)
+        {
+            if (this->file_ != nullptr)
+            {
+                mprintfWLimited("Duplicated open!\n");
+                return 1;
+            }
+            this->file_ = fopen(path.c_str(), append ? "ab" : "wb");
+            if (this->file_ == nullptr)
+            {
+                mprintfE("Failed to open %s!\n", path.c_str());
+                return -1;
+            }
+            setvbuf(this->file_, nullptr, _IONBF, 0);   //已有自己的缓冲区，避免再复制一次
+            this->capacity_ = std::max(buffer_size, (size_t)1024);
+            this->buf_.reset(new char[this->capacity_]);
+            this->len_ = 0;
+            this->sep_ = sep;
+            this->row_started_ = false;
+            return 0;
+        }
 
-            std::string key = line.substr(offset, sep_pos);
-            std::vector<std::string> key_split = mstr::split(key);
-            if (!key_split.empty())
+        _MINE_INLINE int CsvWriter::close()
+        {
+            if (this->file_ == nullptr)
+                return 0;
+            int ret = this->flush();
+            if (fclose(this->file_) != 0)
+                ret = -1;
+            this->file_ = nullptr;
+            this->buf_.reset();
+            this->capacity_ = this->len_ = 0;
+            return ret;
+        }
+
+        _MINE_INLINE bool CsvWriter::isOpened() const
+        {
+            return this->file_ != nullptr;
+        }
+
+        _MINE_INLINE void CsvWriter::setFloatPrecision(int precision)
+        {
+            this->float_precision_ = precision < 0 ? -1 : precision;
+        }
+
+        _MINE_INLINE int CsvWriter::endRow()
+        {
+            char* out = this->reserve(1);
+            if (out == nullptr)
+                return -1;
+            *out = '\n';
+            this->len_++;
+            this->row_started_ = false;
+            return 0;
+        }
+
+        _MINE_INLINE int CsvWriter::flush()
+        {
+            if (this->file_ == nullptr)
             {
-                key_info.key_pos = line.rfind(key_split.back(), sep_pos);
-                key_info.key_len = key_split.back().size();
+                mprintfE("File not opened!\n");
+                return -1;
             }
-            else return false;
+            const size_t len = this->len_;
+            this->len_ = 0;
+            if (len > 0 && fwrite(this->buf_.get(), 1, len, this->file_) != len)
+            {
+                mprintfE("Failed to write the file!\n");
+                return -1;
+            }
+            return 0;
+        }
 
-            size_t v_pos0 = line.find_first_not_of(" \t\n\r\f\v", sep_pos + 1);
-            size_t v_pos1 = line.find_last_not_of(" \t\n\r\f\v", note_pos - 1);
+        _MINE_INLINE CsvWriter::~CsvWriter()
+        {
+            this->close();
+        }
 
-            if (v_pos1 >= v_pos0)
+        //确保缓冲区末尾有n字节可写，空间不足时先写入文件，单个字段超过缓冲区时扩大缓冲区
+        _MINE_INLINE char* CsvWriter::reserve(size_t n)
+        {
+            if (this->capacity_ - this->len_ < n)
             {
-                std::string value = line.substr(v_pos0, v_pos1 - v_pos0 + 1);
-                key_info.value_pos = v_pos0;
-                key_info.value_len = v_pos1 - v_pos0 + 1;
-                return true;
+                if (this->flush() != 0)
+                    return nullptr;
+                if (n > this->capacity_)
+                {
+                    this->capacity_ = std::max(n, this->capacity_ * 2);
+                    this->buf_.reset(new char[this->capacity_]);
+                }
             }
-            else return false;
+            return this->buf_.get() + this->len_;
         }
 
+        _MINE_INLINE int CsvWriter::writeSep()
+        {
+            if (this->file_ == nullptr)
+            {
+                mprintfE("File not opened!\n");
+                return -1;
+            }
+            if (this->row_started_)
+            {
+                char* out = this->reserve(1);
+                if (out == nullptr)
+                    return -1;
+                *out = this->sep_;
+                this->len_++;
+            }
+            this->row_started_ = true;
+            return 0;
+        }
 
-        inline int IniFile::saveContents()
+        //写入字符串字段，包含分隔符、引号或换行时加引号并把'"'转义为""
+        _MINE_INLINE int CsvWriter::writeText(const char* s, size_t len)
         {
-            this->file_.close();
-            this->file_.open(file_path_, std::ios::binary | std::ios::trunc | std::ios::out);
-            if (!this->file_.is_open())
+            if (this->writeSep() != 0)
+                return -1;
+            size_t quote_count = 0;
+            bool need_quote = false;
+            for (size_t i = 0; i < len; i++)
             {
-                mprintfE("Open %s failed!\n", this->file_path_.c_str());
+                const char c = s[i];
+                if (c == this->sep_ || c == '\n' || c == '\r')
+                    need_quote = true;
+                else if (c == '"')
+                    quote_count++;
+            }
+            if (!need_quote && quote_count == 0)
+            {
+                char* out = this->reserve(len);
+                if (out == nullptr)
+                    return -1;
+                memcpy(out, s, len);
+                this->len_ += len;
+                return 0;
+            }
+            char* out = this->reserve(len + quote_count + 2);
+            if (out == nullptr)
                 return -1;
+            *out++ = '"';
+            for (size_t i = 0; i < len; i++)
+            {
+                if (s[i] == '"')
+                    *out++ = '"';
+                *out++ = s[i];
             }
-            size_t i = 0;
-            for (auto& content : this->content_list_)
+            *out++ = '"';
+            this->len_ += len + quote_count + 2;
+            return 0;
+        }
+
+        _MINE_INLINE int CsvWriter::writeRowImpl()
+        {
+            return 0;
+        }
+
+        _MINE_INLINE mstr::StrView _csvStrView(const std::string& s)
+        {
+            return mstr::StrView(s);
+        }
+
+        _MINE_INLINE mstr::StrView _csvStrView(const mstr::StrView& s)
+        {
+            return s;
+        }
+#else
+        mstr::StrView _csvStrView(const std::string& s);
+        mstr::StrView _csvStrView(const mstr::StrView& s);
+#endif
+
+        template<class T>
+        inline mstr::StrView _csvStrView(const T& s)
+        {
+            const typename std::remove_pointer<typename std::decay<T>::type>::type* ptr = s;
+            return ptr == nullptr ? mstr::StrView() : mstr::StrView((const char*)ptr);
+        }
+
+        //字段类别：1为bool、整数和浮点数，2为字符串，3为字符，0为其他类型(转调mstr::toStr)
+        template<class T>
+        struct _CsvFieldKind
+        {
+            typedef std::integral_constant<int,
+                mstr::_FormatArgKind<T>::type::value == 5 ? 2 :
+                mstr::_FormatArgKind<T>::type::value == 2 ? 3 :
+                std::is_arithmetic<T>::value ? 1 : 0> type;
+        };
+
+        template<class T>
+        inline int CsvWriter::writeField(const T& field)
+        {
+            return this->writeFieldImpl(field, typename _CsvFieldKind<T>::type());
+        }
+
+        template<class... Args>
+        inline int CsvWriter::writeRow(const Args&... fields)
+        {
+            if (this->writeRowImpl(fields...) != 0)
+                return -1;
+            return this->endRow();
+        }
+
+        template<class T>
+        inline int CsvWriter::writeFieldImpl(const T& field, std::integral_constant<int, 0>)
+        {
+            const std::string s = mstr::toStr(field);
+            return this->writeText(s.data(), s.size());
+        }
+
+        template<class T>
+        inline int CsvWriter::writeFieldImpl(const T& field, std::integral_constant<int, 1>)
+        {
+            if (this->writeSep() != 0)
+                return -1;
+            const size_t max_len = 512;
+            char* out = this->reserve(max_len);
+            if (out == nullptr)
+                return -1;
+            //与mstr::toStr一致：设置了精度时浮点数相当于std::fixed
+            const bool fixed = std::is_floating_point<T>::value && this->float_precision_ >= 0;
+            const mstr::_FormatPiece piece = { 0, 0, 0, 0, 0, fixed ? this->float_precision_ : -1, ' ', 0, char(fixed ? 'f' : 0) };
+            mstr::_FormatWriter writer = { out, max_len, 0 };
+            mstr::_formatArg(writer, piece, field, typename mstr::_FormatArgKind<T>::type());
+            if (writer.len >= max_len)
             {
-                if (i < this->content_list_.size() - 1)
-                    this->file_ << content << "\n";
-                else this->file_ << content;
-                i++;
+                //long double的定点输出可能超出预留长度，按返回的完整长度重新预留后再写一次
+                const size_t len = writer.len;
+                out = this->reserve(len + 1);
+                if (out == nullptr)
+                    return -1;
+                writer = { out, len + 1, 0 };
+                mstr::_formatArg(writer, piece, field, typename mstr::_FormatArgKind<T>::type());
             }
+            this->len_ += writer.len;
             return 0;
         }
+
+        template<class T>
+        inline int CsvWriter::writeFieldImpl(const T& field, std::integral_constant<int, 2>)
+        {
+            const mstr::StrView s = mfile::_csvStrView(field);
+            return this->writeText(s.data(), s.size());
+        }
+
+        template<class T>
+        inline int CsvWriter::writeFieldImpl(const T& field, std::integral_constant<int, 3>)
+        {
+            const char c = (char)field;
+            return this->writeText(&c, 1);
+        }
+
+        template<class T, class... Args>
+        inline int CsvWriter::writeRowImpl(const T& field, const Args&... fields)
+        {
+            if (this->writeField(field) != 0)
+                return -1;
+            return this->writeRowImpl(fields...);
+        }
     }
 
 
@@ -433,6 +1486,143 @@ namespace mineutils
 
     }
 
+    namespace _mfilecheck
+    {
+        inline std::string _readFileText(const std::string& path)
+        {
+            std::ifstream file(path, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+
+        inline void IniFileTest()
+        {
+            const std::string path = "mineutils_ini_test.ini";
+            const std::string text = "\xEF\xBB\xBF; header\r\nname = demo\r\n[net]\r\nport = 8080  ; listen port\r\nhost=local\r\nport = 1\r\n\r\n[ empty ]\r\n\r\n\r\n";
+            std::ofstream out(path, std::ios::binary);
+            out << text;
+            out.close();
+
+            mfile::IniFile ini;
+            printf("User check! Expect a warning about duplicate key:port:\n");
+            bool ret0 = (ini.open(path) == 0);
+            ret0 = ret0 && (ini.getValue("name") == "demo" && ini.getValue("net", "port") == "8080" && ini.getValue("net", std::string("host")) == "local");
+            ret0 = ret0 && (ini.hasKey("net", "host") && !ini.hasKey("net", "name") && !ini.hasKey("empty", "port") && !ini.hasKey("other", "port"));
+            ini.setValue("net", "port", 8080);
+            ret0 = ret0 && (!ini.isModified() && ini.close() == 0 && _readFileText(path) == text);
+            if (!ret0) mprintfE(R"(Failed when check: IniFile lookups, and close without changes keeps the file untouched)""\n");
+
+            bool ret1 = (ini.open(path) == 0);
+            ini.setValue("net", "port", 9090);
+            ini.setValue("net", "timeout", 1.5);
+            ini.setValue("empty", "flag", true);
+            ini.setValue("new", "id", "a b");
+            ini.setValue("level", 3);
+            ret1 = ret1 && (ini.isModified() && ini.getValue("net", "port") == "9090" && ini.getValue("new", "id") == "a b" && ini.close() == 0);
+            const std::string expected = "\xEF\xBB\xBF; header\nname = demo\nlevel=3\n[net]\nport = 9090  ; listen port\nhost=local\nport = 1\ntimeout=1.5\n\n[ empty ]\nflag=1\n[new]\nid=a b";
+            ret1 = ret1 && (_readFileText(path) == expected);
+            ret1 = ret1 && (ini.open(path) == 0 && ini.getValue("level") == "3" && ini.getValue("net", "timeout") == "1.5" && ini.getValue("empty", "flag") == "1");
+            ini.close();
+            if (!ret1) mprintfE(R"(Failed when check: IniFile::setValue updates values in place and saves in file order)""\n");
+
+            bool ret2 = (ini.openMapped(path) == 0);
+            mstr::StrView port = ini.getValueView("net", "port");
+            ret2 = ret2 && (port == "9090" && ini.getValueView("level") == "3" && ini.hasKey("new", "id") && ini.getValueView("new", "id") == "a b");
+            printf("User check! Expect an error about read-only:\n");
+            ini.setValue("net", "port", 1);
+            ret2 = ret2 && (!ini.isModified() && ini.getValueView("net", "port") == "9090" && ini.close() == 0 && _readFileText(path) == expected);
+            std::ofstream(path, std::ios::binary | std::ios::trunc).close();
+            ret2 = ret2 && (ini.openMapped(path) == 0 && !ini.hasKey("", "level") && ini.close() == 0);
+            if (!ret2) mprintfE(R"(Failed when check: IniFile::openMapped indexes the mapping and rejects setValue)""\n");
+
+            out.open(path, std::ios::binary);
+            out << expected;
+            out.close();
+            int port_value = 0, missing_value = -1;
+            double timeout_value = 0;
+            std::string host_value;
+            bool ret3 = (ini.bind("net", "port", port_value) == 1 && ini.bind("net", "timeout", timeout_value) == 1);
+            ret3 = ret3 && (ini.open(path) == 0 && port_value == 9090 && timeout_value == 1.5);
+            ret3 = ret3 && (ini.bind("net", "host", host_value) == 0 && host_value == "local" && ini.bind("net", "missing", missing_value) == 1 && missing_value == -1);
+            ret3 = ret3 && (ini.getAs("net", "port", 0) == 9090 && ini.getAs("net", "port", 0) == 9090 && ini.getAs("net", "port", 0.0) == 9090.0);
+            ret3 = ret3 && (ini.getAs("net", "missing", 7) == 7 && ini.getAs("", "level", 0u) == 3u && ini.getAs("new", "id", "none") == "a b");
+            ret3 = ret3 && (ini.getAs<uint8_t>("", "level", 0) == 3);
+            ini.setValue("net", "port", 7070);
+            ret3 = ret3 && (ini.getAs("net", "port", 0) == 7070 && port_value == 9090);
+            printf("User check! Expect a warning about converting key:host:\n");
+            ret3 = ret3 && (ini.getAs("net", "host", 5) == 5);
+            ini.unbindAll();
+            ini.close();
+            ret3 = ret3 && (ini.open(path) == 0 && ini.getAs("net", "port", 0) == 7070 && ini.getAs<short>("net", "port", 0) == 7070 && port_value == 9090);
+            ini.close();
+            ::remove(path.c_str());
+            if (!ret3) mprintfE(R"(Failed when check: IniFile::getAs caches typed values and IniFile::bind writes variables on open)""\n");
+        }
+
+        inline void CsvTest()
+        {
+            const std::string path = "mineutils_csv_test.csv";
+            mfile::CsvWriter writer;
+            bool ret0 = (writer.open(path) == 0);
+            ret0 = ret0 && (writer.writeRow("id", "label", "score", std::string("note")) == 0);
+            ret0 = ret0 && (writer.writeRow(1, "person", 0.875, "say \"hi\", bye") == 0);
+            writer.setFloatPrecision(2);
+            ret0 = ret0 && (writer.writeRow(-2, mstr::StrView("two\nlines"), 1.f / 3, ',') == 0);
+            ret0 = ret0 && (writer.writeField(true) == 0 && writer.writeField("") == 0 && writer.writeField(std::vector<int>({ 1, 2 })) == 0 && writer.endRow() == 0);
+            ret0 = ret0 && (writer.close() == 0);
+            std::string content;
+            std::ifstream file(path, std::ios::binary);
+            content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            file.close();
+            const std::string expected = "id,label,score,note\n1,person,0.875,\"say \"\"hi\"\", bye\"\n-2,\"two\nlines\",0.33,\",\"\n1,,\"{1, 2}\"\n";
+            ret0 = ret0 && (content == expected);
+            if (!ret0) mprintfE(R"(Failed when check: CsvWriter output equals the expected CSV text)""\n");
+
+            //追加CRLF行尾、空行、以分隔符结尾且没有换行的行，并用很小的缓冲区读取以覆盖跨块的行
+            std::ofstream out(path, std::ios::binary | std::ios::app);
+            out << "3,\"a\"\"\",x\r\n\r\n4,,";
+            out.close();
+            mfile::CsvReader reader;
+            std::vector<mstr::StrView> fields;
+            std::vector<std::vector<std::string>> rows;
+            std::vector<size_t> line_numbers;
+            bool ret1 = (reader.open(path, ',', 8) == 0);
+            while (ret1 && reader.readRow(fields) > 0)
+            {
+                std::vector<std::string> row;
+                for (mstr::StrView field : fields)
+                    row.push_back(field.str());
+                rows.push_back(row);
+                line_numbers.push_back(reader.lineNumber());
+            }
+            reader.close();
+            ::remove(path.c_str());
+            ret1 = ret1 && (rows == std::vector<std::vector<std::string>>({ { "id", "label", "score", "note" }, { "1", "person", "0.875", "say \"hi\", bye" },
+                { "-2", "two\nlines", "0.33", "," }, { "1", "", "{1, 2}" }, { "3", "a\"", "x" }, { }, { "4", "", "" } }));
+            ret1 = ret1 && (line_numbers == std::vector<size_t>({ 1, 2, 3, 5, 6, 7, 8 }));
+            if (!ret1) mprintfE(R"(Failed when check: CsvReader rows equal the written rows)""\n");
+
+            //定点输出超过预留长度的浮点数不截断，缓冲区小于输出长度时扩容
+            mfile::CsvWriter long_writer;
+            bool ret2 = (long_writer.open(path, ',', false, 64) == 0);
+            long_writer.setFloatPrecision(2);
+            ret2 = ret2 && (long_writer.writeRow(1, LDBL_MAX, -DBL_MAX) == 0 && long_writer.close() == 0);
+            std::ifstream long_file(path, std::ios::binary);
+            content.assign(std::istreambuf_iterator<char>(long_file), std::istreambuf_iterator<char>());
+            long_file.close();
+            ::remove(path.c_str());
+            ret2 = ret2 && (content == "1," + mstr::toStr<2>(LDBL_MAX) + "," + mstr::toStr<2>(-DBL_MAX) + "\n" && content.size() > 5000);
+            if (!ret2) mprintfE(R"(Failed when check: CsvWriter writes long floating-point fields without truncation)""\n");
+        }
+
+        inline void check()
+        {
+            printf("\n--------------------check mfile start--------------------\n");
+            IniFileTest();
+            CsvTest();
+            printf("---------------------check mfile end---------------------\n\n");
+        }
+    }
+
 
 
 #endif
@@ -3,20 +3,28 @@
 #ifndef IO_HPP_MINEUTILS
 #define IO_HPP_MINEUTILS
 
+#include<algorithm>
 #include<array>
+#include<atomic>
+#include<chrono>
+#include<condition_variable>
 #include<deque>
+#include<errno.h>
 #include<exception>
 #include<forward_list>
 #include<initializer_list>
 #include<iostream>
 #include<list>
 #include<map>
+#include<memory>
 #include<mutex>
 #include<queue>
 #include<set>
 #include<stack>
 #include<stdio.h>
+#include<string.h>
 #include<string>
+#include<thread>
 #include<unordered_map>
 #include<unordered_set>
 #include<vector>
@@ -24,6 +32,11 @@
 #include<cxxabi.h>
 #endif
 #include<typeinfo>
+#if defined(_MSC_VER)
+#include<io.h>
+#else
+#include<unistd.h>
+#endif
 
 #include"base.hpp"
 #include"type.hpp"
@@ -37,16 +50,125 @@ namespace mineutils
     namespace mio
     {
         /*  实现类似Python的print打印功能，基于std::cout
-            - 基于std::ostringstream实现，可以接收任意数量和类型的参数
+            - 可以接收任意数量和类型的参数，每个参数后接一个空格，最后换行
             - 支持重载了std::ostream& operator<<(std::ostream&, const T&)的T对象
             - 扩展了对非volatile限定的STL容器对象的支持
             - 有无符号的char都会被当作字符处理
             - 宽字符会被当作数字处理
             - 未支持的类型会被转换为<ClassName: Address>形式的字符串
+            - 整行内容先在线程内的缓冲区中格式化，再在锁内一次性写出，多线程打印时各行不会交错
+            - 写出后是否立即刷新由setPrintFlushPolicy决定，默认每行刷新
             - 在不混用print函数和std::cout时，线程安全  */
         template<class T, class... Args>
         void print(const T& arg, const Args&... args);
 
+        //print的刷新策略
+        enum PrintFlushPolicy
+        {
+            flush_by_line = 0,    //每次print后立即写出并刷新
+            flush_by_interval = 1,    //距上次写出超过指定毫秒数时写出并刷新
+            flush_by_size = 2    //缓冲的内容达到指定字节数时写出并刷新
+        };
+
+        /*  设置print的刷新策略，切换前会先写出已缓冲的内容
+            - 非flush_by_line策略下，未达到刷新条件的内容会在之后的print、调用flushPrint或进程正常退出时写出
+            - 非flush_by_line策略下与printf、mprintf系列宏混用时，输出顺序可能与调用顺序不一致
+            @param policy: 刷新策略
+            @param value: flush_by_interval时为间隔毫秒数，flush_by_size时为字节数，flush_by_line时忽略   */
+        void setPrintFlushPolicy(PrintFlushPolicy policy, size_t value = 0);
+
+        //写出print已缓冲的全部内容并刷新std::cout，开启后台写出时会等待后台线程写完
+        void flushPrint();
+
+        /*  开启print的后台写出，开启后print只将格式化好的行追加到共享缓冲区，由后台线程按刷新策略写出到std::cout
+            - 缓冲的内容超过max_pending_bytes时，print会等待后台线程写出后再返回
+            - 刷新策略为flush_by_interval时，即使没有新的print，后台线程也会按间隔写出
+            @param max_pending_bytes: 共享缓冲区允许积压的最大字节数
+            @return 0代表正常，1代表已经开启   */
+        int startAsyncPrint(size_t max_pending_bytes = 4 << 20);
+
+        //停止print的后台写出，写出剩余内容后恢复同步写出；进程正常退出时会自动调用
+        void stopAsyncPrint();
+
+        /*  按print的格式将一行内容写入sink，不经过print的锁和刷新策略
+            - sink支持FILE*、FdSink、std::string、mstr::StringBuilder、std::ostream和PrintRingBuffer
+            - sink为std::ostream时沿用其上设置的格式，其他sink使用默认格式
+            - 整行内容一次写入sink，多线程共用FILE*、FdSink或PrintRingBuffer时各行不会交错，共用其他sink时需自行加锁
+            - 不主动刷新FILE*和std::ostream
+            @return 0代表正常，-1代表写入失败   */
+        template<class Sink, class T, class... Args>
+        int printTo(Sink&& sink, const T& arg, const Args&... args);
+
+        //文件描述符形式的输出目标，不持有也不关闭fd
+        struct FdSink
+        {
+            explicit FdSink(int fd) : fd(fd) {}
+            int fd;
+        };
+
+        /*  保存最近写入内容的环形缓冲区，用于高频调试输出只在出错时再导出的场景
+            - 写满后覆盖最早的内容，最早的一行被覆盖了一部分时，导出的内容从下一行开始
+            - 线程安全   */
+        class PrintRingBuffer
+        {
+        public:
+            explicit PrintRingBuffer(size_t capacity = 1 << 20);
+            PrintRingBuffer(const PrintRingBuffer&) = delete;
+            PrintRingBuffer& operator=(const PrintRingBuffer&) = delete;
+
+            //写入len个字节，超过容量时只保留最后capacity个字节
+            void write(const char* data, size_t len);
+
+            //复制缓冲区中的内容
+            std::string str() const;
+
+            /*  取出缓冲区中的内容并清空缓冲区，再写入fp并刷新，取出和清空在同一次加锁中完成，不会丢失并发写入的行
+                @return 0代表正常，-1代表写入失败   */
+            int dumpTo(FILE* fp);
+
+            void clear();
+            size_t size() const;
+            size_t capacity() const;
+
+        private:
+            std::string contentLocked() const;    //调用方需持有mtx_
+
+            mutable std::mutex mtx_;
+            std::vector<char> buf_;
+            size_t head_;    //下一次写入的位置
+            size_t size_;
+            bool partial_first_line_;    //最早的一行是否已被覆盖了一部分
+        };
+
+        //ScopedPrintCapture记录的输出目标
+        struct _PrintSinkRef
+        {
+            void* obj = nullptr;
+            int fd = -1;
+            int (*write)(const _PrintSinkRef& ref, const char* data, size_t len) = nullptr;
+        };
+
+        /*  在当前线程内捕获print的输出，对象存在期间当前线程的print写入sink而不是std::cout
+            - sink支持的类型同printTo，sink的生命周期需长于本对象
+            - 捕获的输出不经过print的锁和刷新策略，多线程共用同一sink时的要求同printTo
+            - 可以嵌套，析构时恢复之前的输出目标
+            - 在不支持thread_local的编译器(如QNX660的GCC4.7.3)上对所有线程生效   */
+        class ScopedPrintCapture
+        {
+        public:
+            template<class Sink>
+            explicit ScopedPrintCapture(Sink& sink);
+            explicit ScopedPrintCapture(FILE* fp);
+            explicit ScopedPrintCapture(FdSink sink);
+            ~ScopedPrintCapture();
+
+            ScopedPrintCapture(const ScopedPrintCapture&) = delete;
+            ScopedPrintCapture& operator=(const ScopedPrintCapture&) = delete;
+
+        private:
+            _PrintSinkRef prev_;
+        };
+
 
         //qnx的gcc4.7.3对std::array的列表初始化支持不好，因此创建BooleanOption类用于方便地列表初始化
         class BooleanOption
@@ -134,6 +256,117 @@ namespace mineutils
             //获取值选项flag的解析结果值，生命周期为ArgumentParser对象销毁或重新parse之前。注意flag必须带有"-"，即"-a"或"--arg"形式
             _mdeprecated("Deprecated! Please use getValueOpt instead.") const char* getParsedValueOpt(const std::string& flag);
         };
+
+
+        class OptionRegistry;
+        struct _OptionSlot;
+
+        /*  OptionRegistry中一个选项的只读句柄，直接指向解析后的类型化结果
+            - 读取结果只是一次解引用，可以在循环中频繁使用
+            - 生命周期为OptionRegistry对象销毁之前   */
+        template<class T>
+        class OptionHandle
+        {
+        public:
+            OptionHandle();
+
+            //获取选项的值，未在命令行中给出时为默认值
+            const T& get() const;
+            const T& operator*() const;
+            const T* operator->() const;
+
+            //选项是否在命令行中给出
+            bool isSet() const;
+
+            //句柄是否绑定了选项，添加选项失败时返回的句柄未绑定
+            bool valid() const;
+
+        private:
+            friend class OptionRegistry;
+            OptionHandle(const T* value, const bool* is_set);
+
+            const T* value_;
+            const bool* is_set_;
+        };
+
+        /*  类型化的main函数参数解析工具，选项只需声明一次，解析结果直接写入各选项的类型化存储
+            - 先添加选项，再调用parse，通过添加时返回的OptionHandle读取结果
+            - 短标志以单横线 - 起始，接单个字符，如 -s；长标志以双横线 -- 起始，如 --flag
+            - 值选项的值可以写为 -n 5、-n5、--num 5 或 --num=5
+            - 支持短标志合并，值选项之后的字符会被当作它的值，如 -bBv value 或 -bBvvalue
+            - 布尔选项可以写为 --flag=false 等形式显式给出值
+            - 单独的 -- 之后的参数均视为位置参数，未定义的标志会被忽略并给出警告
+            - 数值使用mstr::parse解析，不依赖locale；int8_t和uint8_t按整数处理，不会当作字符
+            - 用例：mio::OptionRegistry options;
+                    auto num = options.addOption<int>("-n", "--num", "number of workers", 4);
+                    auto verbose = options.addFlag("-v", "--verbose", "print more logs");
+                    if (options.parse(argc, argv) != 0) return -1;
+                    for (int i = 0; i < *num; i++) ...   */
+        class OptionRegistry
+        {
+        public:
+            OptionRegistry();
+            ~OptionRegistry();
+
+            //添加布尔选项，给出时值为true
+            OptionHandle<bool> addFlag(const std::string& shortflag, const std::string& longflag, const std::string& description);
+
+            /*  添加值选项，T可以为算术类型或std::string
+                @param default_value: 未给出时的默认值
+                @param required: 是否必须在命令行中给出，必须给出的选项忽略默认值   */
+            template<class T>
+            OptionHandle<T> addOption(const std::string& shortflag, const std::string& longflag, const std::string& description, T default_value = T(), bool required = false);
+
+            //同上，以C字符串给出默认值时按std::string处理
+            OptionHandle<std::string> addOption(const std::string& shortflag, const std::string& longflag, const std::string& description, const char* default_value, bool required = false);
+
+            /*  添加枚举值选项，值必须是choices中的某个名字
+                - 用例：auto mode = options.addEnumOption<Mode>("-m", "--mode", "run mode", { {"fast", Mode::fast}, {"safe", Mode::safe} }, Mode::safe);   */
+            template<class T>
+            OptionHandle<T> addEnumOption(const std::string& shortflag, const std::string& longflag, const std::string& description,
+                std::vector<std::pair<std::string, T>> choices, T default_value);
+
+            /*  添加列表值选项，值以sep分隔，T可以为算术类型或std::string
+                - 第一次给出时替换默认值，之后每次给出的元素追加到列表末尾   */
+            template<class T>
+            OptionHandle<std::vector<T>> addListOption(const std::string& shortflag, const std::string& longflag, const std::string& description,
+                std::vector<T> default_value = std::vector<T>(), char sep = ',');
+
+            /*  解析main函数接收的参数，每次解析前各选项会恢复为默认值
+                @return 0代表成功，-1代表选项定义有误、值无法解析、缺少值或缺少必需的选项   */
+            int parse(int argc, char* argv[]);
+
+            //获取位置参数，即不属于任何选项的参数
+            const std::vector<std::string>& positionalArgs() const;
+
+            //按一定格式打印已添加的选项、类型与描述
+            void printPreset() const;
+
+            //按一定格式打印解析后的选项值
+            void printParsed() const;
+
+            //禁止拷贝和移动
+            OptionRegistry(const OptionRegistry& tmp) = delete;
+            OptionRegistry& operator=(const OptionRegistry& tmp) = delete;
+
+        private:
+            bool addSlot(_OptionSlot* slot);
+            void buildFlagTable();
+            int findSlot(mstr::StrView flag) const;
+            int assignValue(int slot_id, mstr::StrView flag, mstr::StrView value);
+            std::string flagPart(const _OptionSlot& slot) const;
+
+            std::vector<std::unique_ptr<_OptionSlot>> slots_;
+            std::vector<mstr::StrView> flag_keys_;    //各标志的视图，指向slots_中的字符串
+            std::vector<int> flag_slot_ids_;    //flag_keys_中各标志所属的选项
+            std::vector<int> flag_table_;    //完美哈希表，存放flag_keys_的下标，-1为空位
+            std::vector<uint32_t> flag_seeds_;    //两级哈希中各桶的第二级哈希种子
+            uint32_t flag_bucket_mask_;
+            uint32_t flag_mask_;
+            bool table_dirty_;
+            bool invalid_;    //添加选项时是否出现过错误
+            std::vector<std::string> positional_args_;
+        };
     }
 
 }
@@ -145,10 +378,44 @@ namespace mineutils
 
     namespace mio
     {
+        template<class Writer, class T, class... Args>
+        int _printLine(std::ostream* fmt_src, const Writer& writer, const T& arg, const Args&... args);
+
         template<class T, class... Args>
-        void _recurPrint(const T& arg, const Args&... args);
+        void _recurPrint(mstr::StringBuilder& line, std::ostream* os, const T& arg, const Args&... args);
+
+        void _recurPrint(mstr::StringBuilder& line, std::ostream* os);
+
+        mstr::StringBuilder* _threadPrintLine();
+
+        int& _threadPrintDepth();
+
+        /*  _printLine使用的整行缓冲区，优先借用当前线程复用的缓冲区，析构时归还
+            - 参数的operator<<中再次调用print/printTo时，线程内的缓冲区正被外层使用，改用临时缓冲区
+            - 不支持thread_local时总是使用临时缓冲区  */
+        class _PrintLineLease
+        {
+        public:
+            _PrintLineLease();
+            ~_PrintLineLease();
+            _PrintLineLease(const _PrintLineLease&) = delete;
+            _PrintLineLease& operator=(const _PrintLineLease&) = delete;
 
-        void _recurPrint();
+            mstr::StringBuilder& line();
+
+        private:
+            mstr::StringBuilder* line_;
+            std::unique_ptr<mstr::StringBuilder> tmp_line_;
+        };
+
+        void _writePrintLine(const char* data, size_t len);
+
+        int _writeToSink(FILE* fp, const char* data, size_t len);
+        int _writeToSink(const FdSink& sink, const char* data, size_t len);
+        int _writeToSink(std::string& sink, const char* data, size_t len);
+        int _writeToSink(mstr::StringBuilder& sink, const char* data, size_t len);
+        int _writeToSink(std::ostream& sink, const char* data, size_t len);
+        int _writeToSink(PrintRingBuffer& sink, const char* data, size_t len);
 
 
         _MINE_EXPORT inline std::mutex& _immutableGetPrintlock()
@@ -157,47 +424,538 @@ namespace mineutils
             return lk;
         }
 
+        //print的共享状态，除标明的成员外均由_immutableGetPrintlock()保护
+        struct _PrintState
+        {
+            PrintFlushPolicy policy = flush_by_line;
+            size_t policy_value = 0;
+            std::string pending;    //已格式化但未写出的内容
+            std::string spare;    //后台线程写出时与pending交换，复用容量
+            std::chrono::steady_clock::time_point last_flush = std::chrono::steady_clock::now();
+
+            bool async_running = false;
+            bool stop_flag = false;
+            bool flush_requested = false;
+            bool writing = false;    //后台线程是否正在锁外写出
+            int space_waiters = 0;    //等待缓冲区空间的线程数
+            size_t max_pending_bytes = 4 << 20;
+            std::condition_variable worker_cv;    //唤醒后台线程
+            std::condition_variable done_cv;    //后台线程写出一批后唤醒等待的线程
+            std::thread worker;    //由start/stopAsyncPrint在锁外join
+            bool atexit_registered = false;
+        };
+
         template<class T, class... Args>
         inline void print(const T& arg, const Args&... args)
         {
-            std::lock_guard<std::mutex> lk(mio::_immutableGetPrintlock());
-            //std::cout << std::fixed;
-            mio::_recurPrint(arg, args...);
+            mio::_printLine(&std::cout, [](const char* data, size_t len) -> int { mio::_writePrintLine(data, len); return 0; }, arg, args...);
+        }
+
+        //printTo的格式来源，只有std::ostream类型的sink沿用自身的格式
+        template<class Sink>
+        inline std::ostream* _printFormatSource(Sink& sink, std::true_type)
+        {
+            return &sink;
+        }
+
+        template<class Sink>
+        inline std::ostream* _printFormatSource(Sink&, std::false_type)
+        {
+            return nullptr;
+        }
+
+        template<class Sink, class T, class... Args>
+        inline int printTo(Sink&& sink, const T& arg, const Args&... args)
+        {
+            std::ostream* fmt_src = mio::_printFormatSource(sink, std::is_base_of<std::ostream, typename std::decay<Sink>::type>());
+            return mio::_printLine(fmt_src, [&sink](const char* data, size_t len) -> int { return mio::_writeToSink(sink, data, len); }, arg, args...);
+        }
+
+        //在线程内缓冲区中格式化整行后交给writer一次写出
+        template<class Writer, class T, class... Args>
+        inline int _printLine(std::ostream* fmt_src, const Writer& writer, const T& arg, const Args&... args)
+        {
+            _PrintLineLease lease;
+            mstr::StringBuilder* line = &lease.line();
+            //格式来源为默认格式时按toStr的规则追加，结果与输出到流中一致；否则沿用其上设置的格式
+            std::ostream* os = nullptr;
+            if (fmt_src && (fmt_src->flags() != (std::ios_base::skipws | std::ios_base::dec) || fmt_src->precision() != 6 || fmt_src->width() != 0))
+            {
+                os = &line->_stream();
+                os->flags(fmt_src->flags());
+                os->precision(fmt_src->precision());
+                os->fill(fmt_src->fill());
+                os->width(fmt_src->width());
+                fmt_src->width(0);
+            }
+            mio::_recurPrint(*line, os, arg, args...);
+            return writer(line->data(), line->size());
         }
 
         template<class T, class... Args>
-        inline void _recurPrint(const T& arg, const Args&... args)
+        inline void _recurPrint(mstr::StringBuilder& line, std::ostream* os, const T& arg, const Args&... args)
+        {
+            if (os)
+                mstr::_osInput(*os, arg);
+            else mstr::toStr(line, arg);
+            line.append(" ", 1);
+            mio::_recurPrint(line, os, args...);
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        //有意不释放，保证进程退出阶段仍在打印的线程可以安全访问；与打印锁一样导出，多个动态库共享同一份状态
+        _MINE_EXPORT _MINE_INLINE _PrintState& _getPrintState()
         {
-            mstr::_osInput(std::cout, arg);
-            std::cout << " ";
-            mio::_recurPrint(args...);
+            static _PrintState* state = new _PrintState;
+            return *state;
         }
 
         //_recurPrint递归结束位置
-        inline void _recurPrint()
+        _MINE_INLINE void _recurPrint(mstr::StringBuilder& line, std::ostream*)
+        {
+            line.append("\n", 1);
+        }
+
+        //当前线程复用的整行缓冲区，不支持thread_local时返回nullptr，由调用者临时创建
+        _MINE_INLINE mstr::StringBuilder* _threadPrintLine()
+        {
+#if defined(__GNUC__) && !_mgccMinVersion(4, 8, 1)  //for qnx660
+            return nullptr;
+#else
+            //同mstr::_toStrDispath，thread_local的流对象用指针管理
+            thread_local std::unique_ptr<mstr::StringBuilder> line_ptr;
+            //避免偶发的超长行使线程长期占用大块内存
+            if (!line_ptr || line_ptr->capacity() > (64 << 10))
+                line_ptr.reset(new mstr::StringBuilder);
+            line_ptr->clear();
+            return line_ptr.get();
+#endif
+        }
+
+        //当前线程正在进行的_printLine层数，只在支持thread_local时使用
+        _MINE_INLINE int& _threadPrintDepth()
+        {
+            static _MINE_THREAD_LOCAL_IF_HAVE int depth = 0;
+            return depth;
+        }
+
+        _MINE_INLINE _PrintLineLease::_PrintLineLease() : line_(nullptr)
+        {
+#if !(defined(__GNUC__) && !_mgccMinVersion(4, 8, 1))  //qnx660不支持thread_local，不借用线程内的缓冲区
+            if (mio::_threadPrintDepth()++ == 0)
+                line_ = mio::_threadPrintLine();
+#endif
+            if (line_ == nullptr)
+            {
+                tmp_line_.reset(new mstr::StringBuilder);
+                line_ = tmp_line_.get();
+            }
+        }
+
+        _MINE_INLINE _PrintLineLease::~_PrintLineLease()
+        {
+#if !(defined(__GNUC__) && !_mgccMinVersion(4, 8, 1))
+            mio::_threadPrintDepth()--;
+#endif
+        }
+
+        _MINE_INLINE mstr::StringBuilder& _PrintLineLease::line()
+        {
+            return *line_;
+        }
+
+        _MINE_INLINE _PrintSinkRef& _threadPrintCapture()
+        {
+            static _MINE_THREAD_LOCAL_IF_HAVE _PrintSinkRef capture;
+            return capture;
+        }
+
+        //缓冲的内容是否满足刷新条件，需持有打印锁
+        _MINE_INLINE bool _printFlushDue(const _PrintState& state, std::chrono::steady_clock::time_point now)
+        {
+            switch (state.policy)
+            {
+            case flush_by_interval:
+                return now - state.last_flush >= std::chrono::milliseconds(state.policy_value);
+            case flush_by_size:
+                return state.pending.size() >= state.policy_value;
+            default:
+                return true;
+            }
+        }
+
+        //同步写出缓冲的内容，需持有打印锁
+        _MINE_INLINE void _flushPendingLocked(_PrintState& state)
+        {
+            if (!state.pending.empty())
+            {
+                std::cout.write(state.pending.data(), state.pending.size());
+                state.pending.clear();
+            }
+            std::cout.flush();
+            state.last_flush = std::chrono::steady_clock::now();
+        }
+
+        _MINE_INLINE void _writePrintLine(const char* data, size_t len)
+        {
+            const _PrintSinkRef& capture = mio::_threadPrintCapture();
+            if (capture.write)
+            {
+                capture.write(capture, data, len);
+                return;
+            }
+            _PrintState& state = mio::_getPrintState();
+            std::unique_lock<std::mutex> lk(mio::_immutableGetPrintlock());
+            if (state.async_running)
+            {
+                while (!state.pending.empty() && state.pending.size() + len > state.max_pending_bytes && state.async_running)
+                {
+                    state.space_waiters++;
+                    state.worker_cv.notify_one();
+                    state.done_cv.wait(lk);
+                    state.space_waiters--;
+                }
+                if (state.async_running)
+                {
+                    bool was_empty = state.pending.empty();
+                    state.pending.append(data, len);
+                    //后台线程只在缓冲区由空变为非空或满足刷新条件时需要唤醒
+                    if (was_empty || mio::_printFlushDue(state, std::chrono::steady_clock::now()))
+                        state.worker_cv.notify_one();
+                    return;
+                }
+            }
+            if (state.policy == flush_by_line && state.pending.empty())
+            {
+                std::cout.write(data, len);
+                std::cout.flush();
+                return;
+            }
+            state.pending.append(data, len);
+            if (mio::_printFlushDue(state, std::chrono::steady_clock::now()))
+                mio::_flushPendingLocked(state);
+        }
+
+        _MINE_INLINE void _asyncPrintWorker()
+        {
+            _PrintState& state = mio::_getPrintState();
+            std::unique_lock<std::mutex> lk(mio::_immutableGetPrintlock());
+            while (true)
+            {
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                bool due = !state.pending.empty() && (state.flush_requested || state.stop_flag || state.space_waiters > 0 || mio::_printFlushDue(state, now));
+                if (!due)
+                {
+                    if (state.stop_flag)
+                        break;
+                    if (state.flush_requested)
+                    {
+                        state.flush_requested = false;
+                        state.done_cv.notify_all();
+                    }
+                    else if (!state.pending.empty() && state.policy == flush_by_interval)
+                        state.worker_cv.wait_until(lk, state.last_flush + std::chrono::milliseconds(state.policy_value));
+                    else state.worker_cv.wait(lk);
+                    continue;
+                }
+                state.spare.clear();
+                state.pending.swap(state.spare);
+                state.flush_requested = false;
+                state.writing = true;
+                state.done_cv.notify_all();    //缓冲区已腾空，唤醒等待空间的线程
+                lk.unlock();
+                std::cout.write(state.spare.data(), state.spare.size());
+                std::cout.flush();
+                lk.lock();
+                state.writing = false;
+                state.last_flush = std::chrono::steady_clock::now();
+                state.done_cv.notify_all();
+            }
+            //与检查pending在同一临界区内结束后台写出，此后的print均走同步写出
+            std::cout.flush();
+            state.async_running = false;
+            state.done_cv.notify_all();
+        }
+
+        _MINE_INLINE void _registerPrintAtexitLocked(_PrintState& state)
+        {
+            if (!state.atexit_registered)
+            {
+                state.atexit_registered = true;
+                atexit([]() { mio::stopAsyncPrint(); mio::flushPrint(); });
+            }
+        }
+
+        _MINE_INLINE void setPrintFlushPolicy(PrintFlushPolicy policy, size_t value)
+        {
+            if (policy == flush_by_interval && value == 0)
+                policy = flush_by_line;
+            mio::flushPrint();
+            _PrintState& state = mio::_getPrintState();
+            std::lock_guard<std::mutex> lk(mio::_immutableGetPrintlock());
+            state.policy = policy;
+            state.policy_value = value;
+            if (policy != flush_by_line)
+                mio::_registerPrintAtexitLocked(state);
+            state.worker_cv.notify_one();    //后台线程按新策略重新计算等待时间
+        }
+
+        _MINE_INLINE void flushPrint()
+        {
+            _PrintState& state = mio::_getPrintState();
+            std::unique_lock<std::mutex> lk(mio::_immutableGetPrintlock());
+            if (state.async_running)
+            {
+                while (state.async_running && (state.writing || !state.pending.empty()))
+                {
+                    state.flush_requested = true;
+                    state.worker_cv.notify_one();
+                    state.done_cv.wait(lk);
+                }
+                if (state.async_running)
+                    return;
+            }
+            mio::_flushPendingLocked(state);
+        }
+
+        _MINE_INLINE int startAsyncPrint(size_t max_pending_bytes)
+        {
+            _PrintState& state = mio::_getPrintState();
+            std::thread old_worker;
+            {
+                std::lock_guard<std::mutex> lk(mio::_immutableGetPrintlock());
+                if (state.async_running)
+                    return 1;
+                old_worker = std::move(state.worker);
+            }
+            //上一个后台线程已退出循环，只需回收
+            if (old_worker.joinable())
+                old_worker.join();
+
+            std::lock_guard<std::mutex> lk(mio::_immutableGetPrintlock());
+            if (state.async_running || state.worker.joinable())
+                return 1;
+            state.max_pending_bytes = max_pending_bytes > 0 ? max_pending_bytes : 1;
+            state.stop_flag = false;
+            state.flush_requested = false;
+            state.async_running = true;
+            state.worker = std::thread(mio::_asyncPrintWorker);
+            mio::_registerPrintAtexitLocked(state);
+            return 0;
+        }
+
+        _MINE_INLINE void stopAsyncPrint()
+        {
+            _PrintState& state = mio::_getPrintState();
+            std::thread worker;
+            {
+                std::lock_guard<std::mutex> lk(mio::_immutableGetPrintlock());
+                if (!state.async_running && !state.worker.joinable())
+                    return;
+                state.stop_flag = true;
+                state.worker_cv.notify_one();
+                worker = std::move(state.worker);
+            }
+            if (worker.joinable())
+                worker.join();
+        }
+
+        _MINE_INLINE int _writeToSink(FILE* fp, const char* data, size_t len)
+        {
+            if (fp == nullptr)
+            {
+                mprintfWLimited("Got a null FILE pointer!\n");
+                return -1;
+            }
+            return fwrite(data, 1, len, fp) == len ? 0 : -1;
+        }
+
+        _MINE_INLINE int _writeToSink(const FdSink& sink, const char* data, size_t len)
+        {
+            while (len > 0)
+            {
+#if defined(_MSC_VER)
+                int written = _write(sink.fd, data, unsigned(std::min<size_t>(len, 1 << 30)));
+#else
+                ssize_t written = ::write(sink.fd, data, len);
+#endif
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    mprintfWLimited("Failed to write to fd:%d, errno:%d!\n", sink.fd, errno);
+                    return -1;
+                }
+                data += written;
+                len -= size_t(written);
+            }
+            return 0;
+        }
+
+        _MINE_INLINE int _writeToSink(std::string& sink, const char* data, size_t len)
+        {
+            sink.append(data, len);
+            return 0;
+        }
+
+        _MINE_INLINE int _writeToSink(mstr::StringBuilder& sink, const char* data, size_t len)
+        {
+            sink.append(data, len);
+            return 0;
+        }
+
+        _MINE_INLINE int _writeToSink(std::ostream& sink, const char* data, size_t len)
+        {
+            sink.write(data, std::streamsize(len));
+            return sink.good() ? 0 : -1;
+        }
+
+        _MINE_INLINE int _writeToSink(PrintRingBuffer& sink, const char* data, size_t len)
+        {
+            sink.write(data, len);
+            return 0;
+        }
+
+        _MINE_INLINE PrintRingBuffer::PrintRingBuffer(size_t capacity)
+            : buf_(capacity > 0 ? capacity : 1), head_(0), size_(0), partial_first_line_(false)
+        {
+        }
+
+        _MINE_INLINE void PrintRingBuffer::write(const char* data, size_t len)
+        {
+            std::lock_guard<std::mutex> lk(this->mtx_);
+            const size_t capacity = this->buf_.size();
+            if (this->size_ + len > capacity)
+            {
+                //被丢弃的最后一个字节是换行符时，剩余内容仍从完整的一行开始
+                const size_t dropped = this->size_ + len - capacity;
+                const size_t start = (this->head_ + capacity - this->size_) % capacity;
+                const char last_dropped = dropped <= this->size_ ? this->buf_[(start + dropped - 1) % capacity] : data[dropped - this->size_ - 1];
+                this->partial_first_line_ = last_dropped != '\n';
+            }
+            if (len >= capacity)
+            {
+                memcpy(this->buf_.data(), data + len - capacity, capacity);
+                this->head_ = 0;
+                this->size_ = capacity;
+                return;
+            }
+            const size_t first = std::min(len, capacity - this->head_);
+            memcpy(this->buf_.data() + this->head_, data, first);
+            memcpy(this->buf_.data(), data + first, len - first);
+            this->head_ = (this->head_ + len) % capacity;
+            this->size_ = std::min(this->size_ + len, capacity);
+        }
+
+        _MINE_INLINE std::string PrintRingBuffer::str() const
+        {
+            std::lock_guard<std::mutex> lk(this->mtx_);
+            return this->contentLocked();
+        }
+
+        _MINE_INLINE std::string PrintRingBuffer::contentLocked() const
+        {
+            const size_t capacity = this->buf_.size();
+            const size_t start = (this->head_ + capacity - this->size_) % capacity;
+            const size_t first = std::min(this->size_, capacity - start);
+            std::string content;
+            content.reserve(this->size_);
+            content.append(this->buf_.data() + start, first);
+            content.append(this->buf_.data(), this->size_ - first);
+            //最早的一行只剩后半段时从下一行开始，没有下一行时保留这半行
+            if (this->partial_first_line_)
+            {
+                size_t pos = content.find('\n');
+                if (pos != std::string::npos && pos + 1 < content.size())
+                    content.erase(0, pos + 1);
+            }
+            return content;
+        }
+
+        _MINE_INLINE int PrintRingBuffer::dumpTo(FILE* fp)
+        {
+            std::string content;
+            {
+                std::lock_guard<std::mutex> lk(this->mtx_);
+                content = this->contentLocked();
+                this->head_ = 0;
+                this->size_ = 0;
+                this->partial_first_line_ = false;
+            }
+            if (mio::_writeToSink(fp, content.data(), content.size()) != 0)
+                return -1;
+            return fflush(fp) == 0 ? 0 : -1;
+        }
+
+        _MINE_INLINE void PrintRingBuffer::clear()
+        {
+            std::lock_guard<std::mutex> lk(this->mtx_);
+            this->head_ = 0;
+            this->size_ = 0;
+            this->partial_first_line_ = false;
+        }
+
+        _MINE_INLINE size_t PrintRingBuffer::size() const
+        {
+            std::lock_guard<std::mutex> lk(this->mtx_);
+            return this->size_;
+        }
+
+        _MINE_INLINE size_t PrintRingBuffer::capacity() const
+        {
+            return this->buf_.size();
+        }
+
+        _MINE_INLINE int _writeToFileRef(const _PrintSinkRef& ref, const char* data, size_t len)
+        {
+            return mio::_writeToSink(static_cast<FILE*>(ref.obj), data, len);
+        }
+
+        _MINE_INLINE int _writeToFdRef(const _PrintSinkRef& ref, const char* data, size_t len)
+        {
+            return mio::_writeToSink(FdSink(ref.fd), data, len);
+        }
+
+        _MINE_INLINE ScopedPrintCapture::ScopedPrintCapture(FILE* fp)
         {
-            std::cout << std::endl;
+            _PrintSinkRef& capture = mio::_threadPrintCapture();
+            this->prev_ = capture;
+            capture.obj = fp;
+            capture.write = mio::_writeToFileRef;
+        }
+
+        _MINE_INLINE ScopedPrintCapture::ScopedPrintCapture(FdSink sink)
+        {
+            _PrintSinkRef& capture = mio::_threadPrintCapture();
+            this->prev_ = capture;
+            capture.fd = sink.fd;
+            capture.write = mio::_writeToFdRef;
+        }
+
+        _MINE_INLINE ScopedPrintCapture::~ScopedPrintCapture()
+        {
+            mio::_threadPrintCapture() = this->prev_;
         }
 
 
-        inline BooleanOption::BooleanOption(std::string shortflag, std::string longflag, std::string description)
+        _MINE_INLINE BooleanOption::BooleanOption(std::string shortflag, std::string longflag, std::string description)
         {
             this->data_[0] = std::move(shortflag);
             this->data_[1] = std::move(longflag);
             this->data_[2] = std::move(description);
         }
 
-        inline std::string& BooleanOption::operator[](size_t id)
+        _MINE_INLINE std::string& BooleanOption::operator[](size_t id)
         {
             return this->data_[id];
         }
 
-        inline const std::string& BooleanOption::operator[](size_t id) const
+        _MINE_INLINE const std::string& BooleanOption::operator[](size_t id) const
         {
             return this->data_[id];
         }
 
-        inline ValueOption::ValueOption(std::string shortflag, std::string longflag, std::string description, std::string default_value)
+        _MINE_INLINE ValueOption::ValueOption(std::string shortflag, std::string longflag, std::string description, std::string default_value)
         {
             this->data_[0] = std::move(shortflag);
             this->data_[1] = std::move(longflag);
@@ -205,22 +963,22 @@ namespace mineutils
             this->data_[3] = std::move(default_value);
         }
 
-        inline std::string& ValueOption::operator[](size_t id)
+        _MINE_INLINE std::string& ValueOption::operator[](size_t id)
         {
             return this->data_[id];
         }
 
-        inline const std::string& ValueOption::operator[](size_t id) const
+        _MINE_INLINE const std::string& ValueOption::operator[](size_t id) const
         {
             return this->data_[id];
         }
 
-        inline ArgumentParser::ArgumentParser()
+        _MINE_INLINE ArgumentParser::ArgumentParser()
         {
             this->max_flag_size_ = 0;
         }
 
-        inline int ArgumentParser::parse(int argc, char* argv[], std::vector<BooleanOption> boolopts_preset, std::vector<ValueOption> valueopts_preset)
+        _MINE_INLINE int ArgumentParser::parse(int argc, char* argv[], std::vector<BooleanOption> boolopts_preset, std::vector<ValueOption> valueopts_preset)
         {
             if (!this->checkPresetsAreValid(boolopts_preset, valueopts_preset))
                 return -1;
@@ -266,7 +1024,7 @@ namespace mineutils
 
             if (argc < 1)
             {
-                mprintfW("Wrong value of argc:%d!\n", argc);
+                mprintfWLimited("Wrong value of argc:%d!\n", argc);
                 return 1;
             }
             for (int i = 1; i < argc; i++)
@@ -311,17 +1069,17 @@ namespace mineutils
             return 0;
         }
 
-        inline bool ArgumentParser::getBoolOpt(const std::string& flag)
+        _MINE_INLINE bool ArgumentParser::getBoolOpt(const std::string& flag)
         {
             if (flag.empty())
             {
-                mprintfW("Got an empty flag!\n");
+                mprintfWLimited("Got an empty flag!\n");
                 return false;
             }
             return this->boolopts_parsed_.find(flag) != this->boolopts_parsed_.end();
         }
 
-        inline bool ArgumentParser::getParsedBoolOpt(const std::string& flag)
+        _MINE_INLINE bool ArgumentParser::getParsedBoolOpt(const std::string& flag)
         {
             return this->getBoolOpt(flag);
         }
@@ -336,11 +1094,11 @@ namespace mineutils
         //    return "";
         //}
 
-        inline const char* ArgumentParser::getValueOpt(const std::string& flag)
+        _MINE_INLINE const char* ArgumentParser::getValueOpt(const std::string& flag)
         {
             if (flag.empty())
             {
-                mprintfW("Got an empty flag!\n");
+                mprintfWLimited("Got an empty flag!\n");
                 return "";
             }
             if (this->valueopts_parsed_.find(flag) != this->valueopts_parsed_.end())
@@ -348,12 +1106,12 @@ namespace mineutils
             return "";
         }
 
-        inline const char* ArgumentParser::getParsedValueOpt(const std::string& flag)
+        _MINE_INLINE const char* ArgumentParser::getParsedValueOpt(const std::string& flag)
         {
             return this->getValueOpt(flag);
         }
 
-        inline void ArgumentParser::printPreset()
+        _MINE_INLINE void ArgumentParser::printPreset()
         {
             if (!this->boolopts_preset_.empty())
                 //printf("Preset Boolean Options:\n");
@@ -382,7 +1140,7 @@ namespace mineutils
             printf("\n");
         }
 
-        inline void ArgumentParser::printParsed()
+        _MINE_INLINE void ArgumentParser::printParsed()
         {
             if (!this->boolopts_preset_.empty())
                 printf("Parsed Boolean Options:\n");
@@ -412,7 +1170,7 @@ namespace mineutils
             printf("\n");
         }
 
-        inline bool ArgumentParser::checkPresetsAreValid(const std::vector<BooleanOption>& boolopts_preset, const std::vector<ValueOption>& valueopts_preset)
+        _MINE_INLINE bool ArgumentParser::checkPresetsAreValid(const std::vector<BooleanOption>& boolopts_preset, const std::vector<ValueOption>& valueopts_preset)
         {
             std::unordered_set<std::string> bool_flags;
             bool_flags.reserve(boolopts_preset.size() * 2);
@@ -507,7 +1265,648 @@ namespace mineutils
             }
             return true;
         }
-    }
+#else
+        _MINE_EXPORT _PrintState& _getPrintState();
+        _PrintSinkRef& _threadPrintCapture();
+#endif
+
+        template<class Sink>
+        inline int _writeToSinkRef(const _PrintSinkRef& ref, const char* data, size_t len)
+        {
+            return mio::_writeToSink(*static_cast<Sink*>(ref.obj), data, len);
+        }
+
+        template<class Sink>
+        inline ScopedPrintCapture::ScopedPrintCapture(Sink& sink)
+        {
+            _PrintSinkRef& capture = mio::_threadPrintCapture();
+            this->prev_ = capture;
+            capture.obj = &sink;
+            capture.write = mio::_writeToSinkRef<Sink>;
+        }
+
+        //OptionRegistry中一个选项的定义和存储
+        struct _OptionSlot
+        {
+            virtual ~_OptionSlot() {}
+
+            //解析命令行中给出的一次值，返回0代表成功
+            virtual int assign(mstr::StrView value) = 0;
+
+            //恢复为默认值
+            virtual void reset() = 0;
+
+            virtual std::string valueStr() const = 0;
+
+            std::string short_flag;
+            std::string long_flag;
+            std::string description;
+            std::string type_name;
+            std::string default_str;
+            bool is_flag = false;
+            bool required = false;
+            bool is_set = false;
+        };
+
+        template<class T>
+        inline int _parseOptionValue(mstr::StrView s, T& value, std::true_type)
+        {
+            return mstr::_parseTypedNumber(s, value) == 0 ? 0 : -1;
+        }
+
+        template<class T>
+        inline int _parseOptionValue(mstr::StrView s, T& value, std::false_type)
+        {
+            value.assign(s.data(), s.size());
+            return 0;
+        }
+
+        //将选项值s解析为算术类型或std::string，int8_t和uint8_t按整数解析
+        template<class T>
+        inline int _parseOptionValue(mstr::StrView s, T& value)
+        {
+            return mio::_parseOptionValue(s, value, std::is_arithmetic<T>());
+        }
+
+        template<class T>
+        inline std::string _optionValueToStr(const T& value, std::true_type)
+        {
+            return value ? "true" : "false";
+        }
+
+        template<class T>
+        inline std::string _optionValueToStr(const T& value, std::false_type)
+        {
+            return mstr::_typedNumberToStr(value);
+        }
+
+        //bool值转换为true或false，int8_t和uint8_t转换为整数，其他值按toStr的规则转换
+        template<class T>
+        inline std::string _optionValueToStr(const T& value)
+        {
+            return mio::_optionValueToStr(value, std::is_same<T, bool>());
+        }
+
+        template<class T>
+        inline std::string _optionTypeName()
+        {
+            return std::is_same<T, bool>::value ? "BOOL" : std::is_integral<T>::value ? "INT" : std::is_floating_point<T>::value ? "FLOAT" : "STRING";
+        }
+
+        template<class T>
+        struct _ValueOptionSlot : public _OptionSlot
+        {
+            int assign(mstr::StrView s) override
+            {
+                return mio::_parseOptionValue(s, this->value);
+            }
+
+            void reset() override
+            {
+                this->value = this->default_value;
+            }
+
+            std::string valueStr() const override
+            {
+                return mio::_optionValueToStr(this->value);
+            }
+
+            T value;
+            T default_value;
+        };
+
+        template<class T>
+        struct _EnumOptionSlot : public _OptionSlot
+        {
+            int assign(mstr::StrView s) override
+            {
+                for (auto& choice : this->choices)
+                {
+                    if (s == choice.first)
+                    {
+                        this->value = choice.second;
+                        return 0;
+                    }
+                }
+                return -1;
+            }
+
+            void reset() override
+            {
+                this->value = this->default_value;
+            }
+
+            std::string valueStr() const override
+            {
+                for (auto& choice : this->choices)
+                {
+                    if (choice.second == this->value)
+                        return choice.first;
+                }
+                return "";
+            }
+
+            T value;
+            T default_value;
+            std::vector<std::pair<std::string, T>> choices;
+        };
+
+        template<class T>
+        struct _ListOptionSlot : public _OptionSlot
+        {
+            int assign(mstr::StrView s) override
+            {
+                //第一次给出时替换默认值
+                if (!this->is_set)
+                    this->value.clear();
+                if (s.empty())
+                    return 0;
+                for (mstr::StrView field : mstr::splitIter(s, mstr::StrView(&this->sep, 1)))
+                {
+                    this->value.push_back(T());
+                    if (mio::_parseOptionValue(mstr::trimView(field), this->value.back()) != 0)
+                        return -1;
+                }
+                return 0;
+            }
+
+            void reset() override
+            {
+                this->value = this->default_value;
+            }
+
+            std::string valueStr() const override
+            {
+                std::string s;
+                for (size_t i = 0; i < this->value.size(); i++)
+                {
+                    if (i > 0)
+                        s.push_back(this->sep);
+                    s.append(mio::_optionValueToStr(this->value[i]));
+                }
+                return s;
+            }
+
+            std::vector<T> value;
+            std::vector<T> default_value;
+            char sep = ',';
+        };
+
+        template<class T>
+        inline OptionHandle<T>::OptionHandle() : value_(nullptr), is_set_(nullptr)
+        {
+        }
+
+        template<class T>
+        inline OptionHandle<T>::OptionHandle(const T* value, const bool* is_set) : value_(value), is_set_(is_set)
+        {
+        }
+
+        template<class T>
+        inline const T& OptionHandle<T>::get() const
+        {
+            return *this->value_;
+        }
+
+        template<class T>
+        inline const T& OptionHandle<T>::operator*() const
+        {
+            return *this->value_;
+        }
+
+        template<class T>
+        inline const T* OptionHandle<T>::operator->() const
+        {
+            return this->value_;
+        }
+
+        template<class T>
+        inline bool OptionHandle<T>::isSet() const
+        {
+            return this->is_set_ != nullptr && *this->is_set_;
+        }
+
+        template<class T>
+        inline bool OptionHandle<T>::valid() const
+        {
+            return this->value_ != nullptr;
+        }
+
+        template<class T>
+        inline OptionHandle<T> OptionRegistry::addOption(const std::string& shortflag, const std::string& longflag, const std::string& description, T default_value, bool required)
+        {
+            static_assert(std::is_arithmetic<T>::value || std::is_same<T, std::string>::value, "OptionRegistry::addOption only supports arithmetic types and std::string!");
+            _ValueOptionSlot<T>* slot = new _ValueOptionSlot<T>;
+            slot->short_flag = shortflag;
+            slot->long_flag = longflag;
+            slot->description = description;
+            slot->type_name = mio::_optionTypeName<T>();
+            slot->required = required;
+            slot->default_value = std::move(default_value);
+            slot->value = slot->default_value;
+            if (!required)
+                slot->default_str = mio::_optionValueToStr(slot->default_value);
+            if (!this->addSlot(slot))
+                return OptionHandle<T>();
+            return OptionHandle<T>(&slot->value, &slot->is_set);
+        }
+
+        template<class T>
+        inline OptionHandle<T> OptionRegistry::addEnumOption(const std::string& shortflag, const std::string& longflag, const std::string& description,
+            std::vector<std::pair<std::string, T>> choices, T default_value)
+        {
+            _EnumOptionSlot<T>* slot = new _EnumOptionSlot<T>;
+            slot->short_flag = shortflag;
+            slot->long_flag = longflag;
+            slot->description = description;
+            slot->default_value = default_value;
+            slot->value = default_value;
+            slot->choices = std::move(choices);
+            for (auto& choice : slot->choices)
+                slot->type_name.append(slot->type_name.empty() ? "" : "|").append(choice.first);
+            slot->default_str = slot->valueStr();
+            if (!this->addSlot(slot))
+                return OptionHandle<T>();
+            return OptionHandle<T>(&slot->value, &slot->is_set);
+        }
+
+        template<class T>
+        inline OptionHandle<std::vector<T>> OptionRegistry::addListOption(const std::string& shortflag, const std::string& longflag, const std::string& description,
+            std::vector<T> default_value, char sep)
+        {
+            static_assert(std::is_arithmetic<T>::value || std::is_same<T, std::string>::value, "OptionRegistry::addListOption only supports arithmetic types and std::string!");
+            _ListOptionSlot<T>* slot = new _ListOptionSlot<T>;
+            slot->short_flag = shortflag;
+            slot->long_flag = longflag;
+            slot->description = description;
+            slot->sep = sep;
+            slot->type_name = mio::_optionTypeName<T>() + sep + "...";
+            slot->default_value = std::move(default_value);
+            slot->value = slot->default_value;
+            slot->default_str = slot->valueStr();
+            if (!this->addSlot(slot))
+                return OptionHandle<std::vector<T>>();
+            return OptionHandle<std::vector<T>>(&slot->value, &slot->is_set);
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        //带种子的FNV-1a哈希，用于构建标志的完美哈希表
+        _MINE_INLINE uint32_t _hashFlag(mstr::StrView flag, uint32_t seed)
+        {
+            uint32_t h = 2166136261u ^ seed;
+            for (char c : flag)
+            {
+                h ^= (unsigned char)c;
+                h *= 16777619u;
+            }
+            h ^= h >> 15;
+            h *= 0x2c1b3c6du;
+            h ^= h >> 12;
+            return h;
+        }
+
+        _MINE_INLINE OptionRegistry::OptionRegistry()
+            : flag_bucket_mask_(0), flag_mask_(0), table_dirty_(false), invalid_(false)
+        {
+        }
+
+        _MINE_INLINE OptionRegistry::~OptionRegistry()
+        {
+        }
+
+        _MINE_INLINE OptionHandle<bool> OptionRegistry::addFlag(const std::string& shortflag, const std::string& longflag, const std::string& description)
+        {
+            _ValueOptionSlot<bool>* slot = new _ValueOptionSlot<bool>;
+            slot->short_flag = shortflag;
+            slot->long_flag = longflag;
+            slot->description = description;
+            slot->is_flag = true;
+            slot->default_value = false;
+            slot->value = false;
+            if (!this->addSlot(slot))
+                return OptionHandle<bool>();
+            return OptionHandle<bool>(&slot->value, &slot->is_set);
+        }
+
+        _MINE_INLINE OptionHandle<std::string> OptionRegistry::addOption(const std::string& shortflag, const std::string& longflag, const std::string& description, const char* default_value, bool required)
+        {
+            return this->addOption<std::string>(shortflag, longflag, description, default_value ? default_value : "", required);
+        }
+
+        _MINE_INLINE bool OptionRegistry::addSlot(_OptionSlot* slot)
+        {
+            std::unique_ptr<_OptionSlot> holder(slot);
+            if (slot->short_flag.empty() && slot->long_flag.empty())
+            {
+                mprintfE("Both short flag and long flag are empty()!\n");
+                this->invalid_ = true;
+                return false;
+            }
+            const std::string& short_flag = slot->short_flag;
+            if (!short_flag.empty() && (short_flag.size() != 2 || short_flag[0] != '-' || short_flag[1] == '-' || short_flag[1] == '=' || mstr::_isSpaceChar(short_flag[1])))
+            {
+                mprintfE("Invalid short flag:%s!\n", short_flag.c_str());
+                this->invalid_ = true;
+                return false;
+            }
+            const std::string& long_flag = slot->long_flag;
+            if (!long_flag.empty() && (long_flag.size() < 3 || long_flag[0] != '-' || long_flag[1] != '-' || long_flag[2] == '-'
+                || long_flag.find('=') != std::string::npos || mstr::split(long_flag)[0] != long_flag))
+            {
+                mprintfE("Invalid long flag:%s!\n", long_flag.c_str());
+                this->invalid_ = true;
+                return false;
+            }
+            for (const mstr::StrView& key : this->flag_keys_)
+            {
+                if (key == short_flag || key == long_flag)
+                {
+                    mprintfE("Found duplicate option flag:%s!\n", key.str().c_str());
+                    this->invalid_ = true;
+                    return false;
+                }
+            }
+
+            const int slot_id = (int)this->slots_.size();
+            this->slots_.emplace_back(std::move(holder));
+            if (!short_flag.empty())
+            {
+                this->flag_keys_.emplace_back(short_flag);
+                this->flag_slot_ids_.push_back(slot_id);
+            }
+            if (!long_flag.empty())
+            {
+                this->flag_keys_.emplace_back(long_flag);
+                this->flag_slot_ids_.push_back(slot_id);
+            }
+            this->table_dirty_ = true;
+            return true;
+        }
+
+        /*  两级哈希构建完美哈希表：第一级按种子0把标志分到约N/2个桶中，再从大到小为每个桶寻找第二级种子，
+            使桶内的标志都落在表的空位上。表的大小为不小于2N的2的幂，只在极少数找不到种子时扩大   */
+        _MINE_INLINE void OptionRegistry::buildFlagTable()
+        {
+            const size_t key_count = this->flag_keys_.size();
+            size_t bucket_count = 1;
+            while (bucket_count * 2 < key_count)
+                bucket_count <<= 1;
+            size_t table_size = 8;
+            while (table_size < key_count * 2)
+                table_size <<= 1;
+
+            std::vector<std::vector<int>> buckets(bucket_count);
+            for (size_t k = 0; k < key_count; k++)
+                buckets[mio::_hashFlag(this->flag_keys_[k], 0) & (bucket_count - 1)].push_back((int)k);
+            std::vector<size_t> order(bucket_count);
+            for (size_t b = 0; b < bucket_count; b++)
+                order[b] = b;
+            std::stable_sort(order.begin(), order.end(), [&buckets](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+            this->flag_bucket_mask_ = uint32_t(bucket_count - 1);
+            std::vector<size_t> placed;
+            bool built = false;
+            while (!built)
+            {
+                this->flag_table_.assign(table_size, -1);
+                this->flag_seeds_.assign(bucket_count, 0);
+                this->flag_mask_ = uint32_t(table_size - 1);
+                built = true;
+                for (size_t b : order)
+                {
+                    const std::vector<int>& bucket = buckets[b];
+                    if (bucket.empty())
+                        break;
+                    bool found = false;
+                    for (uint32_t seed = 1; seed <= 4096 && !found; seed++)
+                    {
+                        found = true;
+                        placed.clear();
+                        for (int k : bucket)
+                        {
+                            const size_t pos = mio::_hashFlag(this->flag_keys_[k], seed) & this->flag_mask_;
+                            if (this->flag_table_[pos] >= 0)
+                            {
+                                found = false;
+                                break;
+                            }
+                            this->flag_table_[pos] = k;
+                            placed.push_back(pos);
+                        }
+                        if (found)
+                            this->flag_seeds_[b] = seed;
+                        else
+                        {
+                            for (size_t pos : placed)
+                                this->flag_table_[pos] = -1;
+                        }
+                    }
+                    if (!found)
+                    {
+                        built = false;
+                        break;
+                    }
+                }
+                table_size <<= 1;
+            }
+        }
+
+        _MINE_INLINE int OptionRegistry::findSlot(mstr::StrView flag) const
+        {
+            if (this->flag_table_.empty())
+                return -1;
+            const uint32_t seed = this->flag_seeds_[mio::_hashFlag(flag, 0) & this->flag_bucket_mask_];
+            const int key_id = this->flag_table_[mio::_hashFlag(flag, seed) & this->flag_mask_];
+            if (key_id < 0 || this->flag_keys_[key_id] != flag)
+                return -1;
+            return this->flag_slot_ids_[key_id];
+        }
+
+        _MINE_INLINE int OptionRegistry::assignValue(int slot_id, mstr::StrView flag, mstr::StrView value)
+        {
+            _OptionSlot& slot = *this->slots_[slot_id];
+            if (slot.assign(value) != 0)
+            {
+                mprintfE("Invalid value \"%s\" for option:%s!\n", value.str().c_str(), flag.str().c_str());
+                return -1;
+            }
+            slot.is_set = true;
+            return 0;
+        }
+
+        _MINE_INLINE int OptionRegistry::parse(int argc, char* argv[])
+        {
+            if (this->invalid_)
+            {
+                mprintfE("Some options failed to be added, please check the previous errors!\n");
+                return -1;
+            }
+            if (this->table_dirty_)
+            {
+                this->buildFlagTable();
+                this->table_dirty_ = false;
+            }
+            for (auto& slot : this->slots_)
+            {
+                slot->reset();
+                slot->is_set = false;
+            }
+            this->positional_args_.clear();
+            if (argc < 1 || argv == nullptr)
+            {
+                mprintfWLimited("Wrong value of argc:%d!\n", argc);
+                return -1;
+            }
+
+            //值选项的下一个参数是已定义的标志时，视为缺少值
+            auto is_flag_arg = [this](mstr::StrView arg) {
+                return this->findSlot(arg) >= 0 || (mstr::startsWith(arg, "--") && this->findSlot(arg.substr(0, arg.find('='))) >= 0);
+            };
+            bool only_positional = false;
+            for (int i = 1; i < argc; i++)
+            {
+                mstr::StrView arg(argv[i]);
+                if (only_positional || arg.size() < 2 || arg[0] != '-')
+                {
+                    this->positional_args_.emplace_back(arg.data(), arg.size());
+                    continue;
+                }
+                if (arg.size() == 2 && arg[1] == '-')
+                {
+                    only_positional = true;
+                    continue;
+                }
+
+                if (arg[1] == '-')
+                {
+                    const size_t eq_pos = arg.find('=');
+                    mstr::StrView flag = arg.substr(0, eq_pos);
+                    const int slot_id = this->findSlot(flag);
+                    if (slot_id < 0)
+                    {
+                        mprintfW("Unknown option:%s!\n", argv[i]);
+                        continue;
+                    }
+                    if (eq_pos != std::string::npos)
+                    {
+                        if (this->assignValue(slot_id, flag, arg.substr(eq_pos + 1)) != 0)
+                            return -1;
+                    }
+                    else if (this->slots_[slot_id]->is_flag)
+                        this->assignValue(slot_id, flag, "true");
+                    else if (i + 1 < argc && !is_flag_arg(argv[i + 1]))
+                    {
+                        if (this->assignValue(slot_id, flag, argv[++i]) != 0)
+                            return -1;
+                    }
+                    else
+                    {
+                        mprintfE("Missing value for option:%s!\n", argv[i]);
+                        return -1;
+                    }
+                    continue;
+                }
+
+                //未定义的短标志形式的负数视为位置参数
+                double number = 0;
+                if (this->findSlot(arg.substr(0, 2)) < 0 && mstr::parse(arg, number) == 0)
+                {
+                    this->positional_args_.emplace_back(arg.data(), arg.size());
+                    continue;
+                }
+                for (size_t j = 1; j < arg.size(); j++)
+                {
+                    const char flag_chars[2] = { '-', arg[j] };
+                    mstr::StrView flag(flag_chars, 2);
+                    const int slot_id = this->findSlot(flag);
+                    if (slot_id < 0)
+                    {
+                        mprintfW("Unknown option:-%c in %s!\n", arg[j], argv[i]);
+                        break;
+                    }
+                    if (this->slots_[slot_id]->is_flag)
+                    {
+                        this->assignValue(slot_id, flag, "true");
+                        continue;
+                    }
+                    //值选项之后的字符作为它的值，没有时取下一个参数
+                    if (j + 1 < arg.size())
+                    {
+                        if (this->assignValue(slot_id, flag, arg.substr(j + 1)) != 0)
+                            return -1;
+                    }
+                    else if (i + 1 < argc && !is_flag_arg(argv[i + 1]))
+                    {
+                        if (this->assignValue(slot_id, flag, argv[++i]) != 0)
+                            return -1;
+                    }
+                    else
+                    {
+                        mprintfE("Missing value for option:%s!\n", flag.str().c_str());
+                        return -1;
+                    }
+                    break;
+                }
+            }
+
+            for (auto& slot : this->slots_)
+            {
+                if (slot->required && !slot->is_set)
+                {
+                    mprintfE("Missing required option:%s!\n", this->flagPart(*slot).c_str());
+                    return -1;
+                }
+            }
+            return 0;
+        }
+
+        _MINE_INLINE const std::vector<std::string>& OptionRegistry::positionalArgs() const
+        {
+            return this->positional_args_;
+        }
+
+        _MINE_INLINE std::string OptionRegistry::flagPart(const _OptionSlot& slot) const
+        {
+            if (slot.short_flag.empty() || slot.long_flag.empty())
+                return slot.short_flag + slot.long_flag;
+            return slot.short_flag + ", " + slot.long_flag;
+        }
+
+        _MINE_INLINE void OptionRegistry::printPreset() const
+        {
+            size_t max_flag_size = 0;
+            for (auto& slot : this->slots_)
+                max_flag_size = std::max(max_flag_size, this->flagPart(*slot).size());
+            if (!this->slots_.empty())
+                printf("Preset Options:\n");
+            for (auto& slot : this->slots_)
+            {
+                std::string flag_part = this->flagPart(*slot);
+                flag_part.resize(max_flag_size, ' ');
+                std::string value_part = slot->is_flag ? "" : slot->required ? "(Required)" : "(Default: " + slot->default_str + ")";
+                std::string type_part = slot->is_flag ? "" : "<" + slot->type_name + "> ";
+                printf("    %s    %s%s %s\n", flag_part.c_str(), type_part.c_str(), slot->description.empty() ? "" : ("[Description] " + slot->description).c_str(), value_part.c_str());
+            }
+            printf("\n");
+        }
+
+        _MINE_INLINE void OptionRegistry::printParsed() const
+        {
+            size_t max_flag_size = 0;
+            for (auto& slot : this->slots_)
+                max_flag_size = std::max(max_flag_size, this->flagPart(*slot).size());
+            if (!this->slots_.empty())
+                printf("Parsed Options:\n");
+            for (auto& slot : this->slots_)
+            {
+                std::string flag_part = this->flagPart(*slot);
+                flag_part.resize(max_flag_size, ' ');
+                printf("    %s    Value: %s\n", flag_part.c_str(), slot->valueStr().c_str());
+            }
+            printf("\n");
+        }
+#endif
+    }
 
 
 #ifdef MINEUTILS_TEST_MODULES
@@ -531,6 +1930,189 @@ namespace mineutils
         }
 
 
+        inline void printBufferTest()
+        {
+            std::ostringstream captured;
+            std::streambuf* cout_buf = std::cout.rdbuf(captured.rdbuf());
+
+            mio::print(1, "a", 2.5, std::vector<int>({ 1, 2 }));
+            std::string ret0 = captured.str();
+            if (!(ret0 == "1 a 2.5 {1, 2} \n")) mprintfE(R"(Failed when check: mio::print(1, "a", 2.5, std::vector<int>({ 1, 2 })))""\n");
+
+            captured.str("");
+            std::cout << std::fixed << std::setprecision(2);
+            mio::print(2.5, std::vector<double>({ 1.0 }));
+            std::cout.flags(std::ios_base::skipws | std::ios_base::dec);
+            std::cout.precision(6);
+            ret0 = captured.str();
+            if (!(ret0 == "2.50 {1.00} \n")) mprintfE(R"(Failed when check: mio::print with std::fixed << std::setprecision(2))""\n");
+
+            captured.str("");
+            mio::setPrintFlushPolicy(mio::flush_by_size, 1 << 20);
+            mio::print("buffered");
+            bool ret1 = captured.str().empty();
+            if (!ret1) mprintfE(R"(Failed when check: mio::setPrintFlushPolicy(mio::flush_by_size, 1 << 20))""\n");
+            mio::flushPrint();
+            ret0 = captured.str();
+            if (!(ret0 == "buffered \n")) mprintfE(R"(Failed when check: mio::flushPrint())""\n");
+
+            captured.str("");
+            int ret2 = mio::startAsyncPrint(256);
+            if (!(ret2 == 0)) mprintfE(R"(Failed when check: mio::startAsyncPrint(256))""\n");
+            std::vector<std::thread> threads;
+            for (int i = 0; i < 4; i++)
+            {
+                threads.emplace_back([i]()
+                    {
+                        for (int j = 0; j < 500; j++)
+                            mio::print("thread", i, "line", j);
+                    });
+            }
+            for (auto& t : threads)
+                t.join();
+            mio::stopAsyncPrint();
+            std::vector<std::string> lines = mstr::split(captured.str(), "\n");
+            ret1 = lines.size() == 2001 && lines.back().empty();
+            std::vector<int> next_j(4, 0);
+            for (size_t k = 0; ret1 && k + 1 < lines.size(); k++)
+            {
+                std::vector<std::string> words = mstr::split(lines[k]);
+                int i = 0, j = 0;
+                ret1 = words.size() == 4 && words[0] == "thread" && mstr::parse(words[1], i) == 0 && mstr::parse(words[3], j) == 0 && i >= 0 && i < 4 && next_j[i] == j;
+                if (ret1)
+                    next_j[i]++;
+            }
+            if (!ret1) mprintfE(R"(Failed when check: mio::startAsyncPrint multithread order)""\n");
+
+            captured.str("");
+            mio::setPrintFlushPolicy(mio::flush_by_interval, 10);
+            mio::startAsyncPrint();
+            mio::print("interval");
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            mio::stopAsyncPrint();
+            ret0 = captured.str();
+            if (!(ret0 == "interval \n")) mprintfE(R"(Failed when check: mio::setPrintFlushPolicy(mio::flush_by_interval, 10))""\n");
+
+            mio::setPrintFlushPolicy(mio::flush_by_line);
+            std::cout.rdbuf(cout_buf);
+        }
+
+        //operator<<中再次调用printTo，内层打印超长行使线程内的缓冲区被重建
+        struct _NestedPrintArg
+        {
+            std::string* sink;
+        };
+        inline std::ostream& operator<<(std::ostream& os, const _NestedPrintArg& arg)
+        {
+            mio::printTo(*arg.sink, std::string(100 << 10, 'z'));
+            return os << "nested";
+        }
+
+        inline void printToTest()
+        {
+            std::string str_sink;
+            int ret0 = mio::printTo(str_sink, "a", 1, std::vector<int>({ 1, 2 }));
+            bool ret1 = ret0 == 0 && str_sink == "a 1 {1, 2} \n";
+            if (!ret1) mprintfE(R"(Failed when check: mio::printTo(str_sink, "a", 1, std::vector<int>({ 1, 2 })))""\n");
+
+            mstr::StringBuilder builder_sink;
+            mio::printTo(builder_sink, 2.5, 'c');
+            ret1 = std::string(builder_sink.data(), builder_sink.size()) == "2.5 c \n";
+            if (!ret1) mprintfE(R"(Failed when check: mio::printTo(builder_sink, 2.5, 'c'))""\n");
+
+            std::ostringstream os_sink;
+            os_sink << std::fixed << std::setprecision(1);
+            mio::printTo(os_sink, 2.25, "x");
+            ret1 = os_sink.str() == "2.2 x \n" || os_sink.str() == "2.3 x \n";
+            if (!ret1) mprintfE(R"(Failed when check: mio::printTo(os_sink, 2.25, "x"))""\n");
+
+            FILE* fp = tmpfile();
+            if (fp != nullptr)
+            {
+                mio::printTo(fp, "file", 1);
+                fflush(fp);
+                mio::printTo(mio::FdSink(fileno(fp)), "fd", 2);
+                rewind(fp);
+                char buf[64] = { 0 };
+                size_t len = fread(buf, 1, sizeof(buf) - 1, fp);
+                ret1 = std::string(buf, len) == "file 1 \nfd 2 \n";
+                if (!ret1) mprintfE(R"(Failed when check: mio::printTo(fp/FdSink))""\n");
+                fclose(fp);
+            }
+
+            mio::PrintRingBuffer ring(16);
+            mio::printTo(ring, "line", 1);
+            mio::printTo(ring, "line", 2);
+            ret1 = ring.str() == "line 1 \nline 2 \n";
+            if (!ret1) mprintfE(R"(Failed when check: mio::PrintRingBuffer before overwrite)""\n");
+            mio::printTo(ring, "line", 3);
+            ret1 = ring.str() == "line 2 \nline 3 \n" && ring.size() == 16;
+            if (!ret1) mprintfE(R"(Failed when check: mio::PrintRingBuffer after overwrite:%s)""\n", ring.str().c_str());
+            mio::printTo(ring, "line", 4);
+            ret1 = ring.str() == "line 3 \nline 4 \n";
+            if (!ret1) mprintfE(R"(Failed when check: mio::PrintRingBuffer after overwrite:%s)""\n", ring.str().c_str());
+            mio::printTo(ring, "x");
+            ret1 = ring.str() == "line 4 \nx \n";
+            if (!ret1) mprintfE(R"(Failed when check: mio::PrintRingBuffer partial line:%s)""\n", ring.str().c_str());
+            mio::printTo(ring, "a long line longer than capacity");
+            ret1 = ring.str() == " than capacity \n";
+            if (!ret1) mprintfE(R"(Failed when check: mio::PrintRingBuffer long line:%s)""\n", ring.str().c_str());
+            ring.clear();
+            ret1 = ring.size() == 0 && ring.str().empty();
+            if (!ret1) mprintfE(R"(Failed when check: mio::PrintRingBuffer::clear)""\n");
+
+            //dumpTo与并发写入交错时，每一行要么被导出，要么留在缓冲区中
+            FILE* dump_fp = tmpfile();
+            if (dump_fp != nullptr)
+            {
+                mio::PrintRingBuffer dump_ring(1 << 16);
+                std::atomic<bool> writing(true);
+                std::thread writer([&dump_ring, &writing]()
+                    {
+                        for (int i = 0; i < 20000; i++)
+                            dump_ring.write("w\n", 2);
+                        writing.store(false);
+                    });
+                ret1 = true;
+                while (writing.load())
+                    ret1 = dump_ring.dumpTo(dump_fp) == 0 && ret1;
+                writer.join();
+                ret1 = dump_ring.dumpTo(dump_fp) == 0 && ret1;
+                ret1 = ret1 && ftell(dump_fp) == 40000;
+                if (!ret1) mprintfE(R"(Failed when check: mio::PrintRingBuffer::dumpTo keeps lines written concurrently)""\n");
+                fclose(dump_fp);
+            }
+
+            std::string outer, inner, other_thread;
+            {
+                mio::ScopedPrintCapture capture(outer);
+                mio::print("outer", 1);
+                {
+                    mio::ScopedPrintCapture nested_capture(inner);
+                    mio::print("inner");
+                }
+                std::thread t([&other_thread]()
+                    {
+                        mio::ScopedPrintCapture thread_capture(other_thread);
+                        mio::print("thread");
+                    });
+                t.join();
+                mio::print("outer", 2);
+            }
+            ret1 = outer == "outer 1 \nouter 2 \n" && inner == "inner \n" && other_thread == "thread \n";
+            if (!ret1) mprintfE(R"(Failed when check: mio::ScopedPrintCapture)""\n");
+
+            std::string nested_outer, nested_inner;
+            _NestedPrintArg nested_arg = { &nested_inner };
+            mio::printTo(nested_outer, "before", nested_arg, "after");
+            {
+                mio::ScopedPrintCapture capture(nested_outer);
+                mio::print("print", nested_arg);
+            }
+            ret1 = nested_outer == "before nested after \nprint nested \n" && nested_inner.size() == 2 * ((100 << 10) + 2);
+            if (!ret1) mprintfE(R"(Failed when check: nested mio::printTo in operator<< of an argument)""\n");
+        }
+
         inline void parseArgsTest()
         {
             std::vector<char*> argv_vec;
@@ -597,11 +2179,104 @@ namespace mineutils
             if (ret0 == 0) mprintfE(R"(Failed when check: parser.parse(argv_vec.size(), argv_vec.data(), { }, { {"-A ", "-AA", "value1", "111"} }))""\n");
         }
 
+        enum class _OptionTestMode
+        {
+            fast,
+            safe
+        };
+
+        inline void optionRegistryTest()
+        {
+            std::vector<const char*> argv_vec = { "demo", "-vn", "8", "--rate=0.5", "input.txt", "--mode", "fast", "-l1,2", "--list", "3",
+                "--name", "abc", "-t-3", "--quiet=false", "--", "-x" };
+            mio::OptionRegistry options;
+            auto verbose = options.addFlag("-v", "--verbose", "print more logs");
+            auto quiet = options.addFlag("-q", "--quiet", "");
+            auto num = options.addOption<int>("-n", "--num", "number of workers", 4);
+            auto rate = options.addOption("-r", "--rate", "sample rate", 1.0);
+            auto name = options.addOption("", "--name", "task name", "default", true);
+            auto offset = options.addOption<long long>("-t", "", "time offset", 0);
+            auto output = options.addOption("-o", "--output", "output path", "out.txt");
+            auto mode = options.addEnumOption<_OptionTestMode>("-m", "--mode", "run mode", { {"fast", _OptionTestMode::fast}, {"safe", _OptionTestMode::safe} }, _OptionTestMode::safe);
+            auto list = options.addListOption<int>("-l", "--list", "id list", { 9 });
+            int ret0 = options.parse((int)argv_vec.size(), (char**)argv_vec.data());
+            if (!(ret0 == 0)) mprintfE(R"(Failed when check: options.parse)""\n");
+
+            bool ret1 = *verbose && verbose.isSet() && !*quiet && quiet.isSet() && *num == 8 && *rate == 0.5 && *name == "abc" && *offset == -3;
+            ret1 = ret1 && *output == "out.txt" && !output.isSet() && *mode == _OptionTestMode::fast && *list == std::vector<int>({ 1, 2, 3 }) && list->size() == 3;
+            ret1 = ret1 && options.positionalArgs() == std::vector<std::string>({ "input.txt", "-x" });
+            if (!ret1) mprintfE(R"(Failed when check: OptionRegistry parsed values)""\n");
+
+            printf("User check:\n");
+            options.printPreset();
+            options.printParsed();
+
+            //重新解析时恢复默认值
+            std::vector<const char*> argv_vec2 = { "demo", "--name", "x", "-5" };
+            ret0 = options.parse((int)argv_vec2.size(), (char**)argv_vec2.data());
+            ret1 = ret0 == 0 && !*verbose && !verbose.isSet() && *num == 4 && *list == std::vector<int>({ 9 }) && options.positionalArgs() == std::vector<std::string>({ "-5" });
+            if (!ret1) mprintfE(R"(Failed when check: OptionRegistry reparse)""\n");
+
+            printf("User check:\n");
+            std::vector<const char*> argv_vec3 = { "demo", "--name", "x", "-n", "abc" };
+            ret0 = options.parse((int)argv_vec3.size(), (char**)argv_vec3.data());
+            if (ret0 == 0) mprintfE(R"(Failed when check: options.parse with invalid int)""\n");
+            std::vector<const char*> argv_vec4 = { "demo", "-n", "3" };
+            ret0 = options.parse((int)argv_vec4.size(), (char**)argv_vec4.data());
+            if (ret0 == 0) mprintfE(R"(Failed when check: options.parse without required option)""\n");
+            std::vector<const char*> argv_vec5 = { "demo", "--name", "--num", "3" };
+            ret0 = options.parse((int)argv_vec5.size(), (char**)argv_vec5.data());
+            if (ret0 == 0) mprintfE(R"(Failed when check: options.parse with missing value)""\n");
+            std::vector<const char*> argv_vec6 = { "demo", "--name", "x", "--mode", "slow" };
+            ret0 = options.parse((int)argv_vec6.size(), (char**)argv_vec6.data());
+            if (ret0 == 0) mprintfE(R"(Failed when check: options.parse with invalid enum)""\n");
+
+            mio::OptionRegistry bad_options;
+            auto bad = bad_options.addFlag("-vv", "", "");
+            bad_options.addFlag("-a", "", "");
+            auto dup = bad_options.addOption<int>("-a", "--aa", "", 1);
+            ret1 = !bad.valid() && !dup.valid() && bad_options.parse((int)argv_vec2.size(), (char**)argv_vec2.data()) != 0;
+            if (!ret1) mprintfE(R"(Failed when check: OptionRegistry invalid flags)""\n");
+
+            //较多标志时完美哈希表仍能区分全部标志
+            mio::OptionRegistry many_options;
+            std::vector<mio::OptionHandle<int>> handles;
+            std::vector<std::string> many_args = { "demo" };
+            for (int i = 0; i < 1000; i++)
+            {
+                handles.push_back(many_options.addOption<int>("", "--opt" + mstr::toStr(i), "", -1));
+                many_args.push_back("--opt" + mstr::toStr(i) + "=" + mstr::toStr(i * 2));
+            }
+            std::vector<char*> many_argv;
+            for (auto& arg : many_args)
+                many_argv.push_back(&arg[0]);
+            ret0 = many_options.parse((int)many_argv.size(), many_argv.data());
+            ret1 = ret0 == 0;
+            for (int i = 0; i < 1000 && ret1; i++)
+                ret1 = *handles[i] == i * 2;
+            if (!ret1) mprintfE(R"(Failed when check: OptionRegistry with 1000 options)""\n");
+
+            //uint8_t和int8_t按整数解析，而不是当作单个字符
+            mio::OptionRegistry byte_options;
+            auto level = byte_options.addOption<uint8_t>("-n", "--level", "", 4);
+            auto delta = byte_options.addOption<int8_t>("-d", "", "", 0);
+            std::vector<const char*> byte_argv = { "demo", "-n", "12", "-d-7" };
+            ret0 = byte_options.parse((int)byte_argv.size(), (char**)byte_argv.data());
+            ret1 = ret0 == 0 && *level == 12 && *delta == -7 && mio::_optionValueToStr(*level) == "12" && mio::_optionValueToStr(uint8_t(4)) == "4";
+            printf("User check! Expect an error about the value 300:\n");
+            std::vector<const char*> byte_argv2 = { "demo", "--level", "300" };
+            ret1 = ret1 && byte_options.parse((int)byte_argv2.size(), (char**)byte_argv2.data()) != 0;
+            if (!ret1) mprintfE(R"(Failed when check: OptionRegistry parses uint8_t and int8_t as integers)""\n");
+        }
+
         inline void check()
         {
             printf("\n--------------------check mio start--------------------\n");
             printTest();
+            printBufferTest();
+            printToTest();
             parseArgsTest();
+            optionRegistryTest();
             printf("---------------------check mio end---------------------\n\n");
         }
     }
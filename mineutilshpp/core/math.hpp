@@ -658,7 +658,8 @@ namespace mineutils
 
 
 
-        inline const std::vector<double>& PolynomialFitter2D::fit(const std::set<double>& x_list, const std::vector<double>& y_list, uint8_t degree)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE const std::vector<double>& PolynomialFitter2D::fit(const std::set<double>& x_list, const std::vector<double>& y_list, uint8_t degree)
         {
             this->coeffs_.clear();
             if (x_list.size() != y_list.size())
@@ -719,12 +720,12 @@ namespace mineutils
             return this->coeffs_;
         }
 
-        inline double PolynomialFitter2D::evaluate(double x)
+        _MINE_INLINE double PolynomialFitter2D::evaluate(double x)
         {
             double y = 0;
             if (this->coeffs_.empty())
             {
-                mprintfW("Call fit first!\n");
+                mprintfWLimited("Call fit first!\n");
                 return 0.0;
             }
             uint8_t now_degree = static_cast<uint8_t>(this->coeffs_.size() - 1);
@@ -735,7 +736,7 @@ namespace mineutils
             return y;
         }
 
-        inline double PolynomialFitter2D::pow(double x, uint8_t degree)
+        _MINE_INLINE double PolynomialFitter2D::pow(double x, uint8_t degree)
         {
             double y = 1;
             while (degree > 0)
@@ -745,6 +746,7 @@ namespace mineutils
             }
             return y;
         }
+#endif
 
     }
 
@@ -21,6 +21,7 @@
 #endif
 
 #include"base.hpp"
+#include"str.hpp"
 #include"type.hpp"
 
 
@@ -104,60 +105,58 @@ namespace mineutils
         bool _remove(const std::string& path);
         std::vector<std::string> _walk(const std::string& path, bool return_path);
 
-        inline std::string normPath(std::string path)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE std::string normPath(std::string path)
         {
-            size_t pos;
-            while (path.find("\\") != std::string::npos)
+            if (mstr::contains(path, "\\"))
+                path = mstr::replace(path, "\\", "/");
+            //单次扫描合并连续的/并把/./变为/，结果与反复查找替换直到不再出现相同
+            size_t len = 0;
+            for (size_t i = 0; i < path.size(); i++)
             {
-                pos = path.find("\\");
-                path.replace(pos, 1, "/");
-            }
-            while (path.find("//") != std::string::npos)
-            {
-                pos = path.find("//");
-                path.replace(pos, 2, "/");
-            }
-            while (path.find("/./") != std::string::npos)
-            {
-                pos = path.find("/./");
-                path.replace(pos, 3, "/");
-            }
-            if (path.find("./") == 0)
-            {
-                path.replace(0, 2, "");
+                const char c = path[i];
+                if (c == '/' && len > 0 && path[len - 1] == '/')
+                    continue;
+                if (c == '/' && len > 1 && path[len - 1] == '.' && path[len - 2] == '/')
+                {
+                    len--;
+                    continue;
+                }
+                path[len++] = c;
             }
+            path.resize(len);
+
+            if (mstr::startsWith(path, "./"))
+                path.erase(0, 2);
             if (path.empty())
                 return ".";
-            if (path.rfind("/.") != std::string::npos and path.rfind("/.") == path.size() - 2)
-            {
-                pos = path.rfind("/.");
-                path.replace(pos + 1, 1, "");
-            }
-            if (path.rfind("/") == path.size() - 1)
+            if (mstr::endsWith(path, "/."))
+                path.erase(path.size() - 1);
+            if (mstr::endsWith(path, "/"))
             {
-                if (path.find(":/") == 1 and path.size() > 4)
-                    path.replace(path.size() - 1, 1, "");
-                else if (path.find(":/") == std::string::npos and path.size() > 1)
-                    path.replace(path.size() - 1, 1, "");
+                if (path.find(":/") == 1 && path.size() > 4)
+                    path.erase(path.size() - 1);
+                else if (path.find(":/") == std::string::npos && path.size() > 1)
+                    path.erase(path.size() - 1);
             }
             return path;
         }
 
-        inline bool exists(std::string path)
+        _MINE_INLINE bool exists(std::string path)
         {
             return mpath::_exists(mpath::normPath(std::move(path)));
         }
-        inline bool _exists(const std::string& path)
+        _MINE_INLINE bool _exists(const std::string& path)
         {
             struct ::stat buffer;
             return ::stat(path.c_str(), &buffer) == 0;
         }
 
-        inline std::string splitName(std::string path, bool need_extension)
+        _MINE_INLINE std::string splitName(std::string path, bool need_extension)
         {
             return mpath::_splitName(mpath::normPath(std::move(path)), need_extension);
         }
-        inline std::string _splitName(const std::string& path, bool need_extension)
+        _MINE_INLINE std::string _splitName(const std::string& path, bool need_extension)
         {
             std::string name;
             if (need_extension)
@@ -173,11 +172,11 @@ namespace mineutils
             return name;
         }
 
-        inline std::string splitExt(std::string path)
+        _MINE_INLINE std::string splitExt(std::string path)
         {
             return mpath::_splitExt(mpath::normPath(std::move(path)));
         }
-        inline std::string _splitExt(const std::string& path)
+        _MINE_INLINE std::string _splitExt(const std::string& path)
         {
             auto name_pos = path.rfind('/') + 1;
             auto point_pos = path.rfind('.');
@@ -189,47 +188,50 @@ namespace mineutils
             return "";
         }
 
-        inline bool isAbs(std::string path)
+        _MINE_INLINE bool isAbs(std::string path)
         {
             return mpath::_isAbs(mpath::normPath(std::move(path)));
         }
-        inline bool _isAbs(const std::string& path)
+        _MINE_INLINE bool _isAbs(const std::string& path)
         {
             return path.find(":/") == 1 || path.substr(0, 1) == "/";
         }
 
-        inline bool isDir(std::string path)
+        _MINE_INLINE bool isDir(std::string path)
         {
             return mpath::_isDir(mpath::normPath(std::move(path)));
         }
-        inline bool _isDir(const std::string& path)
+        _MINE_INLINE bool _isDir(const std::string& path)
         {
             struct ::stat buffer;
             return ::stat(path.c_str(), &buffer) == 0 && (buffer.st_mode & S_IFDIR);
         }
 
-        inline bool isFile(std::string path)
+        _MINE_INLINE bool isFile(std::string path)
         {
             return mpath::_isFile(mpath::normPath(std::move(path)));
         }
-        inline bool _isFile(const std::string& path)
+        _MINE_INLINE bool _isFile(const std::string& path)
         {
             struct ::stat buffer;
             return ::stat(path.c_str(), &buffer) == 0 && (buffer.st_mode & S_IFREG);
         }
-        inline bool isFileMatchExts(std::string path, const std::set<std::string>& file_exts)
+        _MINE_INLINE bool isFileMatchExts(std::string path, const std::set<std::string>& file_exts)
         {
             return mpath::_isFileMatchExts(mpath::normPath(std::move(path)), file_exts);
         }
-        inline bool _isFileMatchExts(const std::string& path, const std::set<std::string>& file_exts)
+        _MINE_INLINE bool _isFileMatchExts(const std::string& path, const std::set<std::string>& file_exts)
         {
             return mpath::_isFile(path) && file_exts.find(mpath::_splitExt(path)) != file_exts.end();
         }
 
-        inline std::string _joinBranch(const std::string& path)
+        _MINE_INLINE std::string _joinBranch(const std::string& path)
         {
             return path;
         }
+#else
+        std::string _joinBranch(const std::string& path);
+#endif
         template<class... Strs>
         inline std::string _joinBranch(const std::string& path1, const std::string& path2, const Strs&... paths)
         {
@@ -249,12 +251,15 @@ namespace mineutils
             return mpath::_joinBranch(path1, path2, paths...);
         }
 
-        inline std::vector<std::string> listDir(std::string path, bool return_path, const std::set<std::string>& ignore_names)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE std::vector<std::string> listDir(std::string path, bool return_path, const std::set<std::string>& ignore_names)
         {
             return mpath::_listDir(mpath::normPath(std::move(path)), return_path, ignore_names);
         }
+#endif
 #if defined(_MSC_VER)
-        inline std::vector<std::string> _listDir(const std::string& path, bool return_path, const std::set<std::string>& ignore_names)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE std::vector<std::string> _listDir(const std::string& path, bool return_path, const std::set<std::string>& ignore_names)
         {
             intptr_t hFile = 0;
             struct _finddata_t fileinfo;
@@ -263,7 +268,7 @@ namespace mineutils
 
             if (!mpath::_isDir(path))
             {
-                mprintfW("The input path:%s is not a folder or does not exist. Please check it!\n", path.c_str());
+                mprintfWLimited("The input path:%s is not a folder or does not exist. Please check it!\n", path.c_str());
                 return {};
             }
             if ((hFile = _findfirst(p.append("/*").c_str(), &fileinfo)) != std::string::npos)
@@ -286,8 +291,10 @@ namespace mineutils
             }
             return files;
         }
+#endif
 #else
-        inline std::vector<std::string> _listDir(const std::string& path, bool return_path, const std::set<std::string>& ignore_names)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE std::vector<std::string> _listDir(const std::string& path, bool return_path, const std::set<std::string>& ignore_names)
         {
             ::DIR* pDir;
             struct ::dirent* ptr;
@@ -295,7 +302,7 @@ namespace mineutils
 
             if (!mpath::_isDir(path))
             {
-                mprintfW("The input path:%s is not a folder or does not exist. Please check it!\n", path.c_str());
+                mprintfWLimited("The input path:%s is not a folder or does not exist. Please check it!\n", path.c_str());
                 return {};
             }
             pDir = ::opendir(path.c_str());
@@ -314,14 +321,18 @@ namespace mineutils
             ::closedir(pDir);
             return files;
         }
+#endif
 
 #endif
-        inline bool makeDirs(std::string path)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE bool makeDirs(std::string path)
         {
             return mpath::_makeDirs(mpath::normPath(std::move(path)));
         }
+#endif
 #if defined(_MSC_VER)
-        inline bool _makeDirs(const std::string& path)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE bool _makeDirs(const std::string& path)
         {
             if (mpath::_exists(path))
                 return true;
@@ -340,8 +351,10 @@ namespace mineutils
             } while (sep_pos != std::string::npos);
             return mpath::_isDir(path);
         }
+#endif
 #else
-        inline bool _makeDirs(const std::string& path)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE bool _makeDirs(const std::string& path)
         {
             if (mpath::_exists(path))
                 return true;
@@ -357,12 +370,14 @@ namespace mineutils
             return mpath::_isDir(path);
         }
 #endif
-        inline bool makeFile(std::string path)
+#endif
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE bool makeFile(std::string path)
         {
             return mpath::_makeFile(mpath::normPath(std::move(path)));
         }
 
-        inline bool _makeFile(const std::string& path)
+        _MINE_INLINE bool _makeFile(const std::string& path)
         {
             if (mpath::_exists(path))
                 return true;
@@ -376,16 +391,16 @@ namespace mineutils
             return mpath::_isFile(path);
         }
 
-        inline std::string parent(std::string path)
+        _MINE_INLINE std::string parent(std::string path)
         {
             return mpath::_parent(mpath::normPath(std::move(path)));
         }
-        inline std::string _parent(const std::string& path)
+        _MINE_INLINE std::string _parent(const std::string& path)
         {
             return path.substr(0, path.find_last_of('/'));;
         }
 
-        inline void _removeDir(const std::string& path)
+        _MINE_INLINE void _removeDir(const std::string& path)
         {
             std::vector<std::string> listdir_res = mpath::_listDir(path, true, {});
             for (std::string& sub_path : listdir_res)
@@ -403,17 +418,17 @@ namespace mineutils
 #endif
         }
 
-        inline std::vector<std::string> walk(std::string path, bool return_path)
+        _MINE_INLINE std::vector<std::string> walk(std::string path, bool return_path)
         {
             return mpath::_walk(mpath::normPath(std::move(path)), return_path);
         }
-        inline std::vector<std::string> _walk(const std::string& path, bool return_path)
+        _MINE_INLINE std::vector<std::string> _walk(const std::string& path, bool return_path)
         {
             std::vector<std::string> filenames;
 
             if (!mpath::_isDir(path))
             {
-                mprintfW("The input path:%s is not a folder or does not exist. Please check it!\n", path.c_str());
+                mprintfWLimited("The input path:%s is not a folder or does not exist. Please check it!\n", path.c_str());
                 return {};
             }
             std::vector<std::string> listdir_res = mpath::_listDir(path, true, {});
@@ -428,6 +443,9 @@ namespace mineutils
             }
             return filenames;
         }
+#else
+        void _removeDir(const std::string& path);
+#endif
 
 
 
@@ -435,7 +453,8 @@ namespace mineutils
         {
             return mpath::_remove(mpath::normPath(std::move(path)));
         }
-        inline bool _remove(const std::string& path)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE bool _remove(const std::string& path)
         {
             if (mpath::_isDir(path))
             {
@@ -447,6 +466,7 @@ namespace mineutils
             }
             return !mpath::_exists(path);
         }
+#endif
     }
 
 
@@ -6,14 +6,21 @@
 #include<algorithm>
 #include<array>
 #include<atomic>
+#include<cmath>
 #include<deque>
+#include<errno.h>
 #include<exception>
+#include<float.h>
 #include<forward_list>
 #include<initializer_list>
 #include<iomanip>
 #include<iostream>
+#include<limits>
 #include<list>
+#include<locale.h>
 #include<map>
+#include<math.h>
+#include<memory>
 #include<mutex>
 #include<queue>
 #include<set>
@@ -24,6 +31,11 @@
 #include<unordered_map>
 #include<unordered_set>
 #include<vector>
+//x86-64默认带SSE2，此时按空白字符查找时每次比较16字节，其他平台使用标量实现
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include<emmintrin.h>
+#define _MINE_SIMD_SSE2
+#endif
 
 #include"base.hpp"
 #include"type.hpp"
@@ -36,7 +48,7 @@ namespace mineutils
     namespace mstr
     {
         /*  将输入转换为std::string
-            - 基于std::ostringstream实现，可以接收任意类型arg
+            - 基于std::ostringstream实现，可以接收任意类型arg；bool、字符、整数和浮点数不经过流直接转换，结果与流输出一致
             - 支持重载了std::ostream& operator<<(std::ostream&, const T&)的T对象
             - 扩展了对非volatile限定的STL容器对象的支持
             - 有无符号的char都会被当作字符处理
@@ -57,6 +69,136 @@ namespace mineutils
         template<int8_t float_precision = -1, class... Args>
         std::string format(const std::string& f_string, const Args& ...args);
 
+        //格式串中的一段：占位符前的字面量及占位符本身，raw_len为0时表示"{{"或"}}"转义，不对应参数
+        struct _FormatPiece
+        {
+            uint32_t lit_begin;
+            uint32_t lit_len;
+            uint32_t raw_begin;
+            uint32_t raw_len;
+            int32_t width;
+            int32_t precision;
+            char fill;
+            char align;
+            char type;
+        };
+
+        /*  预解析的格式串，供formatTo和fastFormat重复使用，不复制也不持有fmt，使用期间fmt必须有效
+            - 占位符格式：{[:][[fill]align][width][.precision][type]}，如"{}"、"{:.3f}"、"{:>8}"、"{:*^10}"、"{:08.2f}"
+            - align：'<'左对齐，'>'右对齐，'^'居中，width以0开头时在符号后补0；数字默认右对齐，其余默认左对齐
+            - type：整数可用d、x、X，浮点数可用f、e、g，未指定时浮点数按%g输出；字符串的precision表示最大输出长度
+            - 用"{{"和"}}"表示花括号本身，无法解析的占位符按原文输出
+            - 最多支持32个占位符，C++14及以上可以用static constexpr变量在编译期完成解析  */
+        class FormatString
+        {
+        public:
+            explicit _MINE_CONSTEXPR14 FormatString(const char* fmt);
+
+            //获取格式串
+            _MINE_CONSTEXPR14 const char* str() const;
+
+            //获取有效占位符的个数
+            _MINE_CONSTEXPR14 size_t placeholderCount() const;
+
+            _MINE_CONSTEXPR14 size_t _pieceCount() const;
+            _MINE_CONSTEXPR14 const _FormatPiece& _piece(size_t idx) const;
+            _MINE_CONSTEXPR14 size_t _tailBegin() const;
+            _MINE_CONSTEXPR14 size_t _tailLen() const;
+
+        private:
+            _MINE_CONSTEXPR14 bool parseSpec(uint32_t pos, _FormatPiece& piece, uint32_t& end_pos) const;
+
+            const char* fmt_;
+            uint32_t len_;
+            uint32_t tail_begin_;
+            uint32_t piece_count_;
+            _FormatPiece pieces_[32];
+        };
+
+        /*  按fmt格式化到buf，除不支持的类型会转调toStr外不分配堆内存，超出size的部分会被截断，buf始终以'\0'结尾
+            - 支持的类型：bool和整数、字符、浮点数、std::string和C字符串、指针，其余类型通过toStr转换
+            - 参数多于占位符时忽略多余的参数，少于占位符时剩余占位符按原文输出
+            @return 完整输出需要的长度，不含结尾的'\0'，与snprintf一致   */
+        template<class... Args>
+        size_t formatTo(char* buf, size_t size, const FormatString& fmt, const Args&... args);
+
+        //同上，fmt的解析结果按地址缓存在线程内，内容变化时会重新解析
+        template<class... Args>
+        size_t formatTo(char* buf, size_t size, const char* fmt, const Args&... args);
+
+        //按FormatString的规则格式化并返回std::string，较短的结果先写入栈上缓冲区
+        template<class... Args>
+        std::string fastFormat(const FormatString& fmt, const Args&... args);
+
+        //同上，fmt的解析结果按地址缓存在线程内，内容变化时会重新解析
+        template<class... Args>
+        std::string fastFormat(const char* fmt, const Args&... args);
+
+        class _StringBuilderStreamBuf;
+
+        /*  可追加的字符串缓冲区，用于由多段内容拼接一行字符串的场景
+            - 256字节以内的内容存放在对象内部，超出后按2倍增长到堆上，clear后保留已申请的容量以便复用
+            - append的转换规则与toStr一致，appendFormat的格式规则与fastFormat一致
+            - 不可拷贝，不可移动   */
+        class StringBuilder
+        {
+        public:
+            StringBuilder();
+            StringBuilder(const StringBuilder&) = delete;
+            StringBuilder& operator=(const StringBuilder&) = delete;
+
+            //按toStr的规则追加arg
+            template<class T>
+            StringBuilder& append(const T& arg);
+
+            //追加s的前n个字符
+            StringBuilder& append(const char* s, size_t n);
+
+            //按fastFormat的规则追加格式化后的内容
+            template<class... Args>
+            StringBuilder& appendFormat(const FormatString& fmt, const Args&... args);
+
+            //同上，fmt的解析结果按地址缓存在线程内
+            template<class... Args>
+            StringBuilder& appendFormat(const char* fmt, const Args&... args);
+
+            //获取以'\0'结尾的内容
+            const char* c_str() const;
+            const char* data() const;
+            size_t size() const;
+            bool empty() const;
+            size_t capacity() const;
+
+            //复制内容为std::string
+            std::string str() const;
+
+            //清空内容，保留容量
+            void clear();
+
+            //预留至少可容纳capacity个字符的空间
+            void reserve(size_t capacity);
+
+            //获取写入本对象的流，格式状态已重置为默认值
+            std::ostream& _stream();
+
+        private:
+            char* data_;
+            size_t size_;
+            size_t capacity_;   //可容纳的字符数，不含结尾的'\0'
+            std::unique_ptr<char[]> heap_buf_;
+            std::unique_ptr<_StringBuilderStreamBuf> stream_buf_;
+            std::unique_ptr<std::ostream> stream_;   //析构时先于stream_buf_释放
+            char inline_buf_[256];
+        };
+
+        //按toStr的规则将arg追加到out，返回out
+        template<int8_t float_precision = -1, class T>
+        StringBuilder& toStr(StringBuilder& out, const T& arg);
+
+        //按format的规则将格式化后的内容追加到out，返回out
+        template<int8_t float_precision = -1, class... Args>
+        StringBuilder& format(StringBuilder& out, const std::string& f_string, const Args& ...args);
+
         //将整数转换为序数词，1st、2nd等
         template<class T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
         std::string ordinalize(T number);
@@ -87,6 +229,199 @@ namespace mineutils
         std::string lpad(std::string s, size_t target_len, const char pad_char);
         //在字符串尾端添加字符至目标长度
         std::string rpad(std::string s, size_t target_len, const char pad_char);
+
+        /*  不持有内容的只读字符串视图，兼容C++11，使用期间被引用的字符串必须有效
+            - 可由const char*、std::string及指针加长度隐式构造，可用operator<<输出
+            - 位置参数越界时不抛出异常，substr会将其截断到末尾，查找失败时返回std::string::npos   */
+        class StrView
+        {
+        public:
+            constexpr StrView();
+            constexpr StrView(const char* data, size_t size);
+            StrView(const char* s);
+            StrView(const std::string& s);
+
+            constexpr const char* data() const;
+            constexpr size_t size() const;
+            constexpr bool empty() const;
+            constexpr const char* begin() const;
+            constexpr const char* end() const;
+            constexpr char operator[](size_t idx) const;
+
+            //获取从pos开始、长度不超过n的子视图
+            StrView substr(size_t pos, size_t n = std::string::npos) const;
+
+            //正向查找s首次出现的位置
+            size_t find(StrView s, size_t pos = 0) const;
+
+            //正向查找字符c首次出现的位置
+            size_t find(char c, size_t pos = 0) const;
+
+            //反向查找s最后一次出现的起始位置，起始位置不大于pos
+            size_t rfind(StrView s, size_t pos = std::string::npos) const;
+
+            //复制内容为std::string
+            std::string str() const;
+
+            bool operator==(StrView other) const;
+            bool operator!=(StrView other) const;
+
+        private:
+            const char* data_;
+            size_t size_;
+        };
+
+        std::ostream& operator<<(std::ostream& os, StrView s);
+
+        //同split，返回的各个StrView引用s的内容，不复制字符串
+        std::vector<StrView> splitView(StrView s, StrView sep, size_t max_split_times = -1);
+        //同rsplit，返回的各个StrView引用s的内容，不复制字符串
+        std::vector<StrView> rsplitView(StrView s, StrView sep, size_t max_split_times = -1);
+        //同按空白字符分割的split，返回的各个StrView引用s的内容，不复制字符串
+        std::vector<StrView> splitView(StrView s);
+
+        //同trim，返回引用s内容的StrView
+        StrView trimView(StrView s, const char* chars_to_remove = " \t\n\r\f\v");
+        //同ltrim，返回引用s内容的StrView
+        StrView ltrimView(StrView s, const char* chars_to_remove = " \t\n\r\f\v");
+        //同rtrim，返回引用s内容的StrView
+        StrView rtrimView(StrView s, const char* chars_to_remove = " \t\n\r\f\v");
+
+        /*  惰性分割的结果区间，每次迭代时才查找下一个分割符，不分配内存，由splitIter和rsplitIter创建
+            - 用例：for (mstr::StrView token : mstr::splitIter(line, ",")) {...}   */
+        class SplitRange
+        {
+        public:
+            enum Mode
+            {
+                forward,
+                reverse,
+                whitespace
+            };
+
+            class Iterator
+            {
+            public:
+                typedef std::input_iterator_tag iterator_category;
+                typedef StrView value_type;
+                typedef ptrdiff_t difference_type;
+                typedef const StrView* pointer;
+                typedef const StrView& reference;
+
+                Iterator();
+                Iterator(StrView s, StrView sep, size_t max_split_times, Mode mode);
+
+                const StrView& operator*() const;
+                const StrView* operator->() const;
+                Iterator& operator++();
+                Iterator operator++(int);
+                bool operator==(const Iterator& other) const;
+                bool operator!=(const Iterator& other) const;
+
+            private:
+                void next();
+
+                StrView s_;
+                StrView sep_;
+                StrView token_;
+                size_t pos_;   //forward和whitespace模式下为未分割部分的起点，reverse模式下为未分割部分的终点
+                size_t split_times_left_;
+                Mode mode_;
+                bool last_;   //已到达最后一段
+                bool done_;
+            };
+
+            SplitRange(StrView s, StrView sep, size_t max_split_times, Mode mode);
+            Iterator begin() const;
+            Iterator end() const;
+
+        private:
+            StrView s_;
+            StrView sep_;
+            size_t max_split_times_;
+            Mode mode_;
+        };
+
+        //惰性正向分割，得到的各段与split一致
+        SplitRange splitIter(StrView s, StrView sep, size_t max_split_times = -1);
+        //惰性反向分割，从右向左依次得到rsplit结果中的各段
+        SplitRange rsplitIter(StrView s, StrView sep, size_t max_split_times = -1);
+        //惰性按空白字符分割，得到的各段与split(s)一致
+        SplitRange splitIter(StrView s);
+
+        /*  将字符串解析为算术类型，不依赖locale，不抛出异常
+            - 整数只接受十进制，允许开头的'+'或'-'，无符号类型不接受'-'
+            - 浮点数接受十进制小数及科学计数法(如"-1.5e-3"、".5"、"5.")，以及不区分大小写的inf、infinity和nan
+            - bool接受"1"、"0"、"true"和"false"；char类型与toStr对应，接受单个字符
+            - 不会跳过空白字符，需要时先使用trimView
+            @param s: 输入字符串
+            @param value: 解析成功时写入结果，失败时不修改
+            @param parsed_len: 为nullptr时要求s整体为一个数；否则只解析s开头的数并写入其长度，s后续的内容被忽略
+            @return 0代表成功，-1代表格式错误，-2代表超出T的表示范围   */
+        template<class T>
+        int parse(StrView s, T& value, size_t* parsed_len = nullptr);
+
+        /*  将以sep分隔的一行数字解析到预分配的数组中，各字段两侧的空白会被忽略
+            - 用例：float xyz[3]; int n = mstr::parseRow("1.0, 2.5, -3", ',', xyz, 3);
+            @param line: 一行文本，为空或只含空白时返回0
+            @param sep: 分隔字符
+            @param values: 接收结果的数组
+            @param capacity: 数组容量，字段数超过容量时视为失败
+            @return 成功时返回解析的字段数，失败时返回-1，此时values中已写入的内容不确定   */
+        template<class T>
+        int parseRow(StrView line, char sep, T* values, size_t capacity);
+
+        //同parseRow，结果写入values，values会先被清空，已有的容量可以复用
+        template<class T>
+        int parseRow(StrView line, char sep, std::vector<T>& values);
+
+        //判断s中是否包含sub
+        bool contains(StrView s, StrView sub);
+
+        //判断s是否以prefix开头
+        bool startsWith(StrView s, StrView prefix);
+
+        //判断s是否以suffix结尾
+        bool endsWith(StrView s, StrView suffix);
+
+        /*  将s中所有的from替换为to，从左到右单次扫描，替换进去的内容不会被再次匹配
+            - from为空时返回s的拷贝   */
+        std::string replace(StrView s, StrView from, StrView to);
+
+        /*  基于Aho-Corasick自动机的多模式查找与替换，构造一次后可以对多个字符串重复使用
+            - 按最左最长规则匹配：优先取起始位置最靠前的匹配，起始位置相同时取最长的模式
+            - 空的模式会被忽略，重复的模式只保留第一个   */
+        class MultiReplacer
+        {
+        public:
+            //from_to中的每一项为{模式, 替换内容}
+            explicit MultiReplacer(const std::vector<std::pair<std::string, std::string>>& from_to);
+
+            /*  从pos开始查找第一个匹配
+                @param s: 被查找的字符串
+                @param pos: 查找的起始位置
+                @param pattern_idx: 不为nullptr时写入匹配到的模式在from_to中的序号
+                @return 匹配的起始位置，没有匹配时返回std::string::npos   */
+            size_t find(StrView s, size_t pos = 0, size_t* pattern_idx = nullptr) const;
+
+            //s中是否包含任一模式
+            bool matchAny(StrView s) const;
+
+            //将s中所有的匹配替换为对应的内容，单次扫描，替换进去的内容不会被再次匹配
+            std::string replace(StrView s) const;
+
+        private:
+            std::vector<std::pair<std::string, std::string>> from_to_;
+            unsigned char byte_class_[256];   //在模式中出现过的字节各自为一类，其余字节为第0类
+            size_t class_count_;
+            std::vector<int32_t> next_;   //状态数 x class_count_ 的转移表，已按失配指针补全
+            std::vector<int32_t> depth_;
+            std::vector<int32_t> output_;   //以该状态结尾且长度等于其深度的模式序号，没有时为-1
+            std::vector<int32_t> output_link_;   //沿失配指针能到达的下一个有模式结尾的状态，没有时为-1
+        };
+
+        //同MultiReplacer::replace，只使用一次时可以直接调用，如replaceAll(s, { {"\\", "/"}, {"\r\n", "\n"} })
+        std::string replaceAll(StrView s, const std::vector<std::pair<std::string, std::string>>& from_to);
     }
 
 
@@ -164,242 +499,2086 @@ namespace mineutils
         template<class T, typename std::enable_if<mtype::StdCoutEachChecker<const T>::value && !(std::is_function<typename std::remove_pointer<const T>::type>::value || std::is_member_function_pointer<const T>::value) && !std::is_pointer<T>::value, int>::type = 0>
         void _osInput(std::ostream& oss, const T& arg);
 
-        template<class T, typename std::enable_if<!mtype::StdCoutEachChecker<const T>::value, int>::type = 0>
-        void _osInput(std::ostream& oss, const T& arg);
+        template<class T, typename std::enable_if<!mtype::StdCoutEachChecker<const T>::value, int>::type = 0>
+        void _osInput(std::ostream& oss, const T& arg);
+
+
+        //算术类型的转换，与fastFormat共用转换函数，定义在格式化相关实现之后
+        template<int8_t float_precision, class T>
+        std::string _arithmeticToStr(const T& arg);
+
+        template<int8_t float_precision, class T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+        inline std::string _toStrDispath(const T& arg)
+        {
+            return mstr::_arithmeticToStr<float_precision>(arg);
+        }
+
+        template<int8_t float_precision, class T, typename std::enable_if<!std::is_arithmetic<T>::value && !mtype::ConstructibleFromEachChecker<std::string, const T&>::value, int>::type = 0>
+        inline std::string _toStrDispath(const T& arg)
+        {
+#if defined(__GNUC__) && !_mgccMinVersion(4, 8, 1)
+            std::ostringstream oss;
+#else
+            //QNX710的gcc8.3.0似乎没法正确处理子线程的thread_local std::ostringstream对象，只能用指针来管理
+            thread_local std::unique_ptr<std::ostringstream> oss_ptr(new std::ostringstream);
+            std::ostringstream& oss = *oss_ptr;
+#endif
+            oss.clear();
+            oss.str("");
+            if (float_precision >= 0)
+                oss << std::fixed << std::setprecision(float_precision);
+            //else oss << std::fixed;
+            mstr::_osInput(oss, arg);
+            return oss.str();
+        }
+
+        template<int8_t float_precision, class T, typename std::enable_if<mtype::ConstructibleFromEachChecker<std::string, const T&>::value, int>::type = 0>
+        inline std::string _toStrDispath(const T& arg)
+        {
+            return arg;
+        }
+
+        template<int8_t float_precision, class T>
+        inline std::string toStr(const T& arg)
+        {
+            return mstr::_toStrDispath<float_precision>(arg);
+        }
+
+        //分离编译模式下由mineutils.cpp显式实例化的toStr类型
+#define _mforEachCommonToStrType(m) m(bool) m(char) m(short) m(unsigned short) m(int) m(unsigned int) \
+    m(long) m(unsigned long) m(long long) m(unsigned long long) m(float) m(double) m(long double)
+#ifdef _MINE_DECLARATION_ONLY
+#define _mexternToStr(T) extern template std::string toStr<-1, T>(const T&);
+        _mforEachCommonToStrType(_mexternToStr)
+#undef _mexternToStr
+#endif
+
+        template<class T, typename std::enable_if<std::is_signed<T>::value, int>::type = 0>
+        inline std::string _ordinalize(T num)
+        {
+            const auto abs_num = abs(num);
+            if ((abs_num % 10 == 1) && (abs_num % 100 != 11))
+                return mstr::toStr(num).append("st");
+            else if ((abs_num % 10 == 2) && (abs_num % 100 != 12))
+                return mstr::toStr(num).append("nd");
+            else if ((abs_num % 10 == 3) && (abs_num % 100 != 13))
+                return mstr::toStr(num).append("rd");
+            else return mstr::toStr(num).append("th");
+        }
+
+        template<class T, typename std::enable_if<!std::is_signed<T>::value, int>::type = 0>
+        inline std::string _ordinalize(T num)
+        {
+            if ((num % 10 == 1) && (num % 100 != 11))
+                return mstr::toStr(num).append("st");
+            else if ((num % 10 == 2) && (num % 100 != 12))
+                return mstr::toStr(num).append("nd");
+            else if ((num % 10 == 3) && (num % 100 != 13))
+                return mstr::toStr(num).append("rd");
+            else return mstr::toStr(num).append("th");
+        }
+
+        template<class T, typename std::enable_if<std::is_integral<T>::value, int>::type>
+        inline std::string ordinalize(T number)
+        {
+            return mstr::_ordinalize(number + 0);   //将字符型当作整型
+        }
+
+
+#ifndef _MINE_DECLARATION_ONLY
+        //format函数的相关
+        _MINE_INLINE void _format(std::ostream& oss, const std::string& s, size_t pos_offset)
+        {
+            oss.write(s.data() + pos_offset, s.length() - pos_offset);
+        }
+#else
+        void _format(std::ostream& oss, const std::string& s, size_t pos_offset);
+#endif
+
+        //format函数的相关
+        template<class Arg, class... Args>
+        inline void _format(std::ostream& oss, const std::string& s, size_t pos_offset, const Arg& arg, const Args& ...args)
+        {
+            size_t pos = s.find("{}", pos_offset);
+            if (pos != std::string::npos)
+            {
+                oss.write(s.data() + pos_offset, pos - pos_offset);
+                mstr::_osInput(oss, arg);
+                pos_offset = pos + 2;
+                mstr::_format(oss, s, pos_offset, args...);
+            }
+        }
+
+
+        template<int8_t float_precision, class... Args>
+        inline std::string format(const std::string& f_string, const Args& ...args)
+        {
+#if defined(__GNUC__) && !_mgccMinVersion(4, 8, 1)
+            std::ostringstream oss;
+#else
+            //QNX710的gcc8.3.0似乎没法正确处理子线程的thread_local std::ostringstream对象，只能用指针来管理
+            thread_local std::unique_ptr<std::ostringstream> oss_ptr(new std::ostringstream);
+            std::ostringstream& oss = *oss_ptr;
+#endif
+            oss.str("");
+            oss.clear();
+            if (float_precision >= 0)
+                oss << std::fixed << std::setprecision(float_precision);
+            //else oss << std::fixed;
+            mstr::_format(oss, f_string, 0, args...);
+            return oss.str();
+        }
+
+        inline _MINE_CONSTEXPR14 FormatString::FormatString(const char* fmt)
+            : fmt_(fmt), len_(0), tail_begin_(0), piece_count_(0), pieces_()
+        {
+            for (_FormatPiece& piece : pieces_)
+                piece = _FormatPiece{ 0, 0, 0, 0, 0, -1, ' ', 0, 0 };
+            uint32_t pos = 0;
+            uint32_t lit_begin = 0;
+            while (fmt[pos] != '\0')
+            {
+                const char c = fmt[pos];
+                if ((c == '{' || c == '}') && fmt[pos + 1] == c)
+                {
+                    if (piece_count_ == 32)
+                        break;
+                    _FormatPiece& piece = pieces_[piece_count_++];
+                    piece.lit_begin = lit_begin;
+                    piece.lit_len = pos + 1 - lit_begin;   //保留一个花括号
+                    piece.raw_begin = pos;
+                    piece.raw_len = 0;
+                    piece.width = 0;
+                    piece.precision = -1;
+                    piece.fill = ' ';
+                    piece.align = 0;
+                    piece.type = 0;
+                    pos += 2;
+                    lit_begin = pos;
+                    continue;
+                }
+                if (c == '{')
+                {
+                    if (piece_count_ == 32)
+                        break;
+                    _FormatPiece& piece = pieces_[piece_count_];
+                    uint32_t end_pos = 0;
+                    if (this->parseSpec(pos + 1, piece, end_pos))
+                    {
+                        piece.lit_begin = lit_begin;
+                        piece.lit_len = pos - lit_begin;
+                        piece.raw_begin = pos;
+                        piece.raw_len = end_pos + 1 - pos;
+                        piece_count_++;
+                        pos = end_pos + 1;
+                        lit_begin = pos;
+                        continue;
+                    }
+                }
+                pos++;
+            }
+            while (fmt[pos] != '\0')
+                pos++;
+            len_ = pos;
+            tail_begin_ = lit_begin;
+        }
+
+        inline _MINE_CONSTEXPR14 bool FormatString::parseSpec(uint32_t pos, _FormatPiece& piece, uint32_t& end_pos) const
+        {
+            piece.width = 0;
+            piece.precision = -1;
+            piece.fill = ' ';
+            piece.align = 0;
+            piece.type = 0;
+            if (fmt_[pos] == ':')
+                pos++;
+            if (fmt_[pos] != '\0' && fmt_[pos] != '}' && (fmt_[pos + 1] == '<' || fmt_[pos + 1] == '>' || fmt_[pos + 1] == '^'))
+            {
+                piece.fill = fmt_[pos];
+                piece.align = fmt_[pos + 1];
+                pos += 2;
+            }
+            else if (fmt_[pos] == '<' || fmt_[pos] == '>' || fmt_[pos] == '^')
+                piece.align = fmt_[pos++];
+            if (fmt_[pos] == '0' && piece.align == 0)
+            {
+                piece.fill = '0';
+                piece.align = '=';   //在符号之后补0
+            }
+            while (fmt_[pos] >= '0' && fmt_[pos] <= '9')
+            {
+                if (piece.width < 4096)
+                    piece.width = piece.width * 10 + (fmt_[pos] - '0');
+                pos++;
+            }
+            if (fmt_[pos] == '.')
+            {
+                pos++;
+                if (fmt_[pos] < '0' || fmt_[pos] > '9')
+                    return false;
+                piece.precision = 0;
+                while (fmt_[pos] >= '0' && fmt_[pos] <= '9')
+                {
+                    if (piece.precision < 100)
+                        piece.precision = piece.precision * 10 + (fmt_[pos] - '0');
+                    pos++;
+                }
+            }
+            const char type = fmt_[pos];
+            if (type == 'd' || type == 'x' || type == 'X' || type == 'f' || type == 'e' || type == 'g' || type == 's')
+            {
+                piece.type = type;
+                pos++;
+            }
+            if (fmt_[pos] != '}')
+                return false;
+            end_pos = pos;
+            return true;
+        }
+
+        inline _MINE_CONSTEXPR14 const char* FormatString::str() const
+        {
+            return fmt_;
+        }
+
+        inline _MINE_CONSTEXPR14 size_t FormatString::placeholderCount() const
+        {
+            size_t count = 0;
+            for (uint32_t i = 0; i < piece_count_; i++)
+            {
+                if (pieces_[i].raw_len != 0)
+                    count++;
+            }
+            return count;
+        }
+
+        inline _MINE_CONSTEXPR14 size_t FormatString::_pieceCount() const
+        {
+            return piece_count_;
+        }
+
+        inline _MINE_CONSTEXPR14 const _FormatPiece& FormatString::_piece(size_t idx) const
+        {
+            return pieces_[idx];
+        }
+
+        inline _MINE_CONSTEXPR14 size_t FormatString::_tailBegin() const
+        {
+            return tail_begin_;
+        }
+
+        inline _MINE_CONSTEXPR14 size_t FormatString::_tailLen() const
+        {
+            return len_ - tail_begin_;
+        }
+
+        //写入定长缓冲区，超出部分只计数不写入
+        struct _FormatWriter
+        {
+            char* buf;
+            size_t size;
+            size_t len;
+
+            void append(const char* s, size_t n)
+            {
+                if (len + 1 < size)
+                    memcpy(buf + len, s, std::min(n, size - 1 - len));
+                len += n;
+            }
+
+            void fill(char c, size_t n)
+            {
+                if (len + 1 < size)
+                    memset(buf + len, c, std::min(n, size - 1 - len));
+                len += n;
+            }
+        };
+
+        //参数类别：1为bool，2为字符，3为其他整数，4为浮点数，5为字符串，6为其他指针，0为其他类型(转调toStr)
+        template<class T>
+        struct _FormatArgKind
+        {
+            typedef typename std::decay<T>::type DecayT;
+            typedef typename std::remove_pointer<DecayT>::type PointeeT;
+            typedef std::integral_constant<int,
+                std::is_same<DecayT, bool>::value ? 1 :
+                mtype::InTypesChecker<DecayT, char, signed char, unsigned char>::value ? 2 :
+                std::is_integral<DecayT>::value ? 3 :
+                std::is_floating_point<DecayT>::value ? 4 :
+                (std::is_same<DecayT, std::string>::value || std::is_same<DecayT, StrView>::value || (std::is_pointer<DecayT>::value && mtype::InTypesChecker<typename std::remove_const<PointeeT>::type, char, signed char, unsigned char>::value)) ? 5 :
+                (std::is_pointer<DecayT>::value && !std::is_function<PointeeT>::value && !mtype::InTypesChecker<typename std::remove_cv<PointeeT>::type, char, signed char, unsigned char>::value) ? 6 : 0> type;
+        };
+
+        //fastFormat缓存的格式串，保存内容副本用于校验同一地址的内容是否改变
+        struct _CachedFormatString
+        {
+            std::string text;
+            FormatString fmt;
+
+            explicit _CachedFormatString(const char* s) : text(s), fmt(text.c_str()) {}
+        };
+
+#ifndef _MINE_DECLARATION_ONLY
+        //"00"到"99"的两位数字表，整数转换时每次处理两位
+        _MINE_INLINE const char* _digitPairs()
+        {
+            static const char pairs[] =
+                "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
+            return pairs;
+        }
+
+        //从end向前写入v的十进制表示，返回起始位置
+        _MINE_INLINE char* _uintToChars(unsigned long long v, char* end)
+        {
+            const char* pairs = mstr::_digitPairs();
+            while (v >= 100)
+            {
+                const unsigned idx = unsigned(v % 100) * 2;
+                v /= 100;
+                *--end = pairs[idx + 1];
+                *--end = pairs[idx];
+            }
+            if (v < 10)
+                *--end = char('0' + v);
+            else
+            {
+                const unsigned idx = unsigned(v) * 2;
+                *--end = pairs[idx + 1];
+                *--end = pairs[idx];
+            }
+            return end;
+        }
+
+        //从end向前写入v的十六进制表示，返回起始位置
+        _MINE_INLINE char* _uintToHexChars(unsigned long long v, char* end, bool upper)
+        {
+            const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+            do
+            {
+                *--end = digits[v & 0xF];
+                v >>= 4;
+            } while (v != 0);
+            return end;
+        }
+
+        //按对齐方式写入已转换好的内容
+        _MINE_INLINE void _writeAligned(_FormatWriter& writer, const _FormatPiece& piece, const char* s, size_t n, bool is_number)
+        {
+            if (piece.width <= 0 || n >= size_t(piece.width))
+            {
+                writer.append(s, n);
+                return;
+            }
+            const size_t pad = size_t(piece.width) - n;
+            const char align = piece.align ? piece.align : (is_number ? '>' : '<');
+            if (align == '=' && is_number)
+            {
+                if (n > 0 && (s[0] == '-' || s[0] == '+'))
+                {
+                    writer.append(s, 1);
+                    s++;
+                    n--;
+                }
+                writer.fill(piece.fill, pad);
+                writer.append(s, n);
+            }
+            else if (align == '<')
+            {
+                writer.append(s, n);
+                writer.fill(piece.fill, pad);
+            }
+            else if (align == '^')
+            {
+                writer.fill(piece.fill, pad / 2);
+                writer.append(s, n);
+                writer.fill(piece.fill, pad - pad / 2);
+            }
+            else
+            {
+                writer.fill(piece.fill, pad);
+                writer.append(s, n);
+            }
+        }
+
+        _MINE_INLINE void _formatInteger(_FormatWriter& writer, const _FormatPiece& piece, unsigned long long abs_value, bool negative)
+        {
+            char buf[32];
+            char* end = buf + sizeof(buf);
+            char* begin;
+            if (piece.type == 'x' || piece.type == 'X')
+                begin = mstr::_uintToHexChars(abs_value, end, piece.type == 'X');
+            else begin = mstr::_uintToChars(abs_value, end);
+            if (negative)
+                *--begin = '-';
+            mstr::_writeAligned(writer, piece, begin, end - begin, true);
+        }
+
+        /*  不经过snprintf将double按%.*f或%.*g格式写入out，结果与snprintf逐字节一致，返回写入的长度
+            - 仅处理结果可以用不超过15位有效数字的定点形式表示的情况，其余情况(科学计数法、舍入点恰好难以判断等)返回-1，由调用方转调snprintf  */
+        _MINE_INLINE int _fastFloatToChars(double value, char type, int precision, char* out)
+        {
+            static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18 };
+            static const unsigned long long upow10[] = { 1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+                10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL };
+            if (!(value == value) || value - value != 0)   //NaN和inf
+                return -1;
+            const bool negative = signbit(value);
+            const double abs_value = negative ? -value : value;
+
+            int frac_digits;   //小数位数
+            unsigned long long n;   //abs_value * 10^frac_digits四舍五入后的整数
+            bool strip_zeros = false;
+            auto roundScaled = [&](int k, unsigned long long& result) -> bool
+            {
+                //10^k和乘积各只有一次舍入，小数部分离0.5足够远时，舍入结果与按精确值舍入一致
+                const double r = abs_value * pow10[k];
+                if (!(r < 9e15))
+                    return false;
+                const unsigned long long floor_r = (unsigned long long)r;
+                const double frac = r - double(floor_r);
+                if (fabs(frac - 0.5) <= r * 4.5e-16 + 1e-300)
+                    return false;
+                result = floor_r + (frac > 0.5 ? 1 : 0);
+                return true;
+            };
+            if (type == 'f')
+            {
+                if (precision > 15)
+                    return -1;
+                frac_digits = precision;
+                if (!roundScaled(frac_digits, n))
+                    return -1;
+            }
+            else
+            {
+                const int sig_digits = precision < 0 ? 6 : (precision == 0 ? 1 : precision);
+                if (sig_digits > 15)
+                    return -1;
+                strip_zeros = true;
+                if (abs_value == 0)
+                {
+                    frac_digits = 0;
+                    n = 0;
+                }
+                else
+                {
+                    //%g按舍入到sig_digits位有效数字后的指数exp10选择形式，-4 <= exp10 < sig_digits时为定点形式
+                    int exp10 = 0;
+                    while (exp10 < sig_digits && abs_value >= pow10[exp10 + 1])
+                        exp10++;
+                    if (abs_value < 1)
+                    {
+                        exp10 = -1;
+                        while (exp10 > -5 && abs_value * pow10[-exp10] < 1)
+                            exp10--;
+                    }
+                    while (true)
+                    {
+                        if (exp10 < -4 || exp10 >= sig_digits)
+                            return -1;
+                        frac_digits = sig_digits - 1 - exp10;
+                        if (!roundScaled(frac_digits, n))
+                            return -1;
+                        if (n >= upow10[sig_digits])
+                            exp10++;
+                        else if (n < upow10[sig_digits - 1])
+                            exp10--;
+                        else break;
+                    }
+                }
+            }
+
+            char digits[32];
+            char* end = digits + sizeof(digits);
+            char* begin = mstr::_uintToChars(n, end);
+            int digit_count = int(end - begin);
+            if (strip_zeros)
+            {
+                while (frac_digits > 0 && end[-1] == '0' && digit_count > 1)
+                {
+                    end--;
+                    digit_count--;
+                    frac_digits--;
+                }
+                if (n == 0)
+                    frac_digits = 0;
+            }
+
+            char* p = out;
+            if (negative)
+                *p++ = '-';
+            if (digit_count <= frac_digits)
+            {
+                *p++ = '0';
+                if (frac_digits > 0)
+                {
+                    *p++ = '.';
+                    memset(p, '0', frac_digits - digit_count);
+                    p += frac_digits - digit_count;
+                    memcpy(p, begin, digit_count);
+                    p += digit_count;
+                }
+            }
+            else
+            {
+                memcpy(p, begin, digit_count - frac_digits);
+                p += digit_count - frac_digits;
+                if (frac_digits > 0)
+                {
+                    *p++ = '.';
+                    memcpy(p, end - frac_digits, frac_digits);
+                    p += frac_digits;
+                }
+            }
+            return int(p - out);
+        }
+
+        _MINE_INLINE void _formatFloat(_FormatWriter& writer, const _FormatPiece& piece, long double value, bool is_long_double)
+        {
+            //%f输出1e308时需要约310位，precision上限为100
+            char buf[512];
+            char spec[8] = "%.*";
+            size_t spec_len = 3;
+            if (is_long_double)
+                spec[spec_len++] = 'L';
+            spec[spec_len++] = (piece.type == 'f' || piece.type == 'e') ? piece.type : 'g';
+            spec[spec_len] = '\0';
+            const int precision = piece.precision >= 0 ? piece.precision : 6;
+            int n = -1;
+            if (!is_long_double && piece.type != 'e')
+                n = mstr::_fastFloatToChars(double(value), piece.type, precision, buf);
+            if (n < 0)
+                n = is_long_double ? snprintf(buf, sizeof(buf), spec, precision, value) : snprintf(buf, sizeof(buf), spec, precision, double(value));
+            if (n < 0)
+                n = 0;
+            if (size_t(n) < sizeof(buf))
+                mstr::_writeAligned(writer, piece, buf, n, true);
+            else
+            {
+                //long double的%f输出可达数千位，超出栈上缓冲区时在堆上重新格式化，不截断
+                std::string long_buf(n + 1, '\0');
+                n = is_long_double ? snprintf(&long_buf[0], long_buf.size(), spec, precision, value) : snprintf(&long_buf[0], long_buf.size(), spec, precision, double(value));
+                mstr::_writeAligned(writer, piece, long_buf.data(), std::min(size_t(n), long_buf.size() - 1), true);
+            }
+        }
+
+        _MINE_INLINE void _formatCStr(_FormatWriter& writer, const _FormatPiece& piece, const char* s, size_t n)
+        {
+            if (piece.precision >= 0 && n > size_t(piece.precision))
+                n = piece.precision;
+            mstr::_writeAligned(writer, piece, s, n, false);
+        }
+
+        //写入剩余的字面量，缺少参数的占位符按原文输出
+        _MINE_INLINE void _formatPieces(_FormatWriter& writer, const FormatString& fmt, size_t idx)
+        {
+            for (; idx < fmt._pieceCount(); idx++)
+            {
+                const _FormatPiece& piece = fmt._piece(idx);
+                writer.append(fmt.str() + piece.lit_begin, piece.lit_len);
+                writer.append(fmt.str() + piece.raw_begin, piece.raw_len);
+            }
+        }
+
+        /*  返回共享所有权，参数的operator<<中嵌套调用fastFormat时即使清空或替换了缓存，外层正在使用的格式串也不会被释放
+            - 不支持thread_local时缓存为所有线程共享，需加锁  */
+        _MINE_INLINE std::shared_ptr<const _CachedFormatString> _getCachedFormatString(const char* fmt)
+        {
+            _MINE_THREAD_LOCAL_IF_HAVE std::unordered_map<const char*, std::shared_ptr<const _CachedFormatString>> cache;
+#if defined(__GNUC__) && !_mgccMinVersion(4, 8, 1)  //for qnx660
+            static std::mutex mtx;
+            std::lock_guard<std::mutex> lk(mtx);
+#endif
+            auto it = cache.find(fmt);
+            if (it != cache.end() && it->second->text == fmt)
+                return it->second;
+            if (cache.size() >= 1024)   //避免动态生成的格式串使缓存无限增长
+                cache.clear();
+            std::shared_ptr<const _CachedFormatString>& cached = cache[fmt];
+            cached = std::make_shared<_CachedFormatString>(fmt);
+            return cached;
+        }
+#else
+        const char* _digitPairs();
+        char* _uintToChars(unsigned long long v, char* end);
+        char* _uintToHexChars(unsigned long long v, char* end, bool upper);
+        void _writeAligned(_FormatWriter& writer, const _FormatPiece& piece, const char* s, size_t n, bool is_number);
+        int _fastFloatToChars(double value, char type, int precision, char* out);
+        void _formatInteger(_FormatWriter& writer, const _FormatPiece& piece, unsigned long long abs_value, bool negative);
+        void _formatFloat(_FormatWriter& writer, const _FormatPiece& piece, long double value, bool is_long_double);
+        void _formatCStr(_FormatWriter& writer, const _FormatPiece& piece, const char* s, size_t n);
+        void _formatPieces(_FormatWriter& writer, const FormatString& fmt, size_t idx);
+        std::shared_ptr<const _CachedFormatString> _getCachedFormatString(const char* fmt);
+#endif
+
+        template<class T>
+        inline void _formatArg(_FormatWriter& writer, const _FormatPiece& piece, const T& arg, std::integral_constant<int, 0>)
+        {
+            const std::string s = mstr::toStr(arg);
+            mstr::_formatCStr(writer, piece, s.data(), s.size());
+        }
+
+        template<class T>
+        inline void _formatArg(_FormatWriter& writer, const _FormatPiece& piece, const T& arg, std::integral_constant<int, 1>)
+        {
+            mstr::_formatInteger(writer, piece, arg ? 1 : 0, false);
+        }
+
+        template<class T>
+        inline void _formatArg(_FormatWriter& writer, const _FormatPiece& piece, const T& arg, std::integral_constant<int, 2>)
+        {
+            if (piece.type == 'd' || piece.type == 'x' || piece.type == 'X')
+                mstr::_formatInteger(writer, piece, (unsigned long long)(arg < 0 ? -(long long)arg : (long long)arg), arg < 0);
+            else
+            {
+                const char c = char(arg);
+                mstr::_writeAligned(writer, piece, &c, 1, false);
+            }
+        }
+
+        template<class T>
+        inline void _formatArg(_FormatWriter& writer, const _FormatPiece& piece, const T& arg, std::integral_constant<int, 3>)
+        {
+            if (piece.type == 'f' || piece.type == 'e' || piece.type == 'g')
+                mstr::_formatFloat(writer, piece, (long double)arg, false);
+            else if (arg < 0)
+                mstr::_formatInteger(writer, piece, 0ULL - (unsigned long long)arg, true);
+            else mstr::_formatInteger(writer, piece, (unsigned long long)arg, false);
+        }
+
+        template<class T>
+        inline void _formatArg(_FormatWriter& writer, const _FormatPiece& piece, const T& arg, std::integral_constant<int, 4>)
+        {
+            mstr::_formatFloat(writer, piece, arg, std::is_same<T, long double>::value);
+        }
+
+        inline void _formatArg(_FormatWriter& writer, const _FormatPiece& piece, const std::string& arg, std::integral_constant<int, 5>)
+        {
+            mstr::_formatCStr(writer, piece, arg.data(), arg.size());
+        }
+
+        inline void _formatArg(_FormatWriter& writer, const _FormatPiece& piece, const StrView& arg, std::integral_constant<int, 5>)
+        {
+            mstr::_formatCStr(writer, piece, arg.data(), arg.size());
+        }
+
+        template<class T>
+        inline void _formatArg(_FormatWriter& writer, const _FormatPiece& piece, const T& arg, std::integral_constant<int, 5>)
+        {
+            typedef typename std::remove_pointer<typename std::decay<T>::type>::type CharT;
+            const CharT* ptr = arg;
+            const char* s = (const char*)ptr;
+            if (s == nullptr)
+                mstr::_formatCStr(writer, piece, "(null)", 6);
+            else mstr::_formatCStr(writer, piece, s, strlen(s));
+        }
+
+        template<class T>
+        inline void _formatArg(_FormatWriter& writer, const _FormatPiece& piece, const T& arg, std::integral_constant<int, 6>)
+        {
+            char buf[32];
+            char* end = buf + sizeof(buf);
+            char* begin = mstr::_uintToHexChars(uintptr_t(arg), end, false);
+            if (arg != nullptr)
+            {
+                *--begin = 'x';
+                *--begin = '0';
+            }
+            mstr::_writeAligned(writer, piece, begin, end - begin, true);
+        }
+
+        template<class Arg, class... Args>
+        inline void _formatPieces(_FormatWriter& writer, const FormatString& fmt, size_t idx, const Arg& arg, const Args&... args)
+        {
+            while (idx < fmt._pieceCount())
+            {
+                const _FormatPiece& piece = fmt._piece(idx++);
+                writer.append(fmt.str() + piece.lit_begin, piece.lit_len);
+                if (piece.raw_len != 0)
+                {
+                    mstr::_formatArg(writer, piece, arg, typename _FormatArgKind<Arg>::type());
+                    mstr::_formatPieces(writer, fmt, idx, args...);
+                    return;
+                }
+            }
+        }
+
+        //将算术类型按toStr的规则写入大小为size的buf，返回完整结果的长度，不小于size时buf中的结果被截断
+        template<int8_t float_precision, class T>
+        inline size_t _arithmeticToChars(const T& arg, char* buf, size_t size)
+        {
+            //与流的行为一致：float_precision只对浮点数生效，此时相当于std::fixed
+            const _FormatPiece piece = { 0, 0, 0, 0, 0, float_precision, ' ', 0, char((std::is_floating_point<T>::value && float_precision >= 0) ? 'f' : 0) };
+            _FormatWriter writer = { buf, size, 0 };
+            mstr::_formatArg(writer, piece, arg, typename _FormatArgKind<T>::type());
+            return writer.len;
+        }
+
+        template<int8_t float_precision, class T>
+        inline std::string _arithmeticToStr(const T& arg)
+        {
+            char buf[512];
+            const size_t len = mstr::_arithmeticToChars<float_precision>(arg, buf, sizeof(buf));
+            if (len < sizeof(buf))
+                return std::string(buf, len);
+            std::string s(len, '\0');
+            mstr::_arithmeticToChars<float_precision>(arg, &s[0], len + 1);
+            return s;
+        }
+
+        template<class... Args>
+        inline size_t formatTo(char* buf, size_t size, const FormatString& fmt, const Args&... args)
+        {
+            _FormatWriter writer = { buf, size, 0 };
+            mstr::_formatPieces(writer, fmt, 0, args...);
+            writer.append(fmt.str() + fmt._tailBegin(), fmt._tailLen());
+            if (size > 0)
+                buf[std::min(writer.len, size - 1)] = '\0';
+            return writer.len;
+        }
+
+        template<class... Args>
+        inline size_t formatTo(char* buf, size_t size, const char* fmt, const Args&... args)
+        {
+#if defined(__GNUC__) && !_mgccMinVersion(4, 8, 1)  //for qnx660，不支持thread_local，每次重新解析
+            const FormatString parsed_fmt(fmt);
+#else
+            const std::shared_ptr<const _CachedFormatString> cached_fmt = mstr::_getCachedFormatString(fmt);
+            const FormatString& parsed_fmt = cached_fmt->fmt;
+#endif
+            return mstr::formatTo(buf, size, parsed_fmt, args...);
+        }
+
+        template<class... Args>
+        inline std::string fastFormat(const FormatString& fmt, const Args&... args)
+        {
+            char buf[256];
+            const size_t len = mstr::formatTo(buf, sizeof(buf), fmt, args...);
+            if (len < sizeof(buf))
+                return std::string(buf, len);
+            std::string s(len, '\0');
+            mstr::formatTo(&s[0], len + 1, fmt, args...);
+            return s;
+        }
+
+        template<class... Args>
+        inline std::string fastFormat(const char* fmt, const Args&... args)
+        {
+#if defined(__GNUC__) && !_mgccMinVersion(4, 8, 1)  //for qnx660，不支持thread_local，每次重新解析
+            const FormatString parsed_fmt(fmt);
+#else
+            const std::shared_ptr<const _CachedFormatString> cached_fmt = mstr::_getCachedFormatString(fmt);
+            const FormatString& parsed_fmt = cached_fmt->fmt;
+#endif
+            return mstr::fastFormat(parsed_fmt, args...);
+        }
+
+        //将流的输出追加到StringBuilder
+        class _StringBuilderStreamBuf : public std::streambuf
+        {
+        public:
+            explicit _StringBuilderStreamBuf(StringBuilder* builder) : builder_(builder) {}
+
+        protected:
+            int_type overflow(int_type c) override
+            {
+                if (!traits_type::eq_int_type(c, traits_type::eof()))
+                {
+                    const char ch = traits_type::to_char_type(c);
+                    builder_->append(&ch, 1);
+                }
+                return traits_type::not_eof(c);
+            }
+
+            std::streamsize xsputn(const char* s, std::streamsize n) override
+            {
+                builder_->append(s, size_t(n));
+                return n;
+            }
+
+        private:
+            StringBuilder* builder_;
+        };
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE StringBuilder::StringBuilder() : data_(inline_buf_), size_(0), capacity_(sizeof(inline_buf_) - 1)
+        {
+            inline_buf_[0] = '\0';
+        }
+
+        _MINE_INLINE StringBuilder& StringBuilder::append(const char* s, size_t n)
+        {
+            if (n > capacity_ - size_)
+            {
+                //s可能指向自身的内容，扩容会释放旧缓冲区，需按偏移重新定位
+                const uintptr_t offset = uintptr_t(s) - uintptr_t(data_);
+                this->reserve(size_ + n);
+                if (offset <= size_)
+                    s = data_ + offset;
+            }
+            memcpy(data_ + size_, s, n);
+            size_ += n;
+            data_[size_] = '\0';
+            return *this;
+        }
+
+        _MINE_INLINE const char* StringBuilder::c_str() const
+        {
+            return data_;
+        }
+
+        _MINE_INLINE const char* StringBuilder::data() const
+        {
+            return data_;
+        }
+
+        _MINE_INLINE size_t StringBuilder::size() const
+        {
+            return size_;
+        }
+
+        _MINE_INLINE bool StringBuilder::empty() const
+        {
+            return size_ == 0;
+        }
+
+        _MINE_INLINE size_t StringBuilder::capacity() const
+        {
+            return capacity_;
+        }
+
+        _MINE_INLINE std::string StringBuilder::str() const
+        {
+            return std::string(data_, size_);
+        }
+
+        _MINE_INLINE void StringBuilder::clear()
+        {
+            size_ = 0;
+            data_[0] = '\0';
+        }
+
+        _MINE_INLINE void StringBuilder::reserve(size_t capacity)
+        {
+            if (capacity <= capacity_)
+                return;
+            capacity = std::max(capacity, capacity_ * 2);
+            std::unique_ptr<char[]> new_buf(new char[capacity + 1]);
+            memcpy(new_buf.get(), data_, size_ + 1);
+            heap_buf_ = std::move(new_buf);
+            data_ = heap_buf_.get();
+            capacity_ = capacity;
+        }
+
+        _MINE_INLINE std::ostream& StringBuilder::_stream()
+        {
+            if (!stream_)
+            {
+                stream_buf_.reset(new _StringBuilderStreamBuf(this));
+                stream_.reset(new std::ostream(stream_buf_.get()));
+            }
+            stream_->clear();
+            stream_->flags(std::ios_base::skipws | std::ios_base::dec);
+            stream_->precision(6);
+            return *stream_;
+        }
+#endif
+
+        template<class T>
+        inline StringBuilder& StringBuilder::append(const T& arg)
+        {
+            return mstr::toStr(*this, arg);
+        }
+
+        //字符串类参数是否指向[begin, begin + len)内，其他类型的参数不检查
+        template<class T>
+        inline bool _argInRange(const T&, const char*, size_t, std::integral_constant<int, 0>)
+        {
+            return false;
+        }
+
+        template<class T>
+        inline bool _argInRange(const T& arg, const char* begin, size_t len, std::integral_constant<int, 1>)
+        {
+            return uintptr_t(static_cast<const void*>(arg)) - uintptr_t(begin) < len;
+        }
+
+        template<class T>
+        inline bool _argInRange(const T& arg, const char* begin, size_t len, std::integral_constant<int, 2>)
+        {
+            return uintptr_t(static_cast<const void*>(arg.data())) - uintptr_t(begin) < len;
+        }
+
+        template<class T>
+        inline bool _argInRange(const T& arg, const char* begin, size_t len)
+        {
+            typedef typename std::decay<T>::type DecayT;
+            return mstr::_argInRange(arg, begin, len, std::integral_constant<int, _FormatArgKind<T>::type::value != 5 ? 0 : std::is_pointer<DecayT>::value ? 1 : 2>());
+        }
+
+        template<class... Args>
+        inline StringBuilder& StringBuilder::appendFormat(const FormatString& fmt, const Args&... args)
+        {
+            //参数引用了自身的内容时，直接写入会覆盖其结尾的'\0'，扩容也会释放其内存，改为先格式化到临时字符串
+            const bool aliased[] = { false, mstr::_argInRange(args, data_, capacity_ + 1)... };
+            for (bool a : aliased)
+            {
+                if (a)
+                {
+                    const std::string s = mstr::fastFormat(fmt, args...);
+                    return this->append(s.data(), s.size());
+                }
+            }
+            const size_t len = mstr::formatTo(data_ + size_, capacity_ - size_ + 1, fmt, args...);
+            if (len > capacity_ - size_)
+            {
+                this->reserve(size_ + len);
+                mstr::formatTo(data_ + size_, capacity_ - size_ + 1, fmt, args...);
+            }
+            size_ += len;
+            return *this;
+        }
+
+        template<class... Args>
+        inline StringBuilder& StringBuilder::appendFormat(const char* fmt, const Args&... args)
+        {
+#if defined(__GNUC__) && !_mgccMinVersion(4, 8, 1)  //for qnx660，不支持thread_local，每次重新解析
+            const FormatString parsed_fmt(fmt);
+#else
+            const std::shared_ptr<const _CachedFormatString> cached_fmt = mstr::_getCachedFormatString(fmt);
+            const FormatString& parsed_fmt = cached_fmt->fmt;
+#endif
+            return this->appendFormat(parsed_fmt, args...);
+        }
+
+        template<int8_t float_precision, class T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+        inline void _toStrAppend(StringBuilder& out, const T& arg)
+        {
+            char buf[512];
+            const size_t len = mstr::_arithmeticToChars<float_precision>(arg, buf, sizeof(buf));
+            if (len < sizeof(buf))
+                out.append(buf, len);
+            else
+            {
+                const std::string s = mstr::_arithmeticToStr<float_precision>(arg);
+                out.append(s.data(), s.size());
+            }
+        }
+
+        template<class T>
+        inline void _appendStrLike(StringBuilder& out, const T& arg, std::true_type)
+        {
+            const typename std::remove_pointer<typename std::decay<T>::type>::type* ptr = arg;
+            if (ptr == nullptr)
+                out.append("(null)", 6);
+            else out.append((const char*)ptr, strlen((const char*)ptr));
+        }
+
+        inline void _appendStrLike(StringBuilder& out, const std::string& arg, std::true_type)
+        {
+            out.append(arg.data(), arg.size());
+        }
+
+        inline void _appendStrLike(StringBuilder& out, const StrView& arg, std::true_type)
+        {
+            out.append(arg.data(), arg.size());
+        }
+
+        template<class T>
+        inline void _appendStrLike(StringBuilder& out, const T& arg, std::false_type)
+        {
+            const std::string s(arg);
+            out.append(s.data(), s.size());
+        }
+
+        template<int8_t float_precision, class T, typename std::enable_if<!std::is_arithmetic<T>::value && mtype::ConstructibleFromEachChecker<std::string, const T&>::value, int>::type = 0>
+        inline void _toStrAppend(StringBuilder& out, const T& arg)
+        {
+            mstr::_appendStrLike(out, arg, std::integral_constant<bool, _FormatArgKind<T>::type::value == 5>());
+        }
+
+        template<int8_t float_precision, class T, typename std::enable_if<!std::is_arithmetic<T>::value && !mtype::ConstructibleFromEachChecker<std::string, const T&>::value, int>::type = 0>
+        inline void _toStrAppend(StringBuilder& out, const T& arg)
+        {
+            std::ostream& os = out._stream();
+            if (float_precision >= 0)
+                os << std::fixed << std::setprecision(float_precision);
+            mstr::_osInput(os, arg);
+        }
+
+        template<int8_t float_precision, class T>
+        inline StringBuilder& toStr(StringBuilder& out, const T& arg)
+        {
+            mstr::_toStrAppend<float_precision>(out, arg);
+            return out;
+        }
+
+        template<int8_t float_precision, class... Args>
+        inline StringBuilder& format(StringBuilder& out, const std::string& f_string, const Args& ...args)
+        {
+            std::ostream& os = out._stream();
+            if (float_precision >= 0)
+                os << std::fixed << std::setprecision(float_precision);
+            mstr::_format(os, f_string, 0, args...);
+            return out;
+        }
+
+        inline constexpr bool _isSpaceChar(char c)
+        {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        //返回x中最低位的1的位置，x不能为0
+        inline int _countTrailingZeros(uint64_t x)
+        {
+#if defined(__GNUC__)
+            return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+            unsigned long idx;
+            _BitScanForward64(&idx, x);
+            return (int)idx;
+#else
+            int idx = 0;
+            while ((x & 1) == 0)
+            {
+                x >>= 1;
+                idx++;
+            }
+            return idx;
+#endif
+        }
+
+#if defined(_MINE_SIMD_SSE2)
+        //比较p开始的16字节，返回满足_scanBytes<kind>条件的字节对应位为1的掩码，kind为1或2
+        template<int kind>
+        inline unsigned int _sse2SpaceMask(const char* p)
+        {
+            const __m128i x = _mm_loadu_si128((const __m128i*)p);
+            const __m128i offset = _mm_sub_epi8(x, _mm_set1_epi8('\t'));   //'\t'到'\r'映射到0到4
+            const __m128i matched = _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(4)), offset));
+            const unsigned int mask = (unsigned int)_mm_movemask_epi8(matched);
+            return kind == 2 ? mask ^ 0xFFFFu : mask;
+        }
+#endif
+
+        /*  在[p, p + n)中查找第一个满足条件的字节，返回其偏移，未找到时返回n
+            - kind为0时查找等于c的字节，为1时查找空白字符(" \t\n\r\f\v")，为2时查找非空白字符
+            - 查找单个字节时使用memchr，查找空白字符时在支持SSE2的平台上每次比较16字节，否则逐字节比较  */
+        template<int kind>
+        inline size_t _scanBytes(const char* p, size_t n, char c)
+        {
+            if (kind == 0)
+            {
+                const char* found = (const char*)memchr(p, c, n);
+                return found ? found - p : n;
+            }
+            size_t i = 0;
+#if defined(_MINE_SIMD_SSE2)
+            for (; i + 16 <= n; i += 16)
+            {
+                const unsigned int mask = mstr::_sse2SpaceMask<kind>(p + i);
+                if (mask != 0)
+                    return i + mstr::_countTrailingZeros(mask);
+            }
+#endif
+            for (; i < n; i++)
+            {
+                if ((kind == 1) == mstr::_isSpaceChar(p[i]))
+                    return i;
+            }
+            return n;
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE std::vector<std::string> split(const std::string& s, const std::string& sep, size_t max_split_times)
+        {
+            if (s.empty() || max_split_times == 0)
+                return { s };
+            if (sep.empty())
+            {
+                printf("!!!Error!!! \"%s\"[%s](line %d): param sep is empty!\n", MINE_FUNCSIG, __FILE__, __LINE__);
+                return { s };
+            }
+            std::vector<std::string> strs;
+
+            size_t now_split_times = 0;
+            size_t start_pos = 0;
+            size_t sep_pos;
+            const StrView s_view(s);
+            while (sep_pos = s_view.find(sep, start_pos), sep_pos != std::string::npos)
+            {
+                strs.emplace_back(s.substr(start_pos, sep_pos - start_pos));
+                start_pos = sep_pos + sep.length();
+                now_split_times++;
+                if (now_split_times >= max_split_times)
+                    break;
+            }
+            strs.emplace_back(s.substr(start_pos));
+            return strs;
+        }
+
+
+        _MINE_INLINE std::vector<std::string> rsplit(const std::string& s, const std::string& sep, size_t max_split_times)
+        {
+            if (s.empty() || max_split_times == 0)
+                return { s };
+            if (sep.empty())
+            {
+                printf("!!!Error!!! \"%s\"[%s](line %d): param sep is empty!\n", MINE_FUNCSIG, __FILE__, __LINE__);
+                return { s };
+            }
+            std::vector<std::string> strs;
+
+            size_t now_split_times = 0;
+            size_t start_pos = std::string::npos;
+            size_t sep_pos = std::string::npos, tmp_sep_pos;
+            while (tmp_sep_pos = s.rfind(sep, start_pos), tmp_sep_pos != std::string::npos)
+            {
+                sep_pos = tmp_sep_pos;
+                strs.emplace_back(s.substr(sep_pos + sep.length(), start_pos - (sep_pos + sep.length()) + 1));
+                start_pos = sep_pos - 1;
+                now_split_times++;
+                if (now_split_times >= max_split_times || sep_pos == 0)
+                    break;
+            }
+            strs.emplace_back(s.substr(0, sep_pos));
+            std::reverse(strs.begin(), strs.end());   //从后向前收集，避免每次在头部插入
+            return strs;
+        }
+
+        _MINE_INLINE std::vector<std::string> split(const std::string& s)
+        {
+            if (s.empty())
+                return { };
+
+            std::vector<std::string> strs;
+            const char* p = s.data();
+            const size_t n = s.size();
+            size_t lpos = 0;
+            while (true)
+            {
+                lpos += mstr::_scanBytes<2>(p + lpos, n - lpos, 0);
+                if (lpos == n)
+                    break;
+                const size_t rpos = lpos + mstr::_scanBytes<1>(p + lpos, n - lpos, 0);
+                strs.emplace_back(p + lpos, rpos - lpos);
+                lpos = rpos;
+            }
+
+            return strs;
+        }
+
+        _MINE_INLINE std::string trim(std::string s, const char* chars_to_remove)
+        {
+            if (s.empty())
+                return s;
+
+            size_t left_pos = s.find_first_not_of(chars_to_remove);
+            if (left_pos == std::string::npos)
+                s.clear();
+            else
+            {
+                s.erase(0, left_pos);
+                size_t right_pos = s.find_last_not_of(chars_to_remove);
+                s.erase(right_pos + 1, s.size());
+            }
+            return s;
+        }
+
+        _MINE_INLINE std::string ltrim(std::string s, const char* chars_to_remove)
+        {
+            if (s.empty())
+                return s;
+
+            size_t left_pos = s.find_first_not_of(chars_to_remove);
+            if (left_pos == std::string::npos)
+                s.clear();
+            else s.erase(0, left_pos);
+            return s;
+        }
+
+        _MINE_INLINE std::string rtrim(std::string s, const char* chars_to_remove)
+        {
+            if (s.empty())
+                return s;
+
+            size_t right_pos = s.find_last_not_of(chars_to_remove);
+            if (right_pos == std::string::npos)
+                s.clear();
+            else s.erase(right_pos + 1, s.size());
+            return s;
+        }
+
+        _MINE_INLINE std::string lpad(std::string s, size_t target_len, const char pad_char)
+        {
+            if (s.size() < target_len)
+                s.insert(0, target_len - s.size(), pad_char);
+            return s;
+        }
+
+        _MINE_INLINE std::string rpad(std::string s, size_t target_len, const char pad_char)
+        {
+            if (s.size() < target_len)
+                s.insert(s.size(), target_len - s.size(), pad_char);
+            return s;
+        }
+#endif
+
+        constexpr StrView::StrView() : data_(""), size_(0) {}
+
+        constexpr StrView::StrView(const char* data, size_t size) : data_(data), size_(size) {}
+
+        constexpr const char* StrView::data() const
+        {
+            return data_;
+        }
+
+        constexpr size_t StrView::size() const
+        {
+            return size_;
+        }
+
+        constexpr bool StrView::empty() const
+        {
+            return size_ == 0;
+        }
+
+        constexpr const char* StrView::begin() const
+        {
+            return data_;
+        }
+
+        constexpr const char* StrView::end() const
+        {
+            return data_ + size_;
+        }
+
+        constexpr char StrView::operator[](size_t idx) const
+        {
+            return data_[idx];
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE StrView::StrView(const char* s) : data_(s ? s : ""), size_(s ? strlen(s) : 0) {}
+
+        _MINE_INLINE StrView::StrView(const std::string& s) : data_(s.data()), size_(s.size()) {}
+
+        _MINE_INLINE StrView StrView::substr(size_t pos, size_t n) const
+        {
+            if (pos > size_)
+                pos = size_;
+            return StrView(data_ + pos, std::min(n, size_ - pos));
+        }
+
+        _MINE_INLINE size_t StrView::find(StrView s, size_t pos) const
+        {
+            if (pos > size_ || s.size_ > size_ - pos)
+                return std::string::npos;
+            if (s.size_ == 0)
+                return pos;
+            const size_t last = size_ - s.size_;
+            while (pos <= last)
+            {
+                pos += mstr::_scanBytes<0>(data_ + pos, last - pos + 1, s.data_[0]);
+                if (pos > last)
+                    return std::string::npos;
+                if (memcmp(data_ + pos, s.data_, s.size_) == 0)
+                    return pos;
+                pos++;
+            }
+            return std::string::npos;
+        }
+
+        _MINE_INLINE size_t StrView::find(char c, size_t pos) const
+        {
+            if (pos >= size_)
+                return std::string::npos;
+            pos += mstr::_scanBytes<0>(data_ + pos, size_ - pos, c);
+            return pos < size_ ? pos : std::string::npos;
+        }
+
+        _MINE_INLINE size_t StrView::rfind(StrView s, size_t pos) const
+        {
+            if (s.size_ > size_)
+                return std::string::npos;
+            size_t i = std::min(pos, size_ - s.size_);
+            while (true)
+            {
+                if (memcmp(data_ + i, s.data_, s.size_) == 0)
+                    return i;
+                if (i == 0)
+                    return std::string::npos;
+                i--;
+            }
+        }
+
+        _MINE_INLINE std::string StrView::str() const
+        {
+            return std::string(data_, size_);
+        }
+
+        _MINE_INLINE bool StrView::operator==(StrView other) const
+        {
+            return size_ == other.size_ && memcmp(data_, other.data_, size_) == 0;
+        }
+
+        _MINE_INLINE bool StrView::operator!=(StrView other) const
+        {
+            return !(*this == other);
+        }
+
+        _MINE_INLINE std::ostream& operator<<(std::ostream& os, StrView s)
+        {
+            return os.write(s.data(), s.size());
+        }
+
+        _MINE_INLINE std::vector<StrView> splitView(StrView s, StrView sep, size_t max_split_times)
+        {
+            std::vector<StrView> strs;
+            for (StrView token : mstr::splitIter(s, sep, max_split_times))
+                strs.push_back(token);
+            return strs;
+        }
+
+        _MINE_INLINE std::vector<StrView> rsplitView(StrView s, StrView sep, size_t max_split_times)
+        {
+            std::vector<StrView> strs;
+            for (StrView token : mstr::rsplitIter(s, sep, max_split_times))
+                strs.push_back(token);
+            std::reverse(strs.begin(), strs.end());
+            return strs;
+        }
+
+        _MINE_INLINE std::vector<StrView> splitView(StrView s)
+        {
+            std::vector<StrView> strs;
+            for (StrView token : mstr::splitIter(s))
+                strs.push_back(token);
+            return strs;
+        }
+
+        _MINE_INLINE StrView trimView(StrView s, const char* chars_to_remove)
+        {
+            return mstr::rtrimView(mstr::ltrimView(s, chars_to_remove), chars_to_remove);
+        }
+
+        _MINE_INLINE StrView ltrimView(StrView s, const char* chars_to_remove)
+        {
+            size_t left_pos = 0;
+            while (left_pos < s.size() && s[left_pos] != '\0' && strchr(chars_to_remove, s[left_pos]))
+                left_pos++;
+            return s.substr(left_pos);
+        }
+
+        _MINE_INLINE StrView rtrimView(StrView s, const char* chars_to_remove)
+        {
+            size_t right_pos = s.size();
+            while (right_pos > 0 && s[right_pos - 1] != '\0' && strchr(chars_to_remove, s[right_pos - 1]))
+                right_pos--;
+            return s.substr(0, right_pos);
+        }
+
+        _MINE_INLINE SplitRange::Iterator::Iterator() : pos_(0), split_times_left_(0), mode_(forward), last_(true), done_(true) {}
+
+        _MINE_INLINE SplitRange::Iterator::Iterator(StrView s, StrView sep, size_t max_split_times, Mode mode)
+            : s_(s), sep_(sep), pos_(mode == reverse ? s.size() : 0), split_times_left_(max_split_times), mode_(mode), last_(false), done_(false)
+        {
+            if (mode != whitespace && sep.empty())
+            {
+                if (!s.empty() && max_split_times != 0)
+                    mprintfELimited("param sep is empty!\n");
+                last_ = true;
+                token_ = s;
+                return;
+            }
+            this->next();
+        }
+
+        _MINE_INLINE const StrView& SplitRange::Iterator::operator*() const
+        {
+            return token_;
+        }
+
+        _MINE_INLINE const StrView* SplitRange::Iterator::operator->() const
+        {
+            return &token_;
+        }
+
+        _MINE_INLINE SplitRange::Iterator& SplitRange::Iterator::operator++()
+        {
+            this->next();
+            return *this;
+        }
+
+        _MINE_INLINE SplitRange::Iterator SplitRange::Iterator::operator++(int)
+        {
+            Iterator old = *this;
+            this->next();
+            return old;
+        }
+
+        _MINE_INLINE bool SplitRange::Iterator::operator==(const Iterator& other) const
+        {
+            if (done_ || other.done_)
+                return done_ == other.done_;
+            return token_.data() == other.token_.data() && token_.size() == other.token_.size();
+        }
+
+        _MINE_INLINE bool SplitRange::Iterator::operator!=(const Iterator& other) const
+        {
+            return !(*this == other);
+        }
+
+        _MINE_INLINE void SplitRange::Iterator::next()
+        {
+            if (last_)
+            {
+                done_ = true;
+                return;
+            }
+            if (mode_ == whitespace)
+            {
+                pos_ += mstr::_scanBytes<2>(s_.data() + pos_, s_.size() - pos_, 0);
+                if (pos_ == s_.size())
+                {
+                    last_ = done_ = true;
+                    return;
+                }
+                const size_t end_pos = pos_ + mstr::_scanBytes<1>(s_.data() + pos_, s_.size() - pos_, 0);
+                token_ = s_.substr(pos_, end_pos - pos_);
+                pos_ = end_pos;
+            }
+            else if (mode_ == forward)
+            {
+                const size_t sep_pos = split_times_left_ > 0 ? s_.find(sep_, pos_) : std::string::npos;
+                if (sep_pos == std::string::npos)
+                {
+                    token_ = s_.substr(pos_);
+                    last_ = true;
+                    return;
+                }
+                token_ = s_.substr(pos_, sep_pos - pos_);
+                pos_ = sep_pos + sep_.size();
+                split_times_left_--;
+            }
+            else
+            {
+                const size_t sep_pos = (split_times_left_ > 0 && pos_ >= sep_.size()) ? s_.substr(0, pos_).rfind(sep_) : std::string::npos;
+                if (sep_pos == std::string::npos)
+                {
+                    token_ = s_.substr(0, pos_);
+                    last_ = true;
+                    return;
+                }
+                token_ = s_.substr(sep_pos + sep_.size(), pos_ - sep_pos - sep_.size());
+                pos_ = sep_pos;
+                split_times_left_--;
+            }
+        }
+
+        _MINE_INLINE SplitRange::SplitRange(StrView s, StrView sep, size_t max_split_times, Mode mode)
+            : s_(s), sep_(sep), max_split_times_(max_split_times), mode_(mode) {}
+
+        _MINE_INLINE SplitRange::Iterator SplitRange::begin() const
+        {
+            return Iterator(s_, sep_, max_split_times_, mode_);
+        }
+
+        _MINE_INLINE SplitRange::Iterator SplitRange::end() const
+        {
+            return Iterator();
+        }
+
+        _MINE_INLINE SplitRange splitIter(StrView s, StrView sep, size_t max_split_times)
+        {
+            return SplitRange(s, sep, max_split_times, SplitRange::forward);
+        }
+
+        _MINE_INLINE SplitRange rsplitIter(StrView s, StrView sep, size_t max_split_times)
+        {
+            return SplitRange(s, sep, max_split_times, SplitRange::reverse);
+        }
+
+        _MINE_INLINE SplitRange splitIter(StrView s)
+        {
+            return SplitRange(s, StrView(), -1, SplitRange::whitespace);
+        }
+#endif
+
+        //浮点数字符串的扫描结果，用于快速路径和回退到strtod
+        struct _FloatScanResult
+        {
+            size_t len;
+            bool negative;
+            int special;   //0为普通数字，1为inf，2为nan
+            bool exact;   //有效数字不超过19位，mantissa和exp10可以精确表示输入
+            unsigned long long mantissa;
+            int exp10;
+        };
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE bool _matchNoCase(const char* p, const char* end, const char* word)
+        {
+            for (; *word != '\0'; p++, word++)
+            {
+                if (p == end || (*p | 0x20) != *word)
+                    return false;
+            }
+            return true;
+        }
+
+        //扫描十进制整数，得到绝对值，超出max_magnitude时返回-2
+        _MINE_INLINE int _parseInteger(StrView s, bool is_signed, unsigned long long max_positive, unsigned long long& magnitude, bool& negative, size_t* parsed_len)
+        {
+            const char* p = s.begin();
+            const char* end = s.end();
+            negative = false;
+            if (p != end && (*p == '+' || (*p == '-' && is_signed)))
+                negative = *p++ == '-';
+            const unsigned long long max_magnitude = negative ? max_positive + 1 : max_positive;
+
+            const char* digits_begin = p;
+            unsigned long long result = 0;
+            bool overflow = false;
+            for (; p != end && (unsigned char)(*p - '0') < 10; p++)
+            {
+                const unsigned int digit = *p - '0';
+                if (result > (max_magnitude - digit) / 10)
+                    overflow = true;
+                else result = result * 10 + digit;
+            }
+            if (p == digits_begin || (parsed_len == nullptr && p != end))
+                return -1;
+            if (parsed_len != nullptr)
+                *parsed_len = p - s.begin();
+            if (overflow)
+                return -2;
+            magnitude = result;
+            return 0;
+        }
+
+        //按"[+-]digits[.digits][(e|E)[+-]digits]"或inf、nan格式扫描浮点数，不符合格式时len为0
+        _MINE_INLINE _FloatScanResult _scanFloat(StrView s)
+        {
+            _FloatScanResult result = { 0, false, 0, true, 0, 0 };
+            const char* p = s.begin();
+            const char* end = s.end();
+            if (p != end && (*p == '+' || *p == '-'))
+                result.negative = *p++ == '-';
+
+            if (mstr::_matchNoCase(p, end, "inf"))
+            {
+                result.special = 1;
+                p += mstr::_matchNoCase(p, end, "infinity") ? 8 : 3;
+                result.len = p - s.begin();
+                return result;
+            }
+            if (mstr::_matchNoCase(p, end, "nan"))
+            {
+                result.special = 2;
+                result.len = p + 3 - s.begin();
+                return result;
+            }
+
+            size_t digit_count = 0;   //已读入的有效数字个数，不含开头的0
+            bool has_digit = false;
+            int dropped_exp = 0;   //整数部分中超出19位、未计入mantissa的位数
+            for (; p != end && (unsigned char)(*p - '0') < 10; p++)
+            {
+                has_digit = true;
+                if (digit_count < 19)
+                {
+                    result.mantissa = result.mantissa * 10 + (*p - '0');
+                    if (result.mantissa != 0)
+                        digit_count++;
+                }
+                else
+                {
+                    dropped_exp++;
+                    if (*p != '0')
+                        result.exact = false;
+                }
+            }
+            if (p != end && *p == '.')
+            {
+                p++;
+                for (; p != end && (unsigned char)(*p - '0') < 10; p++)
+                {
+                    has_digit = true;
+                    if (digit_count < 19)
+                    {
+                        result.mantissa = result.mantissa * 10 + (*p - '0');
+                        if (result.mantissa != 0)
+                            digit_count++;
+                        result.exp10--;
+                    }
+                    else if (*p != '0')
+                        result.exact = false;
+                }
+            }
+            if (!has_digit)
+                return result;
+            result.exp10 += dropped_exp;
+
+            if (p != end && (*p == 'e' || *p == 'E'))
+            {
+                const char* exp_p = p + 1;
+                bool exp_negative = false;
+                if (exp_p != end && (*exp_p == '+' || *exp_p == '-'))
+                    exp_negative = *exp_p++ == '-';
+                if (exp_p != end && (unsigned char)(*exp_p - '0') < 10)
+                {
+                    int exp_value = 0;
+                    for (; exp_p != end && (unsigned char)(*exp_p - '0') < 10; exp_p++)
+                    {
+                        if (exp_value < 100000)   //足以让结果溢出或归零，继续累加没有意义
+                            exp_value = exp_value * 10 + (*exp_p - '0');
+                    }
+                    result.exp10 += exp_negative ? -exp_value : exp_value;
+                    p = exp_p;
+                }
+            }
+            result.len = p - s.begin();
+            return result;
+        }
+
+        //复制到以'\0'结尾的缓冲区供strtod系列函数使用，并把小数点替换为当前locale的小数点
+        _MINE_INLINE const char* _prepareStrtodInput(const char* p, size_t len, char* stack_buf, size_t stack_size, std::string& heap_buf)
+        {
+            char* buf = stack_buf;
+            if (len >= stack_size)
+            {
+                heap_buf.assign(len + 1, '\0');
+                buf = &heap_buf[0];
+            }
+            memcpy(buf, p, len);
+            buf[len] = '\0';
+            const char decimal_point = localeconv()->decimal_point[0];
+            if (decimal_point != '.')
+            {
+                char* dot = (char*)memchr(buf, '.', len);
+                if (dot != nullptr)
+                    *dot = decimal_point;
+            }
+            return buf;
+        }
+
+        //快速路径无法精确转换时回退到C库，溢出时err为-2
+        _MINE_INLINE void _strToFloat(const char* p, size_t len, float& value, int& err)
+        {
+            char stack_buf[64];
+            std::string heap_buf;
+            const char* buf = mstr::_prepareStrtodInput(p, len, stack_buf, sizeof(stack_buf), heap_buf);
+            errno = 0;
+            value = strtof(buf, nullptr);
+            err = (errno == ERANGE && std::isinf(value)) ? -2 : 0;
+        }
+
+        _MINE_INLINE void _strToFloat(const char* p, size_t len, double& value, int& err)
+        {
+            char stack_buf[64];
+            std::string heap_buf;
+            const char* buf = mstr::_prepareStrtodInput(p, len, stack_buf, sizeof(stack_buf), heap_buf);
+            errno = 0;
+            value = strtod(buf, nullptr);
+            err = (errno == ERANGE && std::isinf(value)) ? -2 : 0;
+        }
+
+        _MINE_INLINE void _strToFloat(const char* p, size_t len, long double& value, int& err)
+        {
+            char stack_buf[64];
+            std::string heap_buf;
+            const char* buf = mstr::_prepareStrtodInput(p, len, stack_buf, sizeof(stack_buf), heap_buf);
+            errno = 0;
+            value = strtold(buf, nullptr);
+            err = (errno == ERANGE && std::isinf(value)) ? -2 : 0;
+        }
+
+        /*  有效数字和10的幂都能被精确表示时，一次乘除即可得到正确舍入的结果(Clinger快速路径)
+            - 要求浮点运算不使用更高的中间精度，否则返回false交由C库处理   */
+        _MINE_INLINE bool _fastFloatFromParts(const _FloatScanResult& scan, float& value)
+        {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+            static const float pow10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+            if (!scan.exact || scan.mantissa > (1ull << 24) || scan.exp10 < -10 || scan.exp10 > 10)
+                return scan.exact && scan.mantissa == 0 ? (value = 0.f, true) : false;
+            const float mantissa = (float)scan.mantissa;
+            value = scan.exp10 < 0 ? mantissa / pow10[-scan.exp10] : mantissa * pow10[scan.exp10];
+            return true;
+#else
+            return false;
+#endif
+        }
 
+        _MINE_INLINE bool _fastFloatFromParts(const _FloatScanResult& scan, double& value)
+        {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+            static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+            if (!scan.exact || scan.mantissa > (1ull << 53) || scan.exp10 < -22 || scan.exp10 > 22)
+                return scan.exact && scan.mantissa == 0 ? (value = 0., true) : false;
+            const double mantissa = (double)scan.mantissa;
+            value = scan.exp10 < 0 ? mantissa / pow10[-scan.exp10] : mantissa * pow10[scan.exp10];
+            return true;
+#else
+            return false;
+#endif
+        }
 
-        template<int8_t float_precision, class T, typename std::enable_if<!mtype::ConstructibleFromEachChecker<std::string, const T&>::value, int>::type = 0>
-        inline std::string _toStrDispath(const T& arg)
+        _MINE_INLINE bool _fastFloatFromParts(const _FloatScanResult& scan, long double& value)
         {
-#if defined(__GNUC__) && !_mgccMinVersion(4, 8, 1)
-            std::ostringstream oss;
+            if (scan.exact && scan.mantissa == 0)
+            {
+                value = 0.L;
+                return true;
+            }
+            return false;
+        }
 #else
-            //QNX710的gcc8.3.0似乎没法正确处理子线程的thread_local std::ostringstream对象，只能用指针来管理
-            thread_local std::unique_ptr<std::ostringstream> oss_ptr(new std::ostringstream);
-            std::ostringstream& oss = *oss_ptr;
+        int _parseInteger(StrView s, bool is_signed, unsigned long long max_positive, unsigned long long& magnitude, bool& negative, size_t* parsed_len);
+        _FloatScanResult _scanFloat(StrView s);
+        void _strToFloat(const char* p, size_t len, float& value, int& err);
+        void _strToFloat(const char* p, size_t len, double& value, int& err);
+        void _strToFloat(const char* p, size_t len, long double& value, int& err);
+        bool _fastFloatFromParts(const _FloatScanResult& scan, float& value);
+        bool _fastFloatFromParts(const _FloatScanResult& scan, double& value);
+        bool _fastFloatFromParts(const _FloatScanResult& scan, long double& value);
 #endif
-            oss.clear();
-            oss.str("");
-            if (float_precision >= 0)
-                oss << std::fixed << std::setprecision(float_precision);
-            //else oss << std::fixed;
-            mstr::_osInput(oss, arg);
-            return oss.str();
+
+        template<class T>
+        inline int _parseArithmetic(StrView s, T& value, size_t* parsed_len, std::integral_constant<int, 1>)
+        {
+            size_t len;
+            bool result;
+            if (s.size() >= 4 && memcmp(s.data(), "true", 4) == 0)
+                len = 4, result = true;
+            else if (s.size() >= 5 && memcmp(s.data(), "false", 5) == 0)
+                len = 5, result = false;
+            else if (!s.empty() && (s[0] == '0' || s[0] == '1'))
+                len = 1, result = s[0] == '1';
+            else return -1;
+            if (parsed_len == nullptr && len != s.size())
+                return -1;
+            if (parsed_len != nullptr)
+                *parsed_len = len;
+            value = result;
+            return 0;
         }
 
-        template<int8_t float_precision, class T, typename std::enable_if<mtype::ConstructibleFromEachChecker<std::string, const T&>::value, int>::type = 0>
-        inline std::string _toStrDispath(const T& arg)
+        template<class T>
+        inline int _parseArithmetic(StrView s, T& value, size_t* parsed_len, std::integral_constant<int, 2>)
         {
-            return arg;
+            if (s.empty() || (parsed_len == nullptr && s.size() != 1))
+                return -1;
+            if (parsed_len != nullptr)
+                *parsed_len = 1;
+            value = (T)s[0];
+            return 0;
         }
 
-        template<int8_t float_precision, class T>
-        inline std::string toStr(const T& arg)
+        template<class T>
+        inline int _parseArithmetic(StrView s, T& value, size_t* parsed_len, std::integral_constant<int, 3>)
         {
-            return mstr::_toStrDispath<float_precision>(arg);
+            unsigned long long magnitude;
+            bool negative;
+            const int ret = mstr::_parseInteger(s, std::is_signed<T>::value, (unsigned long long)std::numeric_limits<T>::max(), magnitude, negative, parsed_len);
+            if (ret != 0)
+                return ret;
+            value = negative ? (T)(-(long long)(magnitude - 1) - 1) : (T)magnitude;   //magnitude可能等于最小负数的绝对值，不能直接取负
+            return 0;
         }
 
-        template<class T, typename std::enable_if<std::is_signed<T>::value, int>::type = 0>
-        inline std::string _ordinalize(T num)
+        template<class T>
+        inline int _parseArithmetic(StrView s, T& value, size_t* parsed_len, std::integral_constant<int, 4>)
         {
-            const auto abs_num = abs(num);
-            if ((abs_num % 10 == 1) && (abs_num % 100 != 11))
-                return mstr::toStr(num).append("st");
-            else if ((abs_num % 10 == 2) && (abs_num % 100 != 12))
-                return mstr::toStr(num).append("nd");
-            else if ((abs_num % 10 == 3) && (abs_num % 100 != 13))
-                return mstr::toStr(num).append("rd");
-            else return mstr::toStr(num).append("th");
+            const _FloatScanResult scan = mstr::_scanFloat(s);
+            if (scan.len == 0 || (parsed_len == nullptr && scan.len != s.size()))
+                return -1;
+            if (parsed_len != nullptr)
+                *parsed_len = scan.len;
+
+            T result;
+            if (scan.special != 0)
+                result = scan.special == 1 ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::quiet_NaN();
+            else if (!mstr::_fastFloatFromParts(scan, result))
+            {
+                int err;
+                mstr::_strToFloat(s.data(), scan.len, result, err);   //输入中已包含符号
+                if (err != 0)
+                    return err;
+                value = result;
+                return 0;
+            }
+            value = scan.negative ? -result : result;
+            return 0;
         }
 
-        template<class T, typename std::enable_if<!std::is_signed<T>::value, int>::type = 0>
-        inline std::string _ordinalize(T num)
+        template<class T>
+        inline int parse(StrView s, T& value, size_t* parsed_len)
         {
-            if ((num % 10 == 1) && (num % 100 != 11))
-                return mstr::toStr(num).append("st");
-            else if ((num % 10 == 2) && (num % 100 != 12))
-                return mstr::toStr(num).append("nd");
-            else if ((num % 10 == 3) && (num % 100 != 13))
-                return mstr::toStr(num).append("rd");
-            else return mstr::toStr(num).append("th");
+            static_assert(std::is_arithmetic<T>::value, "mstr::parse only supports arithmetic types!");
+            return mstr::_parseArithmetic(s, value, parsed_len, typename _FormatArgKind<T>::type());
         }
 
-        template<class T, typename std::enable_if<std::is_integral<T>::value, int>::type>
-        inline std::string ordinalize(T number)
+        template<class T>
+        inline int _parseTypedNumber(StrView s, T& value, std::true_type)
         {
-            return mstr::_ordinalize(number + 0);   //将字符型当作整型
+            int number = 0;
+            const int ret = mstr::parse(s, number);
+            if (ret != 0)
+                return ret;
+            if (number < static_cast<int>(std::numeric_limits<T>::min()) || number > static_cast<int>(std::numeric_limits<T>::max()))
+                return -2;
+            value = static_cast<T>(number);
+            return 0;
         }
 
+        template<class T>
+        inline int _parseTypedNumber(StrView s, T& value, std::false_type)
+        {
+            return mstr::parse(s, value);
+        }
 
-        //format函数的相关
-        inline void _format(std::ostream& oss, const std::string& s, size_t pos_offset)
+        /*  供选项、配置项等带类型的数值使用：signed char和unsigned char(即int8_t和uint8_t)按十进制整数解析，
+            而不是像parse那样当作单个字符，其他类型同parse   */
+        template<class T>
+        inline int _parseTypedNumber(StrView s, T& value)
         {
-            oss.write(s.data() + pos_offset, s.length() - pos_offset);
+            return mstr::_parseTypedNumber(s, value, std::integral_constant<bool, std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value>());
         }
 
-        //format函数的相关
-        template<class Arg, class... Args>
-        inline void _format(std::ostream& oss, const std::string& s, size_t pos_offset, const Arg& arg, const Args& ...args)
+        template<class T>
+        inline std::string _typedNumberToStr(const T& value, std::true_type)
         {
-            size_t pos = s.find("{}", pos_offset);
-            if (pos != std::string::npos)
-            {
-                oss.write(s.data() + pos_offset, pos - pos_offset);
-                mstr::_osInput(oss, arg);
-                pos_offset = pos + 2;
-                mstr::_format(oss, s, pos_offset, args...);
-            }
+            return mstr::toStr(static_cast<int>(value));
         }
 
+        template<class T>
+        inline std::string _typedNumberToStr(const T& value, std::false_type)
+        {
+            return mstr::toStr(value);
+        }
 
-        template<int8_t float_precision, class... Args>
-        inline std::string format(const std::string& f_string, const Args& ...args)
+        //与_parseTypedNumber对应，signed char和unsigned char转换为十进制整数，其他类型同toStr
+        template<class T>
+        inline std::string _typedNumberToStr(const T& value)
         {
-#if defined(__GNUC__) && !_mgccMinVersion(4, 8, 1)
-            std::ostringstream oss;
-#else
-            //QNX710的gcc8.3.0似乎没法正确处理子线程的thread_local std::ostringstream对象，只能用指针来管理
-            thread_local std::unique_ptr<std::ostringstream> oss_ptr(new std::ostringstream);
-            std::ostringstream& oss = *oss_ptr;
-#endif
-            oss.str("");
-            oss.clear();
-            if (float_precision >= 0)
-                oss << std::fixed << std::setprecision(float_precision);
-            //else oss << std::fixed;
-            mstr::_format(oss, f_string, 0, args...);
-            return oss.str();
+            return mstr::_typedNumberToStr(value, std::integral_constant<bool, std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value>());
         }
 
-        inline std::vector<std::string> split(const std::string& s, const std::string& sep, size_t max_split_times)
+        template<class T>
+        inline int parseRow(StrView line, char sep, T* values, size_t capacity)
         {
-            if (s.empty() || max_split_times == 0)
-                return { s };
-            if (sep.empty())
+            if (mstr::trimView(line).empty())
+                return 0;
+            size_t count = 0;
+            for (StrView field : mstr::splitIter(line, StrView(&sep, 1)))
             {
-                printf("!!!Error!!! \"%s\"[%s](line %d): param sep is empty!\n", MINE_FUNCSIG, __FILE__, __LINE__);
-                return { s };
+                if (count == capacity)
+                {
+                    mprintfWLimited("line has more than %d fields!\n", (int)capacity);
+                    return -1;
+                }
+                if (mstr::parse(mstr::trimView(field), values[count]) != 0)
+                {
+                    mprintfWLimited("failed to parse field %d: \"%s\"!\n", (int)count, field.str().c_str());
+                    return -1;
+                }
+                count++;
             }
-            std::vector<std::string> strs;
+            return (int)count;
+        }
 
-            size_t now_split_times = 0;
-            size_t start_pos = 0;
-            size_t sep_pos;
-            while (sep_pos = s.find(sep, start_pos), sep_pos != std::string::npos)
+        template<class T>
+        inline int parseRow(StrView line, char sep, std::vector<T>& values)
+        {
+            values.clear();
+            if (mstr::trimView(line).empty())
+                return 0;
+            for (StrView field : mstr::splitIter(line, StrView(&sep, 1)))
             {
-                strs.emplace_back(s.substr(start_pos, sep_pos - start_pos));
-                start_pos = sep_pos + sep.length();
-                now_split_times++;
-                if (now_split_times >= max_split_times)
-                    break;
+                values.push_back(T());
+                if (mstr::parse(mstr::trimView(field), values.back()) != 0)
+                {
+                    mprintfWLimited("failed to parse field %d: \"%s\"!\n", (int)values.size() - 1, field.str().c_str());
+                    return -1;
+                }
             }
-            strs.emplace_back(s.substr(start_pos));
-            return strs;
+            return (int)values.size();
         }
 
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE bool contains(StrView s, StrView sub)
+        {
+            return s.find(sub) != std::string::npos;
+        }
 
-        inline std::vector<std::string> rsplit(const std::string& s, const std::string& sep, size_t max_split_times)
+        _MINE_INLINE bool startsWith(StrView s, StrView prefix)
         {
-            if (s.empty() || max_split_times == 0)
-                return { s };
-            if (sep.empty())
+            return s.size() >= prefix.size() && memcmp(s.data(), prefix.data(), prefix.size()) == 0;
+        }
+
+        _MINE_INLINE bool endsWith(StrView s, StrView suffix)
+        {
+            return s.size() >= suffix.size() && memcmp(s.end() - suffix.size(), suffix.data(), suffix.size()) == 0;
+        }
+
+        _MINE_INLINE std::string replace(StrView s, StrView from, StrView to)
+        {
+            if (from.empty())
             {
-                printf("!!!Error!!! \"%s\"[%s](line %d): param sep is empty!\n", MINE_FUNCSIG, __FILE__, __LINE__);
-                return { s };
+                mprintfWLimited("param from is empty!\n");
+                return s.str();
             }
-            std::vector<std::string> strs;
-
-            size_t now_split_times = 0;
-            size_t start_pos = std::string::npos;
-            size_t sep_pos = std::string::npos, tmp_sep_pos;
-            while (tmp_sep_pos = s.rfind(sep, start_pos), tmp_sep_pos != std::string::npos)
+            std::string result;
+            result.reserve(s.size());
+            size_t pos = 0;
+            size_t match_pos;
+            while (match_pos = s.find(from, pos), match_pos != std::string::npos)
             {
-                sep_pos = tmp_sep_pos;
-                strs.emplace(strs.begin(), s.substr(sep_pos + sep.length(), start_pos - (sep_pos + sep.length()) + 1));
-                start_pos = sep_pos - 1;
-                now_split_times++;
-                if (now_split_times >= max_split_times || sep_pos == 0)
-                    break;
+                result.append(s.data() + pos, match_pos - pos);
+                result.append(to.data(), to.size());
+                pos = match_pos + from.size();
             }
-            strs.emplace(strs.begin(), s.substr(0, sep_pos));
-            return strs;
+            result.append(s.data() + pos, s.size() - pos);
+            return result;
         }
 
-        inline std::vector<std::string> split(const std::string& s)
+        _MINE_INLINE MultiReplacer::MultiReplacer(const std::vector<std::pair<std::string, std::string>>& from_to)
+            : from_to_(from_to), class_count_(1)
         {
-            if (s.empty())
-                return { };
-
-            std::vector<std::string> strs;
-            size_t lpos = 0;
-            size_t rpos = 0;
-            while (lpos != std::string::npos)
+            memset(this->byte_class_, 0, sizeof(this->byte_class_));
+            for (const auto& item : this->from_to_)
             {
-                lpos = s.find_first_not_of(" \t\n\r\f\v", rpos);
-                if (lpos == std::string::npos)
-                    break;
-                rpos = s.find_first_of(" \t\n\r\f\v", lpos);
-                if (lpos != rpos)
-                    strs.emplace_back(s.substr(lpos, rpos - lpos));
+                for (char c : item.first)
+                {
+                    if (this->byte_class_[(unsigned char)c] == 0)
+                        this->byte_class_[(unsigned char)c] = (unsigned char)this->class_count_++;
+                }
             }
+            const size_t k = this->class_count_;
 
-            return strs;
-        }
-
-        inline std::string trim(std::string s, const char* chars_to_remove)
-        {
-            if (s.empty())
-                return s;
+            //建立字典树
+            this->next_.assign(k, -1);
+            this->depth_.assign(1, 0);
+            this->output_.assign(1, -1);
+            for (size_t i = 0; i < this->from_to_.size(); i++)
+            {
+                const std::string& pattern = this->from_to_[i].first;
+                if (pattern.empty())
+                    continue;
+                int32_t state = 0;
+                for (char c : pattern)
+                {
+                    const size_t cls = this->byte_class_[(unsigned char)c];
+                    if (this->next_[state * k + cls] == -1)
+                    {
+                        this->next_[state * k + cls] = (int32_t)this->depth_.size();
+                        this->next_.resize(this->next_.size() + k, -1);
+                        this->depth_.push_back(this->depth_[state] + 1);
+                        this->output_.push_back(-1);
+                    }
+                    state = this->next_[state * k + cls];
+                }
+                if (this->output_[state] == -1)
+                    this->output_[state] = (int32_t)i;
+            }
 
-            size_t left_pos = s.find_first_not_of(chars_to_remove);
-            if (left_pos == std::string::npos)
-                s.clear();
-            else
+            //按层次遍历计算失配指针，并把转移表补全为DFA
+            const size_t state_count = this->depth_.size();
+            std::vector<int32_t> fail(state_count, 0);
+            this->output_link_.assign(state_count, -1);
+            std::vector<int32_t> queue;
+            queue.reserve(state_count);
+            for (size_t cls = 0; cls < k; cls++)
             {
-                s.erase(0, left_pos);
-                size_t right_pos = s.find_last_not_of(chars_to_remove);
-                s.erase(right_pos + 1, s.size());
+                int32_t& child = this->next_[cls];
+                if (child == -1)
+                    child = 0;
+                else queue.push_back(child);
+            }
+            for (size_t head = 0; head < queue.size(); head++)
+            {
+                const int32_t state = queue[head];
+                const int32_t state_fail = fail[state];
+                this->output_link_[state] = this->output_[state_fail] != -1 ? state_fail : this->output_link_[state_fail];
+                for (size_t cls = 0; cls < k; cls++)
+                {
+                    int32_t& child = this->next_[state * k + cls];
+                    const int32_t fail_child = this->next_[state_fail * k + cls];
+                    if (child == -1)
+                        child = fail_child;
+                    else
+                    {
+                        fail[child] = fail_child;
+                        queue.push_back(child);
+                    }
+                }
             }
-            return s;
         }
 
-        inline std::string ltrim(std::string s, const char* chars_to_remove)
+        _MINE_INLINE size_t MultiReplacer::find(StrView s, size_t pos, size_t* pattern_idx) const
         {
-            if (s.empty())
-                return s;
-
-            size_t left_pos = s.find_first_not_of(chars_to_remove);
-            if (left_pos == std::string::npos)
-                s.clear();
-            else s.erase(0, left_pos);
-            return s;
+            const size_t k = this->class_count_;
+            size_t best_start = std::string::npos;
+            size_t best_len = 0;
+            int32_t best_idx = -1;
+            int32_t state = 0;
+            for (size_t i = pos; i < s.size(); i++)
+            {
+                state = this->next_[state * k + this->byte_class_[(unsigned char)s[i]]];
+                int32_t out_state = this->output_[state] != -1 ? state : this->output_link_[state];
+                for (; out_state != -1; out_state = this->output_link_[out_state])
+                {
+                    const size_t len = this->depth_[out_state];
+                    const size_t start = i + 1 - len;
+                    if (start < best_start || (start == best_start && len > best_len))
+                    {
+                        best_start = start;
+                        best_len = len;
+                        best_idx = this->output_[out_state];
+                    }
+                }
+                //当前可能继续延长的匹配都开始于best_start之后，不会再有更优的结果
+                if (best_idx != -1 && i + 1 - this->depth_[state] > best_start)
+                    break;
+            }
+            if (best_idx != -1 && pattern_idx != nullptr)
+                *pattern_idx = (size_t)best_idx;
+            return best_start;
         }
 
-        inline std::string rtrim(std::string s, const char* chars_to_remove)
+        _MINE_INLINE bool MultiReplacer::matchAny(StrView s) const
         {
-            if (s.empty())
-                return s;
-
-            size_t right_pos = s.find_last_not_of(chars_to_remove);
-            if (right_pos == std::string::npos)
-                s.clear();
-            else s.erase(right_pos + 1, s.size());
-            return s;
+            return this->find(s) != std::string::npos;
         }
 
-        inline std::string lpad(std::string s, size_t target_len, const char pad_char)
+        _MINE_INLINE std::string MultiReplacer::replace(StrView s) const
         {
-            if (s.size() < target_len)
-                s.insert(0, target_len - s.size(), pad_char);
-            return s;
+            std::string result;
+            result.reserve(s.size());
+            size_t pos = 0;
+            size_t match_pos, pattern_idx = 0;
+            while (match_pos = this->find(s, pos, &pattern_idx), match_pos != std::string::npos)
+            {
+                const std::pair<std::string, std::string>& item = this->from_to_[pattern_idx];
+                result.append(s.data() + pos, match_pos - pos);
+                result.append(item.second);
+                pos = match_pos + item.first.size();
+            }
+            result.append(s.data() + pos, s.size() - pos);
+            return result;
         }
 
-        inline std::string rpad(std::string s, size_t target_len, const char pad_char)
+        _MINE_INLINE std::string replaceAll(StrView s, const std::vector<std::pair<std::string, std::string>>& from_to)
         {
-            if (s.size() < target_len)
-                s.insert(s.size(), target_len - s.size(), pad_char);
-            return s;
+            if (from_to.size() == 1 && !from_to[0].first.empty())
+                return mstr::replace(s, from_to[0].first, from_to[0].second);
+            return MultiReplacer(from_to).replace(s);
         }
+#endif
 
         template<class T>
         void _osInput(std::ostream& oss, std::initializer_list<T> arg)
@@ -453,10 +2632,12 @@ namespace mineutils
             oss << "}";
         }
 
-        inline void _osInput(std::ostream& oss, const std::string& str)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE void _osInput(std::ostream& oss, const std::string& str)
         {
             oss << str;
         }
+#endif
 
         //inline void _osInput(std::ostream& oss, const std::wstring& str)
         //{
@@ -714,6 +2895,27 @@ namespace mineutils
             ret0 = (mstr::toStr(s10) == "{hello}");
             if (!ret0) mprintfE(R"(Failed when check: mstr::toStr(s10) == "{hello}")""\n");
 
+            //算术类型不经过流转换，结果应与流输出一致
+            ret0 = true;
+            const double doubles[] = { 0.1, -2.5, 1e20, 123456789.0, 1.0 / 3, -0.0, 2.675, 1e-7, 9.9999996 };
+            for (double d : doubles)
+            {
+                std::ostringstream oss, fixed_oss;
+                oss << d;
+                fixed_oss << std::fixed << std::setprecision(2) << d;
+                ret0 = ret0 && mstr::toStr(d) == oss.str() && mstr::toStr<2>(d) == fixed_oss.str() && mstr::toStr((float)d) == mstr::toStr(double((float)d));
+            }
+            ret0 = ret0 && mstr::toStr(INT64_MIN) == "-9223372036854775808" && mstr::toStr(UINT64_MAX) == "18446744073709551615" && mstr::toStr<2>(7) == "7";
+            ret0 = ret0 && mstr::toStr('a') == "a" && mstr::toStr(true) == "1" && mstr::toStr(1.5f) == "1.5";
+            //定点格式下的超长结果不截断
+            std::ostringstream ldbl_oss, dbl_oss;
+            ldbl_oss << std::fixed << std::setprecision(2) << LDBL_MAX;
+            dbl_oss << std::fixed << std::setprecision(2) << -DBL_MAX;
+            mstr::StringBuilder ldbl_sb;
+            ret0 = ret0 && mstr::toStr<2>(LDBL_MAX) == ldbl_oss.str() && mstr::toStr<2>(-DBL_MAX) == dbl_oss.str() && mstr::toStr<2>(ldbl_sb, LDBL_MAX).str() == ldbl_oss.str();
+            ret0 = ret0 && mstr::fastFormat("{:.2f}", LDBL_MAX) == ldbl_oss.str();
+            if (!ret0) mprintfE(R"(Failed when check: toStr of arithmetic types equals the std::ostringstream output)""\n");
+
             printf("User check: mstr::Got toStr(s4) result(0x...):%s, mstr::toStr(s8) result({104, 101, 108, 108, 111}):%s\n", mstr::toStr(s4).c_str(), mstr::toStr(s8).c_str());
             printf("User check: mstr::Got toStr(s11) result(0x...):%s\n", mstr::toStr(s11).c_str());
         }
@@ -732,6 +2934,127 @@ namespace mineutils
             if (!ret0) mprintfE(R"(Failed when check: mstr::format("vector: {}", std::vector<std::vector<int>>({ {0, 1}, {2, 3} })) == "vector: {{0, 1}, {2, 3}}")""\n");
         }
 
+        //operator<<中嵌套调用fastFormat，并用大量不同的格式串使缓存被清空
+        struct _NestedFormatArg {};
+        inline std::ostream& operator<<(std::ostream& os, const _NestedFormatArg&)
+        {
+            std::vector<std::string> fmts;
+            for (int i = 0; i < 1100; i++)
+                fmts.push_back(mstr::toStr(i) + "{}");
+            for (const std::string& fmt : fmts)
+                mstr::fastFormat(fmt.c_str(), 0);
+            return os << "nested";
+        }
+
+        inline void fastFormatTest()
+        {
+            bool ret0;
+            ret0 = (mstr::fastFormat("I need {} and {}  ", 1, 2) == "I need 1 and 2  ");
+            if (!ret0) mprintfE(R"(Failed when check: mstr::fastFormat("I need {} and {}  ", 1, 2) == "I need 1 and 2  ")""\n");
+            ret0 = (mstr::fastFormat("I need {}, {} and {}  ", 1, 2) == "I need 1, 2 and {}  " && mstr::fastFormat("I need {}  ", 1, 2) == "I need 1  ");
+            if (!ret0) mprintfE(R"(Failed when check: mstr::fastFormat("I need {}, {} and {}  ", 1, 2) == "I need 1, 2 and {}  " && mstr::fastFormat("I need {}  ", 1, 2) == "I need 1  ")""\n");
+            ret0 = (mstr::fastFormat("{:.3f}|{:>8}|{:<6}|{:*^7}|", 3.14159, 42, "ab", std::string("mid")) == "3.142|      42|ab    |**mid**|");
+            if (!ret0) mprintfE(R"(Failed when check: mstr::fastFormat("{:.3f}|{:>8}|{:<6}|{:*^7}|", 3.14159, 42, "ab", std::string("mid")) == "3.142|      42|ab    |**mid**|")""\n");
+            ret0 = (mstr::fastFormat("{:08.2f} {:x} {:X} {:.2s} {{}} {}}}", -3.5, 255, 255u, "abc", 'c') == "-0003.50 ff FF ab {} c}");
+            if (!ret0) mprintfE(R"(Failed when check: mstr::fastFormat("{:08.2f} {:x} {:X} {:.2s} {{}} {}}}", -3.5, 255, 255u, "abc", 'c') == "-0003.50 ff FF ab {} c}")""\n");
+            ret0 = (mstr::fastFormat("{} {} {}", INT64_MIN, UINT64_MAX, true) == "-9223372036854775808 18446744073709551615 1");
+            if (!ret0) mprintfE(R"(Failed when check: mstr::fastFormat("{} {} {}", INT64_MIN, UINT64_MAX, true) == "-9223372036854775808 18446744073709551615 1")""\n");
+
+            //未指定格式时与format的结果一致
+            ret0 = true;
+            const double doubles[] = { 0.1, -2.5, 1e20, 123456789.0, 1.0 / 3, 0.0 };
+            for (double d : doubles)
+                ret0 = ret0 && mstr::fastFormat("[{}]", d) == mstr::format("[{}]", d);
+            if (!ret0) mprintfE(R"(Failed when check: mstr::fastFormat("[{}]", d) == mstr::format("[{}]", d))""\n");
+            char printf_buf[128];
+            snprintf(printf_buf, sizeof(printf_buf), "%.2f %.3g %.10f %g %.0f", 0.125, 2.675, 1e-5, -0.0, 2.5);
+            ret0 = (mstr::fastFormat("{:.2f} {:.3g} {:.10f} {} {:.0f}", 0.125, 2.675, 1e-5, -0.0, 2.5) == printf_buf);
+            if (!ret0) mprintfE(R"(Failed when check: mstr::fastFormat("{:.2f} {:.3g} {:.10f} {} {:.0f}", 0.125, 2.675, 1e-5, -0.0, 2.5) == printf_buf)""\n");
+            const std::string expected = "{1, 2} (null)";
+            ret0 = (mstr::fastFormat("{} {}", std::vector<int>({ 1, 2 }), (const char*)nullptr) == expected);
+            if (!ret0) mprintfE(R"(Failed when check: mstr::fastFormat("{} {}", std::vector<int>({ 1, 2 }), (const char*)nullptr) == expected)""\n");
+
+            char buf[8];
+            mstr::FormatString fmt("n={}");
+            size_t len = mstr::formatTo(buf, sizeof(buf), fmt, 123456789);
+            ret0 = (len == 11 && std::string(buf) == "n=12345" && fmt.placeholderCount() == 1);
+            if (!ret0) mprintfE(R"(Failed when check: len == 11 && std::string(buf) == "n=12345" && fmt.placeholderCount() == 1)""\n");
+
+            //同一地址的格式串内容改变时重新解析
+            char dynamic_fmt[16] = "a{}";
+            std::string s1 = mstr::fastFormat(dynamic_fmt, 1);
+            memcpy(dynamic_fmt, "b{:>3}", 7);
+            std::string s2 = mstr::fastFormat(dynamic_fmt, 1);
+            ret0 = (s1 == "a1" && s2 == "b  1");
+            if (!ret0) mprintfE(R"(Failed when check: s1 == "a1" && s2 == "b  1")""\n");
+
+            std::string long_str(300, 'x');
+            ret0 = (mstr::fastFormat("{}{}", long_str, 1) == long_str + "1");
+            if (!ret0) mprintfE(R"(Failed when check: mstr::fastFormat("{}{}", long_str, 1) == long_str + "1")""\n");
+
+            ret0 = (mstr::fastFormat("{}|{:>3}|{}", _NestedFormatArg(), 1, "end") == "nested|  1|end");
+            if (!ret0) mprintfE(R"(Failed when check: mstr::fastFormat("{}|{:>3}|{}", _NestedFormatArg(), 1, "end") == "nested|  1|end")""\n");
+
+#if (defined(__cplusplus) && __cplusplus >= 201402L) || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+            static constexpr mstr::FormatString constexpr_fmt("{:>4}-{{}}-{}");
+            static_assert(constexpr_fmt.placeholderCount() == 2, "FormatString should be parsed at compile time");
+            ret0 = (mstr::fastFormat(constexpr_fmt, 1, "x") == "   1-{}-x");
+            if (!ret0) mprintfE(R"(Failed when check: mstr::fastFormat(constexpr_fmt, 1, "x") == "   1-{}-x")""\n");
+#endif
+        }
+
+        inline void StringBuilderTest()
+        {
+            bool ret0;
+            mstr::StringBuilder sb;
+            sb.append("frame ").append(12).append(' ').append(0.5).append(std::string(" ok ")).append(std::vector<int>({ 1, 2 }));
+            ret0 = (sb.str() == "frame 12 0.5 ok {1, 2}" && strcmp(sb.c_str(), "frame 12 0.5 ok {1, 2}") == 0 && sb.capacity() == 255);
+            if (!ret0) mprintfE(R"(Failed when check: sb.str() == "frame 12 0.5 ok {1, 2}" && strcmp(sb.c_str(), "frame 12 0.5 ok {1, 2}") == 0 && sb.capacity() == 255)""\n");
+
+            sb.clear();
+            mstr::toStr<2>(sb, 3.14159);
+            mstr::toStr<2>(sb, std::vector<double>({ 1.0 }));
+            mstr::format(sb, " {}-{}", 1, std::map<int, int>({ {1, 2} }));
+            sb.appendFormat(" {:>4}|{:.1f}", 7, 2.25);
+            ret0 = (sb.str() == "3.14{1.00} 1-{1:2}    7|2.2" && sb.size() == sb.str().size());
+            if (!ret0) mprintfE(R"(Failed when check: sb.str() == "3.14{1.00} 1-{1:2}    7|2.2" && sb.size() == sb.str().size())""\n");
+
+            //超出内部缓冲区后增长到堆上，clear后保留容量
+            sb.clear();
+            std::string expected;
+            for (int i = 0; i < 200; i++)
+            {
+                sb.appendFormat("{},", i);
+                mstr::toStr(sb, std::vector<int>({ i }));
+                expected += mstr::toStr(i) + "," + "{" + mstr::toStr(i) + "}";
+            }
+            const size_t capacity = sb.capacity();
+            sb.clear();
+            ret0 = (capacity > 255 && sb.empty() && sb.capacity() == capacity && strcmp(sb.c_str(), "") == 0);
+            ret0 = ret0 && (mstr::toStr(sb, expected).str() == expected && sb.capacity() == capacity);
+            if (!ret0) mprintfE(R"(Failed when check: capacity > 255 && sb.empty() && sb.capacity() == capacity && mstr::toStr(sb, expected).str() == expected)""\n");
+
+            //追加自身的内容，包括需要扩容的情况
+            mstr::StringBuilder self_sb;
+            std::string self_expected = "0123456789";
+            self_sb.append(self_expected.data(), self_expected.size());
+            for (int i = 0; i < 8; i++)
+            {
+                self_sb.append(self_sb.c_str(), self_sb.size());
+                self_expected += self_expected;
+            }
+            ret0 = (self_sb.str() == self_expected);
+            self_sb.clear();
+            self_sb.append("abc", 3);
+            self_sb.appendFormat("[{}|{}]", self_sb.c_str(), mstr::StrView(self_sb.data(), 2));
+            ret0 = ret0 && (self_sb.str() == "abc[abc|ab]");
+            std::string long_part(300, 'y');
+            self_sb.append(long_part.data(), long_part.size());
+            self_sb.appendFormat("{}{}", self_sb.c_str(), 1);
+            ret0 = ret0 && (self_sb.str() == "abc[abc|ab]" + long_part + "abc[abc|ab]" + long_part + "1");
+            if (!ret0) mprintfE(R"(Failed when check: StringBuilder::append and appendFormat with the builder's own content)""\n");
+        }
+
         inline void splitTest()
         {
             bool ret0;
@@ -768,6 +3091,103 @@ namespace mineutils
             if (!ret0) mprintfE(R"(Failed when check: mstr::rtrim(" \n\t 123 \v\r") == " \n\t 123" && mstr::rtrim(" \n\t 123") == " \n\t 123", mstr::rtrim("123 \v\r") == "123")""\n");
         }
 
+        inline void StrViewTest()
+        {
+            bool ret0;
+            const std::string line = "I need {} and {}  ";
+            std::vector<std::string> cases = { line, "", "{}", "{}{}", "a{}b{}", "{}a{}{}b", "\t a  b \n" };
+            ret0 = true;
+            for (const std::string& s : cases)
+            {
+                for (size_t max_split_times : { (size_t)-1, (size_t)0, (size_t)1, (size_t)2 })
+                {
+                    std::vector<std::string> views, iters, rviews, riters;
+                    for (mstr::StrView v : mstr::splitView(s, "{}", max_split_times))
+                        views.push_back(v.str());
+                    for (mstr::StrView v : mstr::splitIter(s, "{}", max_split_times))
+                        iters.push_back(v.str());
+                    for (mstr::StrView v : mstr::rsplitView(s, "{}", max_split_times))
+                        rviews.push_back(v.str());
+                    for (mstr::StrView v : mstr::rsplitIter(s, "{}", max_split_times))
+                        riters.insert(riters.begin(), v.str());
+                    ret0 = ret0 && (views == mstr::split(s, "{}", max_split_times) && iters == views);
+                    ret0 = ret0 && (rviews == mstr::rsplit(s, "{}", max_split_times) && riters == rviews);
+                }
+                std::vector<std::string> views;
+                for (mstr::StrView v : mstr::splitIter(s))
+                    views.push_back(v.str());
+                ret0 = ret0 && (views == mstr::split(s) && mstr::splitView(s).size() == views.size());
+                ret0 = ret0 && (mstr::trimView(s) == mstr::trim(s) && mstr::ltrimView(s) == mstr::ltrim(s) && mstr::rtrimView(s) == mstr::rtrim(s));
+            }
+            if (!ret0) mprintfE(R"(Failed when check: splitView/splitIter/rsplitView/rsplitIter/trimView results equal split/rsplit/trim)""\n");
+
+            std::vector<mstr::StrView> tokens = mstr::splitView(line, " ");
+            ret0 = (tokens.size() == 7 && tokens[2] == "{}" && tokens[2].data() == line.data() + 7 && tokens[6].empty());
+            if (!ret0) mprintfE(R"(Failed when check: tokens.size() == 7 && tokens[2] == "{}" && tokens[2].data() == line.data() + 7 && tokens[6].empty())""\n");
+
+            mstr::StrView view(line);
+            ret0 = (view.find("{}") == 7 && view.rfind("{}") == 14 && view.find('x') == std::string::npos && view.substr(100).empty() && view.substr(2, 4) == "need");
+            if (!ret0) mprintfE(R"(Failed when check: view.find("{}") == 7 && view.rfind("{}") == 14 && view.find('x') == std::string::npos && view.substr(100).empty() && view.substr(2, 4) == "need")""\n");
+            ret0 = (mstr::fastFormat("[{:>4}]", view.substr(2, 2)) == "[  ne]" && mstr::toStr(view.substr(7, 2)) == "{}");
+            if (!ret0) mprintfE(R"(Failed when check: mstr::fastFormat("[{:>4}]", view.substr(2, 2)) == "[  ne]" && mstr::toStr(view.substr(7, 2)) == "{}")""\n");
+        }
+
+        inline void parseTest()
+        {
+            bool ret0;
+            int i = 0;
+            unsigned char uc = 0;
+            long long ll = 0;
+            ret0 = (mstr::parse("-2147483648", i) == 0 && i == INT32_MIN && mstr::parse("2147483648", i) == -2 && mstr::parse("+17", i) == 0 && i == 17);
+            ret0 = ret0 && (mstr::parse("-9223372036854775808", ll) == 0 && ll == INT64_MIN && mstr::parse("a", uc) == 0 && uc == 'a');
+            if (!ret0) mprintfE(R"(Failed when check: mstr::parse("-2147483648", i) == 0 && mstr::parse("2147483648", i) == -2 && mstr::parse("-9223372036854775808", ll) == 0)""\n");
+            unsigned int u = 5;
+            ret0 = (mstr::parse("-1", u) == -1 && mstr::parse("", u) == -1 && mstr::parse(" 1", u) == -1 && mstr::parse("1x", u) == -1 && u == 5);
+            if (!ret0) mprintfE(R"(Failed when check: mstr::parse("-1", u) == -1 && mstr::parse("", u) == -1 && mstr::parse(" 1", u) == -1 && mstr::parse("1x", u) == -1 && u == 5)""\n");
+
+            double d = 0;
+            float f = 0;
+            ret0 = (mstr::parse("-1.5e-3", d) == 0 && d == -1.5e-3 && mstr::parse(".5", d) == 0 && d == 0.5 && mstr::parse("0.1", f) == 0 && f == 0.1f);
+            ret0 = ret0 && (mstr::parse("1e400", d) == -2 && mstr::parse("-Infinity", d) == 0 && d < 0 && std::isinf(d) && mstr::parse("NaN", f) == 0 && f != f);
+            ret0 = ret0 && (mstr::parse("123456789012345678901234567890", d) == 0 && d == 123456789012345678901234567890.0 && mstr::parse("2.2250738585072014e-308", d) == 0 && d == 2.2250738585072014e-308);
+            if (!ret0) mprintfE(R"(Failed when check: mstr::parse of floating-point strings equals the literals)""\n");
+
+            size_t parsed_len = 0;
+            bool b = false;
+            ret0 = (mstr::parse("3.25ms", d, &parsed_len) == 0 && d == 3.25 && parsed_len == 4 && mstr::parse("1e+x", d, &parsed_len) == 0 && parsed_len == 1);
+            ret0 = ret0 && (mstr::parse("true", b) == 0 && b && mstr::parse("0", b) == 0 && !b && mstr::parse("yes", b) == -1);
+            if (!ret0) mprintfE(R"(Failed when check: mstr::parse("3.25ms", d, &parsed_len) == 0 && parsed_len == 4 && mstr::parse("true", b) == 0)""\n");
+
+            float xyz[3] = { 0 };
+            std::vector<int> row;
+            ret0 = (mstr::parseRow("1.0, 2.5, -3\r\n", ',', xyz, 3) == 3 && xyz[0] == 1.f && xyz[1] == 2.5f && xyz[2] == -3.f);
+            ret0 = ret0 && (mstr::parseRow("10\t20\t30\t40", '\t', row) == 4 && row == std::vector<int>({ 10, 20, 30, 40 }) && mstr::parseRow("  ", ',', xyz, 3) == 0);
+            if (!ret0) mprintfE(R"(Failed when check: mstr::parseRow("1.0, 2.5, -3\r\n", ',', xyz, 3) == 3 && mstr::parseRow("10\t20\t30\t40", '\t', row) == 4)""\n");
+            printf("User check! Expected 2 warnings of \"line has more than 3 fields\" and \"failed to parse field 1\" below:\n");
+            ret0 = (mstr::parseRow("1,2,3,4", ',', xyz, 3) == -1 && mstr::parseRow("1,x,3", ',', row) == -1);
+            if (!ret0) mprintfE(R"(Failed when check: mstr::parseRow("1,2,3,4", ',', xyz, 3) == -1 && mstr::parseRow("1,x,3", ',', row) == -1)""\n");
+        }
+
+        inline void replaceTest()
+        {
+            bool ret0;
+            ret0 = (mstr::replace("a.b.c", ".", "::") == "a::b::c" && mstr::replace("aaaa", "aa", "a") == "aa" && mstr::replace("abc", "x", "y") == "abc");
+            if (!ret0) mprintfE(R"(Failed when check: mstr::replace("a.b.c", ".", "::") == "a::b::c" && mstr::replace("aaaa", "aa", "a") == "aa")""\n");
+
+            ret0 = (mstr::replaceAll("he said: 'hi' & left", { { "&", "&amp;" }, { "'", "&#39;" }, { "<", "&lt;" } }) == "he said: &#39;hi&#39; &amp; left");
+            ret0 = ret0 && (mstr::replaceAll("abcd", { { "bc", "1" }, { "abcd", "2" }, { "b", "3" } }) == "2" && mstr::replaceAll("abce", { { "bc", "1" }, { "abcd", "2" } }) == "a1e");
+            ret0 = ret0 && (mstr::replaceAll("ushers", { { "he", "H" }, { "she", "S" }, { "hers", "R" } }) == "uSrs" && mstr::replaceAll("x", { { "", "y" } }) == "x");
+            if (!ret0) mprintfE(R"(Failed when check: mstr::replaceAll matches patterns leftmost-longest in a single pass)""\n");
+
+            mstr::MultiReplacer replacer({ { "\\", "/" }, { "\r\n", "\n" } });
+            size_t pattern_idx = 0;
+            ret0 = (replacer.replace("a\\b\r\nc") == "a/b\nc" && replacer.find("ab\r\n", 0, &pattern_idx) == 2 && pattern_idx == 1 && !replacer.matchAny("abc"));
+            if (!ret0) mprintfE(R"(Failed when check: replacer.replace("a\\b\r\nc") == "a/b\nc" && replacer.find("ab\r\n", 0, &pattern_idx) == 2 && pattern_idx == 1)""\n");
+
+            ret0 = (mstr::contains("config.ini", ".in") && !mstr::contains("cfg", "cfgs") && mstr::startsWith("config.ini", "conf") && mstr::endsWith("config.ini", ".ini") && !mstr::endsWith("ini", "a.ini"));
+            if (!ret0) mprintfE(R"(Failed when check: mstr::contains/startsWith/endsWith)""\n");
+        }
+
         inline void padTest()
         {
             bool ret0;
@@ -782,8 +3202,13 @@ namespace mineutils
             printf("\n--------------------check mstr start--------------------\n");
             ordinalizeTest();
             toStrTest();
+            fastFormatTest();
+            StringBuilderTest();
             splitTest();
             trimTest();
+            StrViewTest();
+            parseTest();
+            replaceTest();
             printf("---------------------check mstr end---------------------\n\n");
         }
     }
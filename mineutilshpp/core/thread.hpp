@@ -278,7 +278,8 @@ namespace mineutils
             friend SpinLock;
         };
 
-        inline void SpinLock::lock()
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE void SpinLock::lock()
         {
             int spin_count = 0;
             const int max_spin_count = 1000; // 设置合理的最大自旋次数
@@ -297,15 +298,16 @@ namespace mineutils
             }
         }
 
-        inline void SpinLock::unlock()
+        _MINE_INLINE void SpinLock::unlock()
         {
             this->lock_flag_.clear(std::memory_order_release);
         }
 
-        inline SpinLock::Guard SpinLock::lockGuard()
+        _MINE_INLINE SpinLock::Guard SpinLock::lockGuard()
         {
             return SpinLock::Guard(this);
         }
+#endif
 
         //class ReadWriteMutex::RGuard
         //{
@@ -401,7 +403,8 @@ namespace mineutils
             friend ReadWriteMutex;
         };
 
-        inline void ReadWriteMutex::lockRead()
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE void ReadWriteMutex::lockRead()
         {
             std::unique_lock<std::mutex> lk(this->mtx_);
             while (this->is_writing_)
@@ -409,7 +412,7 @@ namespace mineutils
             this->num_readers_++;
         }
 
-        inline void ReadWriteMutex::unlockRead()
+        _MINE_INLINE void ReadWriteMutex::unlockRead()
         {
             {
                 std::lock_guard<std::mutex> lk(this->mtx_);
@@ -420,12 +423,12 @@ namespace mineutils
             this->cv_.notify_one();
         }
 
-        inline ReadWriteMutex::RGuard ReadWriteMutex::lockReadGuard()
+        _MINE_INLINE ReadWriteMutex::RGuard ReadWriteMutex::lockReadGuard()
         {
             return ReadWriteMutex::RGuard(this);
         }
 
-        inline void ReadWriteMutex::lockWrite()
+        _MINE_INLINE void ReadWriteMutex::lockWrite()
         {
             std::unique_lock<std::mutex> lk(this->mtx_);
             while (this->is_writing_ || this->num_readers_ != 0)
@@ -433,7 +436,7 @@ namespace mineutils
             this->is_writing_ = true;
         }
 
-        inline void ReadWriteMutex::unlockWrite()
+        _MINE_INLINE void ReadWriteMutex::unlockWrite()
         {
             {
                 std::lock_guard<std::mutex> lk(this->mtx_);
@@ -442,10 +445,11 @@ namespace mineutils
             this->cv_.notify_all();
         }
 
-        inline ReadWriteMutex::WGuard ReadWriteMutex::lockWriteGuard()
+        _MINE_INLINE ReadWriteMutex::WGuard ReadWriteMutex::lockWriteGuard()
         {
             return ReadWriteMutex::WGuard(this);
         }
+#endif
 
         template<class Ret>
         inline TaskFuture<Ret>::TaskFuture(TaskFuture<Ret>&& tmp_state) noexcept
@@ -471,7 +475,7 @@ namespace mineutils
         {
             if (this->future_state_.valid())
                 return this->future_state_.wait_for(std::chrono::nanoseconds(0)) == std::future_status::ready;
-            mprintfW("Task is invalid, so the function returns value:true!\n");
+            mprintfWLimited("Task is invalid, so the function returns value:true!\n");
             return true;
         }
 
@@ -480,7 +484,7 @@ namespace mineutils
         {
             if (this->future_state_.valid())
                 this->future_state_.wait();
-            else mprintfW("Task is invalid, so the function returns directly!\n");
+            else mprintfWLimited("Task is invalid, so the function returns directly!\n");
         }
 
         template<class Ret>
@@ -520,11 +524,12 @@ namespace mineutils
         }
 
 
-        inline ThreadPool::ThreadPool(uint32_t pool_size)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE ThreadPool::ThreadPool(uint32_t pool_size)
         {
             if (pool_size <= 0)
             {
-                mprintfW("Invalid param value pool_size:%d, which will be set to 1.\n", pool_size);
+                mprintfWLimited("Invalid param value pool_size:%d, which will be set to 1.\n", pool_size);
                 pool_size = 1;
             }
             this->pool_size_ = pool_size;
@@ -539,7 +544,7 @@ namespace mineutils
             }
         }
 
-        inline ThreadPool::~ThreadPool()
+        _MINE_INLINE ThreadPool::~ThreadPool()
         {
             {
                 std::unique_lock<std::mutex> lk(this->task_mtx_);
@@ -554,6 +559,7 @@ namespace mineutils
                     thd.join();
             }
         }
+#endif
 
         template<class Fn, class... Args, class Ret, typename std::enable_if<std::is_same<Ret, typename mtype::StdBindTraits<Fn, Args...>::ReturnType>::value && !std::is_reference<Ret>::value && (std::is_void<Ret>::value || std::is_copy_constructible<Ret>::value), int>::type>
         inline TaskFuture<Ret> ThreadPool::addTask(Fn&& func, Args&&... args)
@@ -569,13 +575,14 @@ namespace mineutils
             return state;
         }
 
-        inline bool ThreadPool::full()
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE bool ThreadPool::full()
         {
             std::lock_guard<std::mutex> lk(this->task_mtx_);
             return (this->working_task_num_.load(std::memory_order_acquire) + this->task_queue_.size()) >= this->pool_size_;
         }
 
-        inline void ThreadPool::worker()
+        _MINE_INLINE void ThreadPool::worker()
         {
             std::function<void()> task;
             while (!this->need_abort_)
@@ -598,17 +605,17 @@ namespace mineutils
         }
 
 
-        inline ThreadPauser::ThreadPauser()
+        _MINE_INLINE ThreadPauser::ThreadPauser()
         {
             this->need_pause_.store(false);
         }
 
-        inline ThreadPauser::~ThreadPauser()
+        _MINE_INLINE ThreadPauser::~ThreadPauser()
         {
             this->resume();
         }
 
-        inline void ThreadPauser::setPausePoint(uint8_t point_id)
+        _MINE_INLINE void ThreadPauser::setPausePoint(uint8_t point_id)
         {
             if (this->need_pause_.load(std::memory_order_relaxed))
             {
@@ -626,12 +633,12 @@ namespace mineutils
             this->splk_.unlock();
         }
 
-        inline void ThreadPauser::pause()
+        _MINE_INLINE void ThreadPauser::pause()
         {
             this->need_pause_.store(true, std::memory_order_relaxed);
         }
 
-        inline void ThreadPauser::resume()
+        _MINE_INLINE void ThreadPauser::resume()
         {
             {
                 std::lock_guard<std::mutex> lk(this->mtx_);
@@ -640,7 +647,7 @@ namespace mineutils
             this->cond_.notify_all();  //据说notify内部，先加锁cond_var内部锁，再通知，因此不用担心cond_var在lk解锁后进入wait前，notify触发而导致错过
         }
 
-        inline bool ThreadPauser::isPaused(uint8_t point_id)
+        _MINE_INLINE bool ThreadPauser::isPaused(uint8_t point_id)
         {
             {
                 auto lk_guard = this->splk_.lockGuard();
@@ -648,9 +655,10 @@ namespace mineutils
                 if (it != this->state_map_.end())
                     return it->second;
             }
-            mprintfW("The param point_id not found, so the function returns value:false!\n");
+            mprintfWLimited("The param point_id not found, so the function returns value:false!\n");
             return false;
         }
+#endif
     }
 
 
@@ -4,11 +4,18 @@
 #ifndef TIME_HPP_MINEUTILS
 #define TIME_HPP_MINEUTILS
 
+#include<algorithm>
 #include<array>
+#include<atomic>
 #include<chrono>
+#include<functional>
 #include<iostream>
 #include<list>
 #include<map>
+#include<math.h>
+#include<memory>
+#include<mutex>
+#include<sstream>
 #include<utility>
 #include<unordered_map>
 #include<stdio.h>
@@ -17,9 +24,17 @@
 #include<thread>
 #include<time.h>
 #include<type_traits>
+#include<vector>
 
 #include"base.hpp"
 
+#if defined(__linux__)
+#include<linux/perf_event.h>
+#include<sys/ioctl.h>
+#include<sys/syscall.h>
+#include<unistd.h>
+#endif
+
 
 namespace mineutils
 {
@@ -69,6 +84,10 @@ namespace mineutils
             DateTime localTime() const;
             DateTime utcTime() const;
 
+            /*  获取时间点对应的当地时间字符串，同一线程在同一秒内的重复调用会复用缓存的结果
+                - 格式："2025-01-07 17:18:35 STD"，with_ms为true时为"2025-01-07 17:18:35.123 STD"  */
+            std::string formatLocalTime(bool with_ms = false) const;
+
             //根据unit计算从tp到当前时间点之间的时长
             template<Unit unit>
             long long since(const TimePoint& tp) const;
@@ -134,6 +153,14 @@ namespace mineutils
                 @return 一个私有类Guard对象，只能用auto推导；在返回时记录开始时间，在调用release或析构时记录结束时间  */
             MeanTimeCounter::Guard markGuard(std::string codeblock_tag);
 
+            /*  为代码段开启硬件性能计数器，在打印平均耗时的同时打印IPC、L1D和LLC每千条指令的缺失数及分支预测失败率
+                - 仅支持Linux，基于perf_event_open实现，只统计调用本函数的线程的用户态事件
+                - 系统不支持或权限不足(如/proc/sys/kernel/perf_event_paranoid过高)时打印一次警告并返回失败，不影响计时功能
+                - 每次markStart和markEnd会各增加一次系统调用的开销，该开销不计入耗时
+                @param codeblock_tag: 要统计的代码段的tag
+                @return 0代表正常，其他代表失败   */
+            int enableHardwareCounters(const std::string& codeblock_tag);
+
             /*  在每个被统计的代码段达到目标统计次数后，打印其平均消耗时间并重新开始统计此段代码  */
             template<Unit unit>
             void printOnTargetCount();
@@ -156,6 +183,76 @@ namespace mineutils
         };
 
 
+        /*  按调用路径分层统计嵌套代码段的耗时，打印调用树形式的报告，线程安全
+            - 每个线程维护独立的代码段栈，同一线程内后开始的代码段作为先开始代码段的子节点
+            - 同名代码段在不同调用路径下作为不同节点统计
+            - 每个节点统计总耗时(包含子代码段)和自身耗时(不包含子代码段)
+            - 在不支持thread_local的编译器(如QNX660的GCC4.7.3)上只能在单线程中使用   */
+        class ScopeProfiler
+        {
+        private:
+            class Guard;
+
+        public:
+            /*  构造ScopeProfiler类
+                @param print_header: 打印时的头信息，为空时表示无头信息
+                @param enabled: 是否开启计时功能  */
+            ScopeProfiler(std::string print_header = "", bool enabled = true);
+
+            //清除当前线程中本对象未结束的代码段
+            ~ScopeProfiler();
+
+            /*  代码段统计开始，应在目标统计代码段前调用，与段后markEnd成对出现
+                @param scope_tag: 要统计的代码段的tag   */
+            void markStart(const std::string& scope_tag);
+
+            /*  代码段统计结束，应在目标统计代码段后调用，与段前markStart成对出现，且需按嵌套顺序结束
+                - 其内层还有未结束的代码段时给出警告，并丢弃这些代码段，不计入统计
+                @param scope_tag: 要统计的代码段的tag   */
+            void markEnd(const std::string& scope_tag);
+
+            /*  使用RAII方式安全记录一段代码的耗时，自动调用markStart和markEnd
+                - 用例：auto guard = profiler.markGuard("scope_tag")
+                @param scope_tag: 要统计的代码段的tag
+                @return 一个私有类Guard对象，只能用auto推导；在返回时记录开始时间，在调用release或析构时记录结束时间  */
+            ScopeProfiler::Guard markGuard(std::string scope_tag);
+
+            /*  按调用树打印各代码段的统计结果，子节点缩进显示
+                - 格式：tag: total 总耗时, self 自身耗时, mean 平均总耗时 in 次数 counts (占父节点总耗时的百分比)  */
+            template<Unit unit>
+            void printReport();
+
+            //清空已有的统计数据，保留调用树结构
+            void reset();
+
+            //禁止拷贝和移动
+            ScopeProfiler(const ScopeProfiler& tmp) = delete;
+            ScopeProfiler& operator=(const ScopeProfiler& tmp) = delete;
+
+        private:
+            struct Node
+            {
+                std::string tag;
+                int parent_id = -1;
+                std::vector<int> children_ids;
+                long long count = 0;
+                std::chrono::nanoseconds total_cost{ 0 };
+                std::chrono::nanoseconds children_cost{ 0 };
+            };
+
+            int findOrCreateChild(int parent_id, const std::string& scope_tag);
+            template<Unit unit>
+            void printNode(int node_id, int depth);
+
+            std::string print_header_;
+            bool self_enabled_ = true;
+            unsigned long long id_;    //进程内唯一，线程栈中的帧以此区分所属对象，对象销毁后地址被复用也不会误认
+
+            std::mutex mtx_;
+            std::vector<Node> nodes_;   //nodes_[0]为根节点
+        };
+
+
         /*  统计并打印该对象从获取资源到释放资源之间的时间消耗
             - 用例：TimeCounterGuard<mtime::ms> guard("tag");    //获取资源
             - 用例：guard.reset("tag");    //释放旧资源，获取新资源  */
@@ -192,7 +289,8 @@ namespace mineutils
         /*  设置从获取资源到释放资源的代码段的最短时间
             - 用例1：MinTimeGuard<mtime::ms> guard(50);    //获取资源，保证从当前到释放资源之间的代码段时间不低于50毫秒
             - 用例2：guard.reset(50);    //释放旧资源，获取新资源
-            注意：在QNX660的GCC4.7.3上，实际精度为1000ns以上   */
+            - 用例3：MinTimeGuard<mtime::us> guard(500, true);    //高精度模式，先休眠至目标时间点前的校准余量处，再自旋等待至目标时间点
+            注意：在QNX660的GCC4.7.3上，非高精度模式的实际精度为1000ns以上；高精度模式会在最后的余量时间内占用CPU   */
         template<Unit unit>
         class MinTimeGuard
         {
@@ -200,13 +298,14 @@ namespace mineutils
             //构造空对象，无资源
             MinTimeGuard() = default;
             /*  构造对象，获取资源，统计从当前到资源释放之间的时间消耗
-                @param target_time: 目标时长  */
-            MinTimeGuard(long long target_time);
+                @param target_time: 目标时长
+                @param high_precision: 是否使用先休眠后自旋的高精度模式  */
+            MinTimeGuard(long long target_time, bool high_precision = false);
 
             //提前释放资源并将对象置空
             void release();
             //释放旧资源，获取新资源
-            void reset(long long target_time);
+            void reset(long long target_time, bool high_precision = false);
 
             //禁止拷贝和移动
             MinTimeGuard(const MinTimeGuard<unit>& obj) = delete;
@@ -215,11 +314,116 @@ namespace mineutils
             ~MinTimeGuard();
 
         private:
-            void create(long long target_time);    //不检查有效性并创建资源
+            void create(long long target_time, bool high_precision);    //不检查有效性并创建资源
             void destroy();    //释放资源，不修改有效性
 
             bool valid_ = false;
+            bool high_precision_ = false;
+            std::chrono::steady_clock::time_point target_tp_;
+        };
+
+        /*  按固定帧率控制循环节奏，非线程安全
+            - 用例：FrameRateLimiter limiter(30);  while (true) { ... limiter.wait(); }
+            - 每帧的目标时间点由上一帧的目标时间点累加周期得到，而非由当前时间计算，因此休眠误差不会累积为帧率漂移
+            - 某帧超时不足一个周期时不休眠，并保持原有节奏；超时达到一个周期以上时，从当前时间重新对齐，不追赶丢失的帧
+            - 默认使用先休眠后自旋的高精度模式，会在每帧最后的余量时间内占用CPU   */
+        class FrameRateLimiter
+        {
+        public:
+            /*  构造FrameRateLimiter类，从构造时开始计算第一帧
+                @param fps: 目标帧率，不大于0的值会被置为1
+                @param high_precision: 是否使用先休眠后自旋的高精度模式  */
+            FrameRateLimiter(double fps, bool high_precision = true);
+
+            //等待至当前帧的目标时间点，应在每帧结束时调用
+            void wait();
+
+            //以当前时间作为新一帧的起点，并清空抖动统计
+            void reset();
+
+            /*  打印抖动统计，即按时唤醒的帧的实际唤醒时刻相对目标时间点的延迟
+                - 格式：frame period 周期, 帧数 frames, lateness mean 平均延迟, max 最大延迟, stddev 标准差, 超时帧数 overruns  */
+            template<Unit unit>
+            void printJitterReport();
+
+        private:
+            std::chrono::steady_clock::duration period_;
             std::chrono::steady_clock::time_point target_tp_;
+            bool high_precision_ = true;
+
+            long long frame_count_ = 0;
+            long long overrun_count_ = 0;
+            double lateness_sum_ = 0;    //ns
+            double lateness_square_sum_ = 0;    //ns^2
+            long long lateness_max_ = 0;    //ns
+        };
+
+        /*  统计事件数或数据量的速率，如帧率、字节每秒，内存占用固定
+            - tick可在多个线程中并发调用，仅为一次原子加法，不加锁
+            - 速率在poll时采样更新：滑动窗口速率为窗口内的增量除以时长，指数加权速率以窗口时长为时间常数平滑
+            - 用例：RateMeter meter("decode");  meter.setReporter(1000);  生产线程中meter.tick();  监控线程中周期性调用meter.poll();   */
+        class RateMeter
+        {
+        public:
+            /*  构造RateMeter类，从构造时开始计数
+                @param print_header: 打印时的头信息，为空时表示无头信息
+                @param window_seconds: 滑动窗口的时长(秒)，也是指数加权的时间常数，不大于0的值会被置为1
+                @param sample_count: 滑动窗口内的采样点数，越大则窗口边界越精确，小于1的值会被置为1  */
+            RateMeter(std::string print_header = "", double window_seconds = 5, int sample_count = 10);
+
+            //累加计数，线程安全
+            void tick(long long n = 1);
+
+            //采样当前计数并更新速率，到达汇报周期时调用汇报函数，应周期性调用，线程安全
+            void poll();
+
+            //获取最近一次poll时的滑动窗口速率(每秒)
+            double windowRate();
+
+            //获取最近一次poll时的指数加权速率(每秒)
+            double ewmaRate();
+
+            //获取累计计数
+            long long total() const;
+
+            /*  设置周期性汇报，poll时若距上次汇报已超过interval_ms毫秒则汇报一次
+                @param interval_ms: 汇报周期(毫秒)，不大于0时关闭汇报
+                @param reporter: 汇报函数，参数依次为头信息、滑动窗口速率、指数加权速率和累计计数，为空时调用printRate  */
+            void setReporter(long long interval_ms, std::function<void(const std::string&, double, double, long long)> reporter = nullptr);
+
+            /*  打印最近一次poll时的速率
+                - 格式：头信息: window rate 滑动窗口速率/s, ewma rate 指数加权速率/s, total 累计计数  */
+            void printRate();
+
+            //清空计数和速率，以当前时间重新开始统计
+            void reset();
+
+            RateMeter(const RateMeter& _temp) = delete;
+            RateMeter& operator=(const RateMeter& _temp) = delete;
+
+        private:
+            struct Sample
+            {
+                std::chrono::steady_clock::time_point tp;
+                long long count = 0;
+            };
+
+            std::string print_header_;
+            std::chrono::steady_clock::duration window_;
+            std::chrono::steady_clock::duration sample_interval_;
+            std::atomic<long long> count_;
+
+            std::mutex mtx_;
+            std::vector<Sample> samples_;    //环形缓冲区
+            size_t newest_pos_ = 0;
+            size_t sample_num_ = 0;
+            Sample last_poll_;
+            double window_rate_ = 0;
+            double ewma_rate_ = 0;
+
+            long long report_interval_ms_ = 0;
+            std::chrono::steady_clock::time_point last_report_tp_;
+            std::function<void(const std::string&, double, double, long long)> reporter_;
         };
     }
 
@@ -234,9 +438,24 @@ namespace mineutils
 
     namespace mtime
     {
-        inline std::ostream& operator<<(std::ostream& cout_obj, const DateTime& date_time)
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE bool _isSameDateTime(const DateTime& a, const DateTime& b)
+        {
+            return a.valid == b.valid && a.second == b.second && a.minute == b.minute && a.hour == b.hour && a.mday == b.mday
+                && a.month == b.month && a.year == b.year && a.isdst == b.isdst && a.isutc == b.isutc;
+        }
+
+        _MINE_INLINE std::ostream& operator<<(std::ostream& cout_obj, const DateTime& date_time)
         {
             _MINE_THREAD_LOCAL_IF_HAVE char fmt_date[32];
+            _MINE_THREAD_LOCAL_IF_HAVE DateTime last_date_time;
+            _MINE_THREAD_LOCAL_IF_HAVE bool has_last = false;
+            //同一秒内的重复输出直接复用上次格式化的结果
+            if (has_last && mtime::_isSameDateTime(date_time, last_date_time))
+            {
+                cout_obj << fmt_date;
+                return cout_obj;
+            }
 
             const char* fmt = nullptr;
             if (!date_time.valid)
@@ -248,33 +467,27 @@ namespace mineutils
             else fmt = "%04d-%02d-%02d %02d:%02d:%02d STD";
 
             snprintf(fmt_date, sizeof(fmt_date), fmt, date_time.year, date_time.month, date_time.mday, date_time.hour, date_time.minute, date_time.second);
+            last_date_time = date_time;
+            has_last = true;
             cout_obj << fmt_date;
             return cout_obj;
         }
 
 
-        inline DateTime TimePoint::localTime() const
+        _MINE_INLINE DateTime TimePoint::localTime() const
         {
             auto& now = this->system_tp_;
             time_t now_time_t = std::chrono::system_clock::to_time_t(now);
 
             DateTime date_time;
             date_time.valid = false;
-            tm buf;
-#if defined(_MSC_VER)
-            errno_t err = localtime_s(&buf, &now_time_t);
-            if (err != 0)
-            {
-                mprintfW("Got Invalid DateTime!\n");
-                return date_time;
-            }
-#else
-            if (localtime_r(&now_time_t, &buf) == nullptr)
+            const mbase::_LocalTimeCache& cache = mbase::_getLocalTimeCache(now_time_t);
+            if (!cache.valid)
             {
-                mprintfW("Got Invalid DateTime!\n");
+                mprintfWLimited("Got Invalid DateTime!\n");
                 return date_time;
             }
-#endif
+            const tm& buf = cache.buf;
             date_time.year = buf.tm_year + 1900;
             date_time.yday = buf.tm_yday + 1;
             date_time.month = buf.tm_mon + 1;
@@ -290,7 +503,7 @@ namespace mineutils
             return date_time;
         }
 
-        inline DateTime TimePoint::utcTime() const
+        _MINE_INLINE DateTime TimePoint::utcTime() const
         {
             auto& now = this->system_tp_;
             auto time_t_now = std::chrono::system_clock::to_time_t(now);
@@ -301,14 +514,14 @@ namespace mineutils
             errno_t err = gmtime_s(&buf, &time_t_now);
             if (err != 0)
             {
-                mprintfW("Got Invalid DateTime!\n");
+                mprintfWLimited("Got Invalid DateTime!\n");
                 return date_time;
             }
 #else
             // POSIX 特定实现
             if (gmtime_r(&time_t_now, &buf) == nullptr)
             {
-                mprintfW("Got Invalid DateTime!\n");
+                mprintfWLimited("Got Invalid DateTime!\n");
                 return date_time;
             }
 #endif
@@ -327,6 +540,16 @@ namespace mineutils
             return date_time;
         }
 
+        _MINE_INLINE std::string TimePoint::formatLocalTime(bool with_ms) const
+        {
+            char time_str[32];
+            size_t len = mbase::_formatLocalTime(this->system_tp_, true, with_ms, time_str);
+            return std::string(time_str, len);
+        }
+#else
+        bool _isSameDateTime(const DateTime& a, const DateTime& b);
+#endif
+
         template<Unit unit>
         inline long long TimePoint::since(const TimePoint& tp) const
         {
@@ -411,52 +634,186 @@ namespace mineutils
         //    return *this;
         //}
 
-        inline TimePoint now()
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE TimePoint now()
         {
             return TimePoint(std::chrono::steady_clock::now(), std::chrono::system_clock::now());
         }
 
 
         //线程休眠(秒)
-        inline void sleep(long long t)
+        _MINE_INLINE void sleep(long long t)
         {
             if (t > 0)
                 std::this_thread::sleep_for(std::chrono::seconds(t));
         }
 
         //线程休眠(毫秒)
-        inline void msleep(long long t)
+        _MINE_INLINE void msleep(long long t)
         {
             if (t > 0)
                 std::this_thread::sleep_for(std::chrono::milliseconds(t));
         }
 
         //线程休眠(微秒)
-        inline void usleep(long long t)
+        _MINE_INLINE void usleep(long long t)
         {
             if (t > 0)
                 std::this_thread::sleep_for(std::chrono::microseconds(t));
         }
 
         //线程休眠(纳秒)
-        inline void nsleep(long long t)
+        _MINE_INLINE void nsleep(long long t)
         {
             if (t > 0)
                 std::this_thread::sleep_for(std::chrono::nanoseconds(t));
         }
 
 
-        inline std::atomic<bool>& _getGlobalTimeCounterEnabled()
+        _MINE_INLINE std::atomic<bool>& _getGlobalTimeCounterEnabled()
         {
             static std::atomic<bool> g_timecounter_on(true);
             return g_timecounter_on;
         }
 
-        inline void enableGlobalTimeCounter(bool enabled)
+        _MINE_INLINE void enableGlobalTimeCounter(bool enabled)
         {
             mtime::_getGlobalTimeCounterEnabled().store(enabled, std::memory_order_relaxed);
         }
+#else
+        std::atomic<bool>& _getGlobalTimeCounterEnabled();
+#endif
+
+
+        //硬件性能计数器组，以cycles为组长，组内事件同时启停
+        class _PerfEventGroup
+        {
+        public:
+            enum Event
+            {
+                cycles = 0,
+                instructions,
+                l1d_misses,
+                llc_misses,
+                branches,
+                branch_misses,
+                event_num
+            };
+
+            _PerfEventGroup() = default;
+
+            ~_PerfEventGroup()
+            {
+#if defined(__linux__)
+                for (int i = event_num - 1; i >= 0; i--)
+                {
+                    if (this->fds_[i] >= 0)
+                        ::close(this->fds_[i]);
+                }
+#endif
+            }
+
+            //打开计数器组，组长打开失败时返回-1；组员打开失败时仅该事件不可用
+            int open()
+            {
+#if defined(__linux__)
+                const uint32_t types[event_num] = { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE };
+                const uint64_t configs[event_num] = {
+                    PERF_COUNT_HW_CPU_CYCLES,
+                    PERF_COUNT_HW_INSTRUCTIONS,
+                    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                    PERF_COUNT_HW_CACHE_MISSES,
+                    PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+                    PERF_COUNT_HW_BRANCH_MISSES };
+                for (int i = 0; i < event_num; i++)
+                {
+                    perf_event_attr attr;
+                    memset(&attr, 0, sizeof(attr));
+                    attr.size = sizeof(attr);
+                    attr.type = types[i];
+                    attr.config = configs[i];
+                    attr.disabled = (i == 0);
+                    attr.exclude_kernel = 1;
+                    attr.exclude_hv = 1;
+                    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+                    int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, i == 0 ? -1 : this->fds_[0], 0);
+                    if (fd < 0)
+                    {
+                        if (i == 0)
+                            return -1;
+                        continue;
+                    }
+                    this->fds_[i] = fd;
+                    ioctl(fd, PERF_EVENT_IOC_ID, &this->ids_[i]);
+                }
+                ioctl(this->fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(this->fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                return 0;
+#else
+                return -1;
+#endif
+            }
 
+            bool available(Event event) const
+            {
+                return this->fds_[event] >= 0;
+            }
+
+            void markStart()
+            {
+                this->readGroup(this->start_values_);
+            }
+
+            void markEnd()
+            {
+                uint64_t end_values[event_num] = { 0 };
+                this->readGroup(end_values);
+                for (int i = 0; i < event_num; i++)
+                    this->sums_[i] += end_values[i] - this->start_values_[i];
+            }
+
+            uint64_t sum(Event event) const
+            {
+                return this->sums_[event];
+            }
+
+            void restart()
+            {
+                for (int i = 0; i < event_num; i++)
+                    this->sums_[i] = 0;
+            }
+
+            _PerfEventGroup(const _PerfEventGroup& _temp) = delete;
+            _PerfEventGroup& operator=(const _PerfEventGroup& _temp) = delete;
+
+        private:
+            void readGroup(uint64_t* values)
+            {
+#if defined(__linux__)
+                //PERF_FORMAT_GROUP|PERF_FORMAT_ID的格式：nr, {value, id} * nr
+                uint64_t buf[1 + 2 * event_num];
+                ssize_t n = ::read(this->fds_[0], buf, sizeof(buf));
+                if (n < (ssize_t)sizeof(uint64_t))
+                    return;
+                for (uint64_t k = 0; k < buf[0] && k < (uint64_t)event_num; k++)
+                {
+                    for (int i = 0; i < event_num; i++)
+                    {
+                        if (this->fds_[i] >= 0 && this->ids_[i] == buf[2 + 2 * k])
+                        {
+                            values[i] = buf[1 + 2 * k];
+                            break;
+                        }
+                    }
+                }
+#endif
+            }
+
+            int fds_[event_num] = { -1, -1, -1, -1, -1, -1 };
+            uint64_t ids_[event_num] = { 0 };
+            uint64_t start_values_[event_num] = { 0 };
+            uint64_t sums_[event_num] = { 0 };
+        };
 
         class MeanTimeCounter::SingleCounter
         {
@@ -472,8 +829,22 @@ namespace mineutils
                 this->codeblock_tag_ = codeblock_tag;
             }
 
+            int enableHardwareCounters()
+            {
+                if (this->hw_counters_)
+                    return 0;
+                std::unique_ptr<mtime::_PerfEventGroup> hw_counters(new mtime::_PerfEventGroup);
+                if (hw_counters->open() != 0)
+                    return -1;
+                this->hw_counters_ = std::move(hw_counters);
+                return 0;
+            }
+
             void markStart()
             {
+                //先读取硬件计数器再计时，使系统调用开销不计入耗时
+                if (this->hw_counters_)
+                    this->hw_counters_->markStart();
                 this->start_t_ = std::chrono::steady_clock::now();
                 this->addstart_times_ += 1;
             }
@@ -482,6 +853,8 @@ namespace mineutils
             {
                 this->time_cost_ += (std::chrono::steady_clock::now() - this->start_t_);
                 this->addend_times_ += 1;
+                if (this->hw_counters_)
+                    this->hw_counters_->markEnd();
             }
 
             template<Unit unit>
@@ -489,7 +862,7 @@ namespace mineutils
             {
                 if (!(this->addend_times_ == this->addstart_times_))
                 {
-                    mprintfW("Function \"'markStart(%s)\" and function \"markEnd(%s)\" should be called the same number of times!\n", this->codeblock_tag_, this->codeblock_tag_);
+                    mprintfWLimited("Function \"'markStart(%s)\" and function \"markEnd(%s)\" should be called the same number of times!\n", this->codeblock_tag_, this->codeblock_tag_);
                     return;
                 }
                 if (this->finish())
@@ -521,6 +894,8 @@ namespace mineutils
                         break;
                     }
                     printf(msg, this->final_tag_.c_str(), mean_time_cost, this->addend_times_);
+                    if (this->hw_counters_)
+                        this->printHardwareCounters();
                     this->restart();
                 }
             }
@@ -536,6 +911,27 @@ namespace mineutils
                 this->addstart_times_ = 0;
                 this->addend_times_ = 0;
                 this->time_cost_ = std::chrono::nanoseconds(0);
+                if (this->hw_counters_)
+                    this->hw_counters_->restart();
+            }
+
+            //格式：tag hardware counters: IPC 1.85, L1D miss 12.40/kinst, LLC miss 0.31/kinst, branch miss 1.20% in 10 counts.
+            void printHardwareCounters()
+            {
+                typedef mtime::_PerfEventGroup Group;
+                const Group& group = *this->hw_counters_;
+                double instructions = (double)group.sum(Group::instructions);
+                char ipc[16] = "n/a", l1d[24] = "n/a", llc[24] = "n/a", branch[16] = "n/a";
+                if (group.available(Group::instructions) && group.sum(Group::cycles) > 0)
+                    snprintf(ipc, sizeof(ipc), "%.2f", instructions / group.sum(Group::cycles));
+                if (group.available(Group::l1d_misses) && instructions > 0)
+                    snprintf(l1d, sizeof(l1d), "%.2f/kinst", group.sum(Group::l1d_misses) * 1000.0 / instructions);
+                if (group.available(Group::llc_misses) && instructions > 0)
+                    snprintf(llc, sizeof(llc), "%.2f/kinst", group.sum(Group::llc_misses) * 1000.0 / instructions);
+                if (group.available(Group::branch_misses) && group.available(Group::branches) && group.sum(Group::branches) > 0)
+                    snprintf(branch, sizeof(branch), "%.2f%%", group.sum(Group::branch_misses) * 100.0 / group.sum(Group::branches));
+                printf("%s hardware counters: IPC %s, L1D miss %s, LLC miss %s, branch miss %s in %d counts.\n",
+                    this->final_tag_.c_str(), ipc, l1d, llc, branch, this->addend_times_);
             }
 
             int addstart_times_ = 0;
@@ -546,6 +942,7 @@ namespace mineutils
             int target_count_ = 1;
             std::string final_tag_;
             const char* codeblock_tag_ = nullptr;
+            std::unique_ptr<mtime::_PerfEventGroup> hw_counters_;
         };
 
         class MeanTimeCounter::Guard
@@ -588,7 +985,8 @@ namespace mineutils
             friend MeanTimeCounter;
         };
 
-        inline MeanTimeCounter::MeanTimeCounter()
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE MeanTimeCounter::MeanTimeCounter()
         {
             this->target_count_ = 1;
             this->self_enabled_ = true;
@@ -596,7 +994,7 @@ namespace mineutils
             this->counter_map_.reset(new std::unordered_map<std::string, SingleCounter>);
         }
 
-        inline MeanTimeCounter::MeanTimeCounter(int target_count, std::string print_header, bool enabled)
+        _MINE_INLINE MeanTimeCounter::MeanTimeCounter(int target_count, std::string print_header, bool enabled)
         {
             this->target_count_ = target_count >= 1 ? target_count : 1;
             this->print_header_ = std::move(print_header);
@@ -605,7 +1003,7 @@ namespace mineutils
             this->counter_map_.reset(new std::unordered_map<std::string, SingleCounter>);
         }
 
-        inline void MeanTimeCounter::markStart(const std::string& codeblock_tag)
+        _MINE_INLINE void MeanTimeCounter::markStart(const std::string& codeblock_tag)
         {
             if (this->final_enabled_)
             {
@@ -618,23 +1016,49 @@ namespace mineutils
             }
         }
 
-        inline void MeanTimeCounter::markEnd(const std::string& codeblock_tag)
+        _MINE_INLINE int MeanTimeCounter::enableHardwareCounters(const std::string& codeblock_tag)
+        {
+            static std::atomic<bool> warned(false);
+            if (!this->final_enabled_)
+                return -1;
+            if (this->counter_map_->end() == this->counter_map_->find(codeblock_tag))
+            {
+                this->tags_.emplace_back(codeblock_tag);
+                (*this->counter_map_)[codeblock_tag] = MeanTimeCounter::SingleCounter(this->target_count_, this->print_header_.c_str(), this->tags_.back().c_str());
+            }
+            if ((*this->counter_map_)[codeblock_tag].enableHardwareCounters() != 0)
+            {
+                if (!warned.exchange(true))
+                {
+#if defined(__linux__)
+                    mprintfWLimited("Failed to open perf events, hardware counters are disabled! Please check /proc/sys/kernel/perf_event_paranoid.\n");
+#else
+                    mprintfWLimited("Hardware counters are only supported on Linux!\n");
+#endif
+                }
+                return -1;
+            }
+            return 0;
+        }
+
+        _MINE_INLINE void MeanTimeCounter::markEnd(const std::string& codeblock_tag)
         {
             if (this->final_enabled_)
             {
                 if (this->counter_map_->end() == this->counter_map_->find(codeblock_tag))
                 {
-                    mprintfW("Please call \"markStart(%s)\" before \"markEnd(%s)\"!\n", codeblock_tag.c_str(), codeblock_tag.c_str());
+                    mprintfWLimited("Please call \"markStart(%s)\" before \"markEnd(%s)\"!\n", codeblock_tag.c_str(), codeblock_tag.c_str());
                     return;
                 }
                 (*this->counter_map_)[codeblock_tag].markEnd();
             }
         }
 
-        inline MeanTimeCounter::Guard MeanTimeCounter::markGuard(std::string codeblock_tag)
+        _MINE_INLINE MeanTimeCounter::Guard MeanTimeCounter::markGuard(std::string codeblock_tag)
         {
             return MeanTimeCounter::Guard(this, codeblock_tag);
         }
+#endif
 
         template<Unit unit>
         inline void MeanTimeCounter::printOnTargetCount()
@@ -650,6 +1074,253 @@ namespace mineutils
         }
 
 
+        template<Unit unit>
+        inline long long _castDuration(std::chrono::nanoseconds duration)
+        {
+            switch (unit)
+            {
+            case Unit::s:
+                return std::chrono::duration_cast<std::chrono::seconds>(duration).count();
+            case Unit::ms:
+                return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+            case Unit::us:
+                return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+            case Unit::ns:
+                return duration.count();
+            default:
+                return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+            }
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE const char* _getUnitStr(Unit unit)
+        {
+            switch (unit)
+            {
+            case Unit::s:
+                return "s";
+            case Unit::ms:
+                return "ms";
+            case Unit::us:
+                return "us";
+            case Unit::ns:
+                return "ns";
+            default:
+                return "ms";
+            }
+        }
+#else
+        const char* _getUnitStr(Unit unit);
+#endif
+
+        //线程内正在统计的代码段
+        struct _ScopeFrame
+        {
+            unsigned long long owner_id;
+            int node_id;
+            std::chrono::steady_clock::time_point start_t;
+        };
+
+#ifndef _MINE_DECLARATION_ONLY
+        //不支持thread_local时(如QNX660)退化为全局栈
+        _MINE_INLINE std::vector<_ScopeFrame>& _getScopeStack()
+        {
+            static _MINE_THREAD_LOCAL_IF_HAVE std::vector<_ScopeFrame> scope_stack;
+            return scope_stack;
+        }
+
+        _MINE_INLINE unsigned long long _nextScopeProfilerId()
+        {
+            static std::atomic<unsigned long long> next_id(1);
+            return next_id.fetch_add(1, std::memory_order_relaxed);
+        }
+#else
+        std::vector<_ScopeFrame>& _getScopeStack();
+        unsigned long long _nextScopeProfilerId();
+#endif
+
+        class ScopeProfiler::Guard
+        {
+        public:
+            Guard(Guard&& tmp) noexcept
+            {
+                this->scope_tag_ = std::move(tmp.scope_tag_);
+                this->resource_ = tmp.resource_;
+                tmp.resource_ = nullptr;
+            }
+
+            ~Guard()
+            {
+                if (this->resource_)
+                    this->resource_->markEnd(this->scope_tag_);
+            }
+
+            void release()
+            {
+                if (this->resource_)
+                    this->resource_->markEnd(this->scope_tag_);
+                this->resource_ = nullptr;
+            }
+
+            Guard(const Guard& tmp) = delete;
+            Guard& operator=(const Guard& tmp) = delete;
+            Guard& operator=(Guard&& tmp) = delete;
+
+        private:
+            Guard(ScopeProfiler* resource, std::string& scope_tag)
+            {
+                resource->markStart(scope_tag);
+                this->resource_ = resource;
+                this->scope_tag_ = std::move(scope_tag);
+            }
+
+            ScopeProfiler* resource_ = nullptr;
+            std::string scope_tag_;
+            friend ScopeProfiler;
+        };
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE ScopeProfiler::ScopeProfiler(std::string print_header, bool enabled)
+        {
+            this->print_header_ = std::move(print_header);
+            this->self_enabled_ = enabled;
+            this->id_ = mtime::_nextScopeProfilerId();
+            this->nodes_.resize(1);
+        }
+
+        _MINE_INLINE ScopeProfiler::~ScopeProfiler()
+        {
+            //其他线程中残留的帧无法在此清除，它们的id不会再被匹配
+            std::vector<_ScopeFrame>& scope_stack = mtime::_getScopeStack();
+            const unsigned long long id = this->id_;
+            scope_stack.erase(std::remove_if(scope_stack.begin(), scope_stack.end(), [id](const _ScopeFrame& frame) { return frame.owner_id == id; }), scope_stack.end());
+        }
+
+        _MINE_INLINE void ScopeProfiler::markStart(const std::string& scope_tag)
+        {
+            if (!(this->self_enabled_ && mtime::_getGlobalTimeCounterEnabled().load(std::memory_order_relaxed)))
+                return;
+
+            std::vector<_ScopeFrame>& scope_stack = mtime::_getScopeStack();
+            int parent_id = 0;
+            for (auto it = scope_stack.rbegin(); it != scope_stack.rend(); ++it)
+            {
+                if (it->owner_id == this->id_)
+                {
+                    parent_id = it->node_id;
+                    break;
+                }
+            }
+            int node_id;
+            {
+                std::lock_guard<std::mutex> lk(this->mtx_);
+                node_id = this->findOrCreateChild(parent_id, scope_tag);
+            }
+            scope_stack.push_back({ this->id_, node_id, std::chrono::steady_clock::now() });
+        }
+
+        _MINE_INLINE void ScopeProfiler::markEnd(const std::string& scope_tag)
+        {
+            auto end_t = std::chrono::steady_clock::now();
+            std::vector<_ScopeFrame>& scope_stack = mtime::_getScopeStack();
+            const unsigned long long id = this->id_;
+            std::lock_guard<std::mutex> lk(this->mtx_);
+            //从内向外寻找本对象中tag匹配的帧
+            size_t frame_idx = scope_stack.size();
+            while (frame_idx > 0)
+            {
+                const _ScopeFrame& frame = scope_stack[frame_idx - 1];
+                if (frame.owner_id == id && this->nodes_[frame.node_id].tag == scope_tag)
+                    break;
+                frame_idx--;
+            }
+            if (frame_idx == 0)
+            {
+                if (this->self_enabled_ && mtime::_getGlobalTimeCounterEnabled().load(std::memory_order_relaxed))
+                    mprintfWLimited("Please call \"markStart(%s)\" before \"markEnd(%s)\"!\n", scope_tag.c_str(), scope_tag.c_str());
+                return;
+            }
+
+            //内层未结束的代码段不计入统计，直接丢弃，避免之后的代码段被挂到它们下面
+            for (size_t i = frame_idx; i < scope_stack.size(); i++)
+            {
+                if (scope_stack[i].owner_id == id)
+                    mprintfWLimited("Function \"markEnd(%s)\" was called before \"markEnd(%s)\"! Nested scopes should end in reverse order, the unfinished scope is discarded.\n",
+                        scope_tag.c_str(), this->nodes_[scope_stack[i].node_id].tag.c_str());
+            }
+            const _ScopeFrame& frame = scope_stack[frame_idx - 1];
+            Node& node = this->nodes_[frame.node_id];
+            auto time_cost = std::chrono::duration_cast<std::chrono::nanoseconds>(end_t - frame.start_t);
+            node.total_cost += time_cost;
+            node.count += 1;
+            this->nodes_[node.parent_id].children_cost += time_cost;
+            scope_stack.erase(std::remove_if(scope_stack.begin() + (frame_idx - 1), scope_stack.end(), [id](const _ScopeFrame& f) { return f.owner_id == id; }), scope_stack.end());
+        }
+
+        _MINE_INLINE ScopeProfiler::Guard ScopeProfiler::markGuard(std::string scope_tag)
+        {
+            return ScopeProfiler::Guard(this, scope_tag);
+        }
+#endif
+
+        template<Unit unit>
+        inline void ScopeProfiler::printReport()
+        {
+            std::lock_guard<std::mutex> lk(this->mtx_);
+            if (this->print_header_.empty())
+                printf("Scope profiler report(%s):\n", mtime::_getUnitStr(unit));
+            else printf("%s scope profiler report(%s):\n", this->print_header_.c_str(), mtime::_getUnitStr(unit));
+            for (int child_id : this->nodes_[0].children_ids)
+                this->printNode<unit>(child_id, 1);
+        }
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE void ScopeProfiler::reset()
+        {
+            std::lock_guard<std::mutex> lk(this->mtx_);
+            for (Node& node : this->nodes_)
+            {
+                node.count = 0;
+                node.total_cost = std::chrono::nanoseconds(0);
+                node.children_cost = std::chrono::nanoseconds(0);
+            }
+        }
+
+        _MINE_INLINE int ScopeProfiler::findOrCreateChild(int parent_id, const std::string& scope_tag)
+        {
+            for (int child_id : this->nodes_[parent_id].children_ids)
+            {
+                if (this->nodes_[child_id].tag == scope_tag)
+                    return child_id;
+            }
+            int node_id = static_cast<int>(this->nodes_.size());
+            this->nodes_.emplace_back();
+            this->nodes_.back().tag = scope_tag;
+            this->nodes_.back().parent_id = parent_id;
+            this->nodes_[parent_id].children_ids.push_back(node_id);
+            return node_id;
+        }
+#endif
+
+        template<Unit unit>
+        inline void ScopeProfiler::printNode(int node_id, int depth)
+        {
+            const Node& node = this->nodes_[node_id];
+            const Node& parent = this->nodes_[node.parent_id];
+            //根节点不计时，顶层节点的占比相对于所有顶层节点的总耗时
+            std::chrono::nanoseconds parent_cost = node.parent_id == 0 ? parent.children_cost : parent.total_cost;
+            double percent = parent_cost.count() > 0 ? 100.0 * node.total_cost.count() / parent_cost.count() : 0.0;
+            long long mean_cost = node.count > 0 ? mtime::_castDuration<unit>(node.total_cost) / node.count : 0;
+            const char* unit_str = mtime::_getUnitStr(unit);
+
+            printf("%*s%s: total %lld%s, self %lld%s, mean %lld%s in %lld counts (%.1f%%)\n", depth * 4, "", node.tag.c_str(),
+                mtime::_castDuration<unit>(node.total_cost), unit_str, mtime::_castDuration<unit>(node.total_cost - node.children_cost), unit_str,
+                mean_cost, unit_str, node.count, percent);
+            for (int child_id : node.children_ids)
+                this->printNode<unit>(child_id, depth + 1);
+        }
+
+
         template<Unit unit>
         inline TimeCounterGuard<unit>::TimeCounterGuard(std::string codeblock_tag)
         {
@@ -718,10 +1389,56 @@ namespace mineutils
         }
 
 
+#ifndef _MINE_DECLARATION_ONLY
+        //高精度休眠时预留的自旋余量，根据实际的休眠超时情况动态校准，单位ns
+        _MINE_INLINE std::atomic<long long>& _getSpinMarginNs()
+        {
+#if defined(__GNUC__) && !_mgccMinVersion(4, 8, 1)  //for qnx660，休眠精度约为1ms
+            static std::atomic<long long> spin_margin_ns(2000000);
+#else
+            static std::atomic<long long> spin_margin_ns(200000);
+#endif
+            return spin_margin_ns;
+        }
+
+        //先休眠至目标时间点前的余量处，再自旋等待至目标时间点
+        _MINE_INLINE void _preciseSleepUntil(std::chrono::steady_clock::time_point target_tp)
+        {
+            const long long min_margin_ns = 20000;
+            const long long max_margin_ns = 5000000;
+            std::atomic<long long>& spin_margin_ns = mtime::_getSpinMarginNs();
+
+            long long margin_ns = spin_margin_ns.load(std::memory_order_relaxed);
+            auto margin = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(margin_ns));
+            auto wakeup_tp = target_tp - margin;
+            if (std::chrono::steady_clock::now() < wakeup_tp)
+            {
+                std::this_thread::sleep_until(wakeup_tp);
+                long long overshoot_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wakeup_tp).count();
+                //超时大于余量时快速增大余量，否则缓慢回落，使余量贴近近期的最大休眠超时
+                long long new_margin_ns;
+                if (overshoot_ns >= margin_ns)
+                    new_margin_ns = overshoot_ns + overshoot_ns / 4;
+                else new_margin_ns = margin_ns - (margin_ns - overshoot_ns) / 16;
+                if (new_margin_ns < min_margin_ns)
+                    new_margin_ns = min_margin_ns;
+                else if (new_margin_ns > max_margin_ns)
+                    new_margin_ns = max_margin_ns;
+                spin_margin_ns.store(new_margin_ns, std::memory_order_relaxed);
+            }
+            while (std::chrono::steady_clock::now() < target_tp)
+                mbase::_cpuRelax();
+        }
+#else
+        std::atomic<long long>& _getSpinMarginNs();
+        void _preciseSleepUntil(std::chrono::steady_clock::time_point target_tp);
+#endif
+
+
         template<Unit unit>
-        inline MinTimeGuard<unit>::MinTimeGuard(long long target_time)
+        inline MinTimeGuard<unit>::MinTimeGuard(long long target_time, bool high_precision)
         {
-            this->create(target_time);
+            this->create(target_time, high_precision);
         }
 
         template<Unit unit>
@@ -738,14 +1455,14 @@ namespace mineutils
         }
 
         template<Unit unit>
-        inline void MinTimeGuard<unit>::reset(long long target_time)
+        inline void MinTimeGuard<unit>::reset(long long target_time, bool high_precision)
         {
             this->destroy();
-            this->create(target_time);
+            this->create(target_time, high_precision);
         }
 
         template<Unit unit>
-        inline void MinTimeGuard<unit>::create(long long target_time)
+        inline void MinTimeGuard<unit>::create(long long target_time, bool high_precision)
         {
             auto now_tp = std::chrono::steady_clock::now();
             switch (unit)
@@ -770,6 +1487,7 @@ namespace mineutils
                 this->target_tp_ = now_tp + std::chrono::milliseconds(target_time);
                 break;
             }
+            this->high_precision_ = high_precision;
             this->valid_ = true;
         }
 
@@ -777,9 +1495,212 @@ namespace mineutils
         inline void MinTimeGuard<unit>::destroy()
         {
             if (this->valid_)
-                std::this_thread::sleep_until(this->target_tp_);
+            {
+                if (this->high_precision_)
+                    mtime::_preciseSleepUntil(this->target_tp_);
+                else std::this_thread::sleep_until(this->target_tp_);
+            }
+        }
+
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE FrameRateLimiter::FrameRateLimiter(double fps, bool high_precision)
+        {
+            if (!(fps > 0))
+            {
+                mprintfWLimited("Invalid param value fps:%f, which will be set to 1.\n", fps);
+                fps = 1;
+            }
+            this->period_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / fps));
+            this->high_precision_ = high_precision;
+            this->reset();
+        }
+
+        _MINE_INLINE void FrameRateLimiter::wait()
+        {
+            auto now_tp = std::chrono::steady_clock::now();
+            if (now_tp > this->target_tp_)
+            {
+                this->overrun_count_++;
+                if (now_tp - this->target_tp_ >= this->period_)
+                    this->target_tp_ = now_tp + this->period_;
+                else this->target_tp_ += this->period_;
+                return;
+            }
+
+            if (this->high_precision_)
+                mtime::_preciseSleepUntil(this->target_tp_);
+            else std::this_thread::sleep_until(this->target_tp_);
+
+            long long lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->target_tp_).count();
+            this->frame_count_++;
+            this->lateness_sum_ += lateness;
+            this->lateness_square_sum_ += double(lateness) * lateness;
+            if (lateness > this->lateness_max_)
+                this->lateness_max_ = lateness;
+            this->target_tp_ += this->period_;
+        }
+
+        _MINE_INLINE void FrameRateLimiter::reset()
+        {
+            this->target_tp_ = std::chrono::steady_clock::now() + this->period_;
+            this->frame_count_ = 0;
+            this->overrun_count_ = 0;
+            this->lateness_sum_ = 0;
+            this->lateness_square_sum_ = 0;
+            this->lateness_max_ = 0;
+        }
+#endif
+
+        template<Unit unit>
+        inline void FrameRateLimiter::printJitterReport()
+        {
+            double mean_ns = 0, stddev_ns = 0;
+            if (this->frame_count_ > 0)
+            {
+                mean_ns = this->lateness_sum_ / this->frame_count_;
+                double variance = this->lateness_square_sum_ / this->frame_count_ - mean_ns * mean_ns;
+                stddev_ns = variance > 0 ? sqrt(variance) : 0;
+            }
+            const char* unit_str = mtime::_getUnitStr(unit);
+            printf("Frame period %lld%s, %lld frames, lateness mean %lld%s, max %lld%s, stddev %lld%s, %lld overruns\n",
+                mtime::_castDuration<unit>(std::chrono::duration_cast<std::chrono::nanoseconds>(this->period_)), unit_str, this->frame_count_,
+                mtime::_castDuration<unit>(std::chrono::nanoseconds((long long)mean_ns)), unit_str,
+                mtime::_castDuration<unit>(std::chrono::nanoseconds(this->lateness_max_)), unit_str,
+                mtime::_castDuration<unit>(std::chrono::nanoseconds((long long)stddev_ns)), unit_str, this->overrun_count_);
+        }
+
+
+#ifndef _MINE_DECLARATION_ONLY
+        _MINE_INLINE RateMeter::RateMeter(std::string print_header, double window_seconds, int sample_count)
+            :count_(0)
+        {
+            if (!(window_seconds > 0))
+            {
+                mprintfWLimited("Invalid param value window_seconds:%f, which will be set to 1.\n", window_seconds);
+                window_seconds = 1;
+            }
+            if (sample_count < 1)
+            {
+                mprintfWLimited("Invalid param value sample_count:%d, which will be set to 1.\n", sample_count);
+                sample_count = 1;
+            }
+            this->print_header_ = std::move(print_header);
+            this->window_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(window_seconds));
+            this->sample_interval_ = this->window_ / sample_count;
+            this->samples_.resize(sample_count + 1);
+            this->reset();
+        }
+
+        _MINE_INLINE void RateMeter::tick(long long n)
+        {
+            this->count_.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        _MINE_INLINE void RateMeter::poll()
+        {
+            std::string print_header;
+            double window_rate, ewma_rate;
+            long long count;
+            decltype(this->reporter_) reporter;
+            {
+                std::lock_guard<std::mutex> lk(this->mtx_);
+                auto now_tp = std::chrono::steady_clock::now();
+                count = this->count_.load(std::memory_order_relaxed);
+
+                //指数加权速率，按两次poll之间的实际时长计算衰减系数，因此不要求poll的周期固定
+                double dt = std::chrono::duration<double>(now_tp - this->last_poll_.tp).count();
+                if (dt > 0)
+                {
+                    double instant_rate = (count - this->last_poll_.count) / dt;
+                    double alpha = 1 - exp(-dt / std::chrono::duration<double>(this->window_).count());
+                    this->ewma_rate_ += alpha * (instant_rate - this->ewma_rate_);
+                    this->last_poll_.tp = now_tp;
+                    this->last_poll_.count = count;
+                }
+
+                //每隔sample_interval_记录一个采样点，环形缓冲区中最旧的采样点即为窗口起点
+                if (now_tp - this->samples_[this->newest_pos_].tp >= this->sample_interval_)
+                {
+                    this->newest_pos_ = (this->newest_pos_ + 1) % this->samples_.size();
+                    this->samples_[this->newest_pos_].tp = now_tp;
+                    this->samples_[this->newest_pos_].count = count;
+                    if (this->sample_num_ < this->samples_.size())
+                        this->sample_num_++;
+                }
+                const Sample& oldest = this->samples_[(this->newest_pos_ + this->samples_.size() + 1 - this->sample_num_) % this->samples_.size()];
+                double window_dt = std::chrono::duration<double>(now_tp - oldest.tp).count();
+                if (window_dt > 0)
+                    this->window_rate_ = (count - oldest.count) / window_dt;
+
+                if (this->report_interval_ms_ <= 0 || now_tp - this->last_report_tp_ < std::chrono::milliseconds(this->report_interval_ms_))
+                    return;
+                this->last_report_tp_ = now_tp;
+                print_header = this->print_header_;
+                window_rate = this->window_rate_;
+                ewma_rate = this->ewma_rate_;
+                reporter = this->reporter_;
+            }
+            //在锁外汇报，允许汇报函数中调用本对象的接口
+            if (reporter)
+                reporter(print_header, window_rate, ewma_rate, count);
+            else this->printRate();
+        }
+
+        _MINE_INLINE double RateMeter::windowRate()
+        {
+            std::lock_guard<std::mutex> lk(this->mtx_);
+            return this->window_rate_;
+        }
+
+        _MINE_INLINE double RateMeter::ewmaRate()
+        {
+            std::lock_guard<std::mutex> lk(this->mtx_);
+            return this->ewma_rate_;
         }
 
+        _MINE_INLINE long long RateMeter::total() const
+        {
+            return this->count_.load(std::memory_order_relaxed);
+        }
+
+        _MINE_INLINE void RateMeter::setReporter(long long interval_ms, std::function<void(const std::string&, double, double, long long)> reporter)
+        {
+            std::lock_guard<std::mutex> lk(this->mtx_);
+            this->report_interval_ms_ = interval_ms;
+            this->reporter_ = std::move(reporter);
+            this->last_report_tp_ = std::chrono::steady_clock::now();
+        }
+
+        _MINE_INLINE void RateMeter::printRate()
+        {
+            double window_rate, ewma_rate;
+            {
+                std::lock_guard<std::mutex> lk(this->mtx_);
+                window_rate = this->window_rate_;
+                ewma_rate = this->ewma_rate_;
+            }
+            if (this->print_header_.empty())
+                printf("Window rate %.2f/s, ewma rate %.2f/s, total %lld\n", window_rate, ewma_rate, this->total());
+            else printf("%s: window rate %.2f/s, ewma rate %.2f/s, total %lld\n", this->print_header_.c_str(), window_rate, ewma_rate, this->total());
+        }
+
+        _MINE_INLINE void RateMeter::reset()
+        {
+            std::lock_guard<std::mutex> lk(this->mtx_);
+            auto now_tp = std::chrono::steady_clock::now();
+            this->count_.store(0, std::memory_order_relaxed);
+            this->newest_pos_ = 0;
+            this->sample_num_ = 1;
+            this->samples_[0].tp = now_tp;
+            this->samples_[0].count = 0;
+            this->last_poll_ = this->samples_[0];
+            this->window_rate_ = 0;
+            this->ewma_rate_ = 0;
+            this->last_report_tp_ = now_tp;
+        }
+#endif
+
     }
 
 
@@ -807,6 +1728,39 @@ namespace mineutils
             }
         }
 
+        inline void ScopeProfilerTest()
+        {
+            mtime::ScopeProfiler profiler(__func__);
+            for (int i = 0; i < 5; i++)
+            {
+                auto guard = profiler.markGuard("postprocess");
+                mtime::msleep(10);
+                {
+                    auto guard1 = profiler.markGuard("nms");
+                    mtime::msleep(20);
+                }
+            }
+            printf("User check! Expected output: \nScopeProfilerTest scope profiler report(ms):\n    postprocess: total 150ms, self 50ms, mean 30ms in 5 counts (100.0%%)\n        nms: total 100ms, self 100ms, mean 20ms in 5 counts (66.7%%)\n");
+            printf("Actual output:\n");
+            profiler.printReport<mtime::ms>();
+
+            //结束外层代码段时丢弃内层未结束的代码段，销毁的对象不在线程栈中留下帧
+            const size_t stack_size = mtime::_getScopeStack().size();
+            mtime::ScopeProfiler mismatch_profiler("Mismatch");
+            printf("User check! Expect a warning about markEnd(outer) before markEnd(leaked), and one about markStart(missing):\n");
+            mismatch_profiler.markStart("outer");
+            mismatch_profiler.markStart("leaked");
+            mismatch_profiler.markEnd("outer");
+            mismatch_profiler.markEnd("missing");
+            bool ret0 = mtime::_getScopeStack().size() == stack_size;
+            {
+                mtime::ScopeProfiler dropped_profiler;
+                dropped_profiler.markStart("unfinished");
+            }
+            ret0 = ret0 && mtime::_getScopeStack().size() == stack_size;
+            if (!ret0) mprintfE(R"(Failed when check: ScopeProfiler drops unfinished scopes)""\n");
+        }
+
         inline void nowTest()
         {
             auto start_t = mtime::now();
@@ -836,15 +1790,107 @@ namespace mineutils
             std::cout << now_utc_time << std::endl;
             std::cout << now_time_add_60s << std::endl;
             std::cout << mtime::DateTime() << std::endl;
+
+            auto now_tp1 = mtime::now();
+            std::string time_str = now_tp1.formatLocalTime();
+            std::string time_str_ms = now_tp1.formatLocalTime(true);
+            std::ostringstream oss;
+            oss << now_tp1.localTime();
+            bool ret0 = time_str == oss.str() && time_str_ms.size() == time_str.size() + 4
+                && time_str_ms.compare(0, 19, time_str, 0, 19) == 0 && time_str_ms[19] == '.';
+            if (!ret0) mprintfE(R"(Failed when check: now_tp.formatLocalTime())""\n");
+            printf("User check! Got result(%s):%s\n", time_str.c_str(), time_str_ms.c_str());
+        }
+
+        inline void FrameRateLimiterTest()
+        {
+            auto start_t = mtime::now();
+            {
+                mtime::MinTimeGuard<mtime::us> guard(5000, true);
+            }
+            auto end_t = mtime::now();
+            long long cost_us = end_t.since<mtime::us>(start_t);
+            bool ret0 = cost_us >= 5000 && cost_us < 5000 + 2000;
+
+            mtime::FrameRateLimiter limiter(100);
+            start_t = mtime::now();
+            for (int i = 0; i < 20; i++)
+                limiter.wait();
+            end_t = mtime::now();
+            long long cost_ms = end_t.since<mtime::ms>(start_t);
+            ret0 = ret0 && cost_ms >= 199 && cost_ms < 200 + 10;
+
+            if (!ret0) mprintfE(R"(Failed when check: MinTimeGuard<mtime::us> guard(5000, true) or FrameRateLimiter(100).wait())""\n");
+            printf("User check! Got result(200ms):%lldms\n", cost_ms);
+            limiter.printJitterReport<mtime::us>();
+        }
+
+        inline void RateMeterTest()
+        {
+            mtime::RateMeter meter(__func__, 0.2, 4);
+            int report_count = 0;
+            meter.setReporter(100, [&report_count](const std::string&, double, double, long long) { report_count++; });
+            std::thread producer([&meter]()
+                {
+                    for (int i = 0; i < 50; i++)
+                    {
+                        meter.tick(2);
+                        mtime::msleep(10);
+                    }
+                });
+            for (int i = 0; i < 50; i++)
+            {
+                meter.tick();
+                mtime::msleep(10);
+                meter.poll();
+            }
+            producer.join();
+            meter.poll();
+            bool ret0 = meter.total() == 150;
+            bool ret1 = meter.windowRate() > 240 && meter.windowRate() < 330 && meter.ewmaRate() > 200 && meter.ewmaRate() < 330;
+            bool ret2 = report_count >= 3 && report_count <= 5;
+            if (!ret0) mprintfE(R"(Failed when check: meter.total())""\n");
+            if (!ret1) mprintfE(R"(Failed when check: meter.windowRate() or meter.ewmaRate())""\n");
+            if (!ret2) mprintfE(R"(Failed when check: meter.setReporter(100, reporter))""\n");
+            printf("User check! Expected output: \nRateMeterTest: window rate 300.00/s, ewma rate 300.00/s, total 150(approximately)\n");
+            printf("Actual output:\n");
+            meter.printRate();
         }
 
 
 
+        inline void HardwareCountersTest()
+        {
+            mtime::MeanTimeCounter time_counter{ 5, __func__ };
+            if (time_counter.enableHardwareCounters("loop") != 0)
+            {
+                printf("User check! Hardware counters are unavailable, expected a warning above.\n");
+                return;
+            }
+            printf("User check! Expected output: \nHardwareCountersTest: loop mean cost time xxxus in 5 counts.\nHardwareCountersTest: loop hardware counters: IPC x.xx, L1D miss x.xx/kinst, LLC miss x.xx/kinst, branch miss x.xx%% in 5 counts.\n");
+            printf("Actual output:\n");
+            std::vector<int> data(1 << 16, 1);
+            for (int i = 0; i < 5; i++)
+            {
+                time_counter.markStart("loop");
+                long long sum = 0;
+                for (size_t j = 0; j < data.size(); j++)
+                    sum += data[(j * 4099) % data.size()];
+                time_counter.markEnd("loop");
+                if (sum != (long long)data.size()) mprintfE(R"(Failed when check: HardwareCountersTest)""\n");
+                time_counter.printOnTargetCount<mtime::us>();
+            }
+        }
+
         inline void check()
         {
             printf("\n--------------------check mtime start--------------------\n");
             MeanTimeCounterTest();
+            HardwareCountersTest();
+            ScopeProfilerTest();
             nowTest();
+            FrameRateLimiterTest();
+            RateMeterTest();
             printf("---------------------check mtime end---------------------\n\n");
         }
     }
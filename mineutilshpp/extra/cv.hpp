@@ -132,7 +132,7 @@ namespace mineutils
             auto cap = cv::VideoCapture(video_path);
             if (not cap.isOpened())
             {
-                mprintfW("Open video failed, skiped!\n");
+                mprintfWLimited("Open video failed, skiped!\n");
                 return;
             }
             mext::cvSetWindow(win_name, position, size, flag);
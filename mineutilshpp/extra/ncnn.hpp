@@ -55,12 +55,12 @@ namespace mineutils
             //ncnn::Net net;
             if (out_net.load_param(param_path.c_str()))
             {
-                mprintfW("Load param file %s failed!\n", param_path.c_str());
+                mprintfWLimited("Load param file %s failed!\n", param_path.c_str());
                 return -1;
             }
             if (out_net.load_model(bin_path.c_str()))
             {
-                mprintfW("Load bin file %s failed!\n", bin_path.c_str());
+                mprintfWLimited("Load bin file %s failed!\n", bin_path.c_str());
                 return -1;
             }
             return 0;
@@ -0,0 +1,19 @@
+/*  mineutils分离编译模式的实现单元
+    - 使用方法：所有编译单元定义宏MINEUTILS_SEPARATE_COMPILATION，并将本文件加入工程编译一次
+    - 未定义MINEUTILS_SEPARATE_COMPILATION时不需要编译本文件，头文件保持header-only方式使用  */
+#ifndef MINEUTILS_SEPARATE_COMPILATION
+#define MINEUTILS_SEPARATE_COMPILATION
+#endif
+#define _MINEUTILS_IMPLEMENTATION_UNIT
+
+#include"__stdutils__.h"
+
+namespace mineutils
+{
+    namespace mstr
+    {
+#define _minstantiateToStr(T) template std::string toStr<-1, T>(const T&);
+        _mforEachCommonToStrType(_minstantiateToStr)
+#undef _minstantiateToStr
+    }
+}